@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <stdexcept>
+#include "BatchEvaluator.h"
+#include "CalculatorManager.h"
+#include "CalculatorResource.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    // The inverse functions, which CalculatorManager::SendCommand sends to the engine as INV and then the function.
+    constexpr pair<Command, Command> c_inverseFunctions[] = {
+        { Command::CommandASIN, Command::CommandSIN },   { Command::CommandACOS, Command::CommandCOS },   { Command::CommandATAN, Command::CommandTAN },
+        { Command::CommandPOWE, Command::CommandLN },    { Command::CommandASINH, Command::CommandSINH }, { Command::CommandACOSH, Command::CommandCOSH },
+        { Command::CommandATANH, Command::CommandTANH }, { Command::CommandASEC, Command::CommandSEC },   { Command::CommandACSC, Command::CommandCSC },
+        { Command::CommandACOT, Command::CommandCOT },   { Command::CommandASECH, Command::CommandSECH }, { Command::CommandACSCH, Command::CommandCSCH },
+        { Command::CommandACOTH, Command::CommandCOTH }
+    };
+}
+
+BatchEvaluator::BatchEvaluator(_In_ IResourceProvider* resourceProvider)
+    : BatchEvaluator(resourceProvider, true)
+{
+}
+
+BatchEvaluator::BatchEvaluator(_In_ IResourceProvider* resourceProvider, bool loadEngineStrings)
+    : m_resourceProvider(resourceProvider)
+    , m_engines{}
+    , m_currentEngine(nullptr)
+{
+    if (loadEngineStrings)
+    {
+        CCalcEngine::InitialOneTimeOnlySetup(*m_resourceProvider);
+    }
+    else
+    {
+        CCalcEngine::InitialThreadSetup();
+    }
+}
+
+/// <summary>
+/// Run one command sequence, starting from a Standard mode calculator as CalculatorManager::Reset leaves it.
+/// </summary>
+/// <param name="commands">the commands as they would be given to CalculatorManager::SendCommand</param>
+/// <remarks>Throws invalid_argument if the sequence has a CommandNULL in it.</remarks>
+BatchResult BatchEvaluator::Evaluate(_In_ vector<Command> const& commands)
+{
+    ResetEngines();
+
+    for (Command command : commands)
+    {
+        SendCommand(command);
+    }
+
+    CCalcEngine* engine = m_currentEngine->engine.get();
+    return { engine->GetPrimaryDisplayString(), engine->FInErrorState() };
+}
+
+vector<BatchResult> BatchEvaluator::Evaluate(_In_ vector<vector<Command>> const& sequences)
+{
+    vector<BatchResult> results;
+    results.reserve(sequences.size());
+    for (auto const& commands : sequences)
+    {
+        results.push_back(Evaluate(commands));
+    }
+
+    return results;
+}
+
+/// <summary>
+/// Switch to the engine for a mode and set it up the way CalculatorManager does.
+/// </summary>
+void BatchEvaluator::SetMode(Command mode)
+{
+    size_t index = 0;
+    CalculatorPrecision precision = CalculatorPrecision::StandardModePrecision;
+    if (mode == Command::ModeScientific)
+    {
+        index = 1;
+        precision = CalculatorPrecision::ScientificModePrecision;
+    }
+    else if (mode == Command::ModeProgrammer)
+    {
+        index = 2;
+        precision = CalculatorPrecision::ProgrammerModePrecision;
+    }
+
+    ModeEngine& modeEngine = m_engines[index];
+    if (!modeEngine.engine)
+    {
+        modeEngine.engine = make_unique<CCalcEngine>(
+            mode != Command::ModeBasic /* Respect Order of Operations */, mode == Command::ModeProgrammer /* Set to Integer Mode */, m_resourceProvider, nullptr, nullptr);
+    }
+
+    CCalcEngine* engine = modeEngine.engine.get();
+    engine->ProcessCommand(IDC_DEC);
+    engine->ProcessCommand(IDC_CLEAR);
+    engine->ChangePrecision(static_cast<int>(precision));
+    if (mode == Command::ModeBasic)
+    {
+        engine->UpdateMaxIntDigits();
+    }
+
+    modeEngine.isUsed = true;
+    m_currentEngine = &modeEngine;
+}
+
+void BatchEvaluator::SendCommand(Command command)
+{
+    CCalcEngine* engine = m_currentEngine->engine.get();
+    switch (command)
+    {
+    case Command::ModeBasic:
+    case Command::ModeScientific:
+    case Command::ModeProgrammer:
+        SetMode(command);
+        return;
+    case Command::CommandNULL:
+        // Stands for no command at all, as at the end of the command arrays the tests build. The engine would take it
+        // as the last command typed, so a sequence with one in would not give what the commands around it do.
+        throw invalid_argument("CommandNULL in a command sequence");
+    default:
+        for (auto const& [inverse, function] : c_inverseFunctions)
+        {
+            if (command == inverse)
+            {
+                engine->ProcessCommand(static_cast<OpCode>(Command::CommandINV));
+                engine->ProcessCommand(static_cast<OpCode>(function));
+                return;
+            }
+        }
+        break;
+    }
+
+    engine->ProcessCommand(static_cast<OpCode>(command));
+}
+
+/// <summary>
+/// Undo whatever the last sequence changed in the engines it used, memory, angle, number format and word size included,
+/// and start again from where CalculatorManager::Reset leaves the calculator.
+/// </summary>
+void BatchEvaluator::ResetEngines()
+{
+    for (ModeEngine& modeEngine : m_engines)
+    {
+        if (!modeEngine.isUsed)
+        {
+            continue;
+        }
+
+        CCalcEngine* engine = modeEngine.engine.get();
+        engine->ProcessCommand(IDC_CLEAR);
+        engine->ProcessCommand(IDC_MCLEAR);
+        engine->ProcessCommand(IDC_DEG);
+        engine->ProcessCommand(IDC_QWORD);
+        if (engine->FInExponentialFormat())
+        {
+            // IDC_FE toggles, and an engine in error ignores it, so only the engine knows whether it is on.
+            engine->ProcessCommand(IDC_FE);
+        }
+
+        modeEngine.isUsed = false;
+    }
+
+    // CalculatorManager::Reset clears the memory last, which leaves the engine out of recording mode.
+    SetMode(Command::ModeBasic);
+    m_currentEngine->engine->ProcessCommand(IDC_MCLEAR);
+}
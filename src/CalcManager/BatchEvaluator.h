@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include "Header Files/CalcEngine.h"
+
+namespace CalculationManager
+{
+    class IResourceProvider;
+
+    // What the primary display would show at the end of a command sequence.
+    struct BatchResult
+    {
+        std::wstring result;
+        bool isError;
+    };
+
+    // Replays whole command sequences the way CalculatorManager::SendCommand would, but with no ICalcDisplay and no
+    // history attached, so the engines only do the arithmetic. Every sequence starts from a Standard mode calculator
+    // as CalculatorManager::Reset leaves it, and sees nothing of the sequences before it.
+    class BatchEvaluator final
+    {
+    public:
+        BatchEvaluator(_In_ IResourceProvider* resourceProvider);
+
+        BatchResult Evaluate(_In_ std::vector<Command> const& commands);
+        std::vector<BatchResult> Evaluate(_In_ std::vector<std::vector<Command>> const& sequences);
+
+    private:
+        friend class ParallelBatchEvaluator;
+
+        // For ParallelBatchEvaluator's workers, which run on threads of their own once the engine strings are loaded.
+        BatchEvaluator(_In_ IResourceProvider* resourceProvider, bool loadEngineStrings);
+
+        struct ModeEngine
+        {
+            std::unique_ptr<CCalcEngine> engine;
+            bool isUsed; // has seen commands since it was last reset
+        };
+
+        IResourceProvider* const m_resourceProvider;
+        std::array<ModeEngine, 3> m_engines; // Standard, Scientific and Programmer
+        ModeEngine* m_currentEngine;
+
+        void SetMode(Command mode);
+        void SendCommand(Command command);
+        void ResetEngines();
+    };
+}
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+
+namespace
+{
+    atomic<uint64_t> s_newCount{ 0 };
+}
+
+// Every allocation the engine makes goes through here, the array forms and
+// the sized deletes of the standard library forward to these two.
+void* operator new(size_t size)
+{
+    s_newCount.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(size != 0 ? size : 1);
+    if (p == nullptr)
+    {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+
+namespace CalcManagerBenchmarks
+{
+    AllocationCounters::AllocationCounters() noexcept
+        : m_newCount(s_newCount.load(memory_order_relaxed))
+        , m_nodeCount(GetAllocatorStats().cnodealloc)
+    {
+    }
+
+    void AllocationCounters::Report(benchmark::State& state) const
+    {
+        uint64_t newCount = s_newCount.load(memory_order_relaxed) - m_newCount;
+        uint64_t nodeCount = GetAllocatorStats().cnodealloc - m_nodeCount;
+        state.counters["new/op"] = benchmark::Counter(static_cast<double>(newCount), benchmark::Counter::kAvgIterations);
+        state.counters["nodes/op"] = benchmark::Counter(static_cast<double>(nodeCount), benchmark::Counter::kAvgIterations);
+    }
+
+    RatpakThresholds::RatpakThresholds() noexcept
+    {
+        GetMulThresholds(&m_karatsuba, &m_toom3);
+        GetDivThresholds(&m_divBasex, &m_divRadix);
+        GetSeriesThreshold(&m_split);
+        GetConvThreshold(&m_conv);
+    }
+
+    RatpakThresholds::~RatpakThresholds()
+    {
+        SetMulThresholds(m_karatsuba, m_toom3);
+        SetDivThresholds(m_divBasex, m_divRadix);
+        SetSeriesThreshold(m_split);
+        SetConvThreshold(m_conv);
+    }
+
+    PNUMBER MakeNumber(int32_t cdigit, uint64_t radix, uint32_t seed)
+    {
+        PNUMBER pnum = nullptr;
+        createnum(pnum, cdigit);
+        pnum->sign = 1;
+        pnum->exp = 0;
+        pnum->cdigit = cdigit;
+
+        uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+        for (int32_t i = 0; i < cdigit; i++)
+        {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            uint32_t bits = static_cast<uint32_t>(state >> 32);
+            pnum->mant[i] = static_cast<MANTTYPE>(radix == BASEX ? bits : bits % radix);
+        }
+        if (pnum->mant[cdigit - 1] == 0)
+        {
+            pnum->mant[cdigit - 1] = 1;
+        }
+
+        return pnum;
+    }
+}
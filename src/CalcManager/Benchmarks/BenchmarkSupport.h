@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <benchmark/benchmark.h>
+#include "Ratpack/ratpak.h"
+
+namespace CalcManagerBenchmarks
+{
+    // Counts operator new calls and ratpak nodes handed out from construction
+    // on, Report adds both to the benchmark as averages per iteration.
+    class AllocationCounters
+    {
+    public:
+        AllocationCounters() noexcept;
+        void Report(benchmark::State& state) const;
+
+    private:
+        uint64_t m_newCount;
+        uint64_t m_nodeCount;
+    };
+
+    // Restores the ratpak multiply, divide and series thresholds on
+    // destruction, so a benchmark forcing one algorithm leaves the others alone.
+    class RatpakThresholds
+    {
+    public:
+        RatpakThresholds() noexcept;
+        ~RatpakThresholds();
+        RatpakThresholds(const RatpakThresholds&) = delete;
+        RatpakThresholds& operator=(const RatpakThresholds&) = delete;
+
+    private:
+        int32_t m_karatsuba;
+        int32_t m_toom3;
+        int32_t m_divBasex;
+        int32_t m_divRadix;
+        int32_t m_split;
+        int32_t m_conv;
+    };
+
+    // Returns a number of cdigit pseudo random digits in radix, the same ones
+    // for the same seed, with a non zero leading digit.
+    PNUMBER MakeNumber(int32_t cdigit, uint64_t radix, uint32_t seed);
+}
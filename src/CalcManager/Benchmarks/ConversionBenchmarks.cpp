@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    // Formats 1/7 to the full precision, the number is copied each iteration
+    // because NumberToString rounds it in place.
+    void BM_NumberToString(benchmark::State& state)
+    {
+        uint32_t radix = static_cast<uint32_t>(state.range(0));
+        int32_t precision = static_cast<int32_t>(state.range(1));
+        ChangeConstants(radix, precision);
+        PRAT seventh = i32torat(1);
+        PRAT seven = i32torat(7);
+        divrat(&seventh, seven, precision);
+        PNUMBER pnum = RatToNumber(seventh, radix, precision);
+
+        for (auto _ : state)
+        {
+            PNUMBER copy = nullptr;
+            DUPNUM(copy, pnum);
+            benchmark::DoNotOptimize(NumberToString(copy, NumberFormat::Float, radix, precision));
+            destroynum(copy);
+        }
+
+        destroynum(pnum);
+        destroyrat(seven);
+        destroyrat(seventh);
+    }
+
+    // The whole trip from the internal representation to text, as the
+    // display does it.
+    void BM_RatToString(benchmark::State& state)
+    {
+        uint32_t radix = static_cast<uint32_t>(state.range(0));
+        int32_t precision = static_cast<int32_t>(state.range(1));
+        ChangeConstants(radix, precision);
+        PRAT seventh = i32torat(1);
+        PRAT seven = i32torat(7);
+        divrat(&seventh, seven, precision);
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(RatToString(seventh, NumberFormat::Float, radix, precision));
+        }
+        counters.Report(state);
+
+        destroyrat(seven);
+        destroyrat(seventh);
+    }
+
+    // Parses a decimal with the given count of digits, half of them after
+    // the decimal point.
+    void BM_StringToRat(benchmark::State& state)
+    {
+        int32_t cdigits = static_cast<int32_t>(state.range(0));
+        ChangeConstants(10, cdigits + 4);
+        wstring mantissa;
+        for (int32_t i = 0; i < cdigits; i++)
+        {
+            if (i == cdigits / 2)
+            {
+                mantissa += L'.';
+            }
+            mantissa += static_cast<wchar_t>(L'1' + i % 9);
+        }
+
+        for (auto _ : state)
+        {
+            PRAT prat = StringToRat(false, mantissa, false, L"", 10, cdigits + 4);
+            destroyrat(prat);
+        }
+    }
+}
+
+BENCHMARK(BM_NumberToString)->Args({ 10, 32 })->Args({ 10, 128 })->Args({ 10, 512 })->Args({ 16, 64 })->Args({ 2, 64 });
+BENCHMARK(BM_RatToString)->Args({ 10, 32 })->Args({ 10, 128 })->Args({ 10, 512 })->Args({ 16, 64 })->Args({ 2, 64 });
+BENCHMARK(BM_StringToRat)->Arg(16)->Arg(32)->Arg(128)->Arg(512);
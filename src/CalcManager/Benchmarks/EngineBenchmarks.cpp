@@ -0,0 +1,392 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BatchEvaluator.h"
+#include "BenchmarkSupport.h"
+#include "CalculatorManager.h"
+#include "CalculatorResource.h"
+#include "HistorySerializer.h"
+#include "ParallelBatchEvaluator.h"
+
+using namespace std;
+using namespace CalculationManager;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    static constexpr size_t MAX_HISTORY_SIZE = 20;
+
+    // The engine falls back to its built in strings for anything left empty.
+    class EngineResources : public IResourceProvider
+    {
+    public:
+        wstring GetCEngineString(wstring_view) override
+        {
+            return {};
+        }
+    };
+
+    class NullDisplay : public ICalcDisplay
+    {
+    public:
+        void SetPrimaryDisplay(const wstring&, bool) override
+        {
+        }
+        void SetIsInError(bool) override
+        {
+        }
+        void SetExpressionDisplay(
+            shared_ptr<vector<pair<wstring, int>>> const&,
+            shared_ptr<vector<shared_ptr<IExpressionCommand>>> const&) override
+        {
+        }
+        void SetParenthesisNumber(unsigned int) override
+        {
+        }
+        void OnNoRightParenAdded() override
+        {
+        }
+        void MaxDigitsReached() override
+        {
+        }
+        void BinaryOperatorReceived() override
+        {
+        }
+        void OnHistoryItemAdded(unsigned int) override
+        {
+        }
+        void SetMemorizedNumbers(const vector<wstring>&) override
+        {
+        }
+        void MemoryItemChanged(unsigned int) override
+        {
+        }
+        void InputChanged() override
+        {
+        }
+    };
+
+    // Counts the tokens a display that redraws only what changed would draw.
+    class RedrawCountingDisplay : public NullDisplay
+    {
+    public:
+        void UpdateExpressionDisplay(
+            shared_ptr<vector<pair<wstring, int>>> const& tokens,
+            shared_ptr<vector<shared_ptr<IExpressionCommand>>> const&,
+            size_t firstChangedToken) override
+        {
+            redrawnTokenCount += tokens->size() - min(firstChangedToken, tokens->size());
+        }
+
+        size_t redrawnTokenCount = 0;
+    };
+
+    // 123.45 + 678.9 * 2 - 1 / 7 =
+    const vector<OpCode> s_standardCommands = { IDC_0 + 1, IDC_0 + 2, IDC_0 + 3, IDC_PNT, IDC_0 + 4, IDC_0 + 5, IDC_ADD, IDC_0 + 6,
+                                                IDC_0 + 7, IDC_0 + 8, IDC_PNT, IDC_0 + 9, IDC_MUL, IDC_0 + 2, IDC_SUB,   IDC_0 + 1,
+                                                IDC_DIV,   IDC_0 + 7, IDC_EQU };
+
+    // (1.5 + sin 0.5) * ln 3 - sqrt 2 ^ 3 =
+    const vector<OpCode> s_scientificCommands = { IDC_OPENP, IDC_0 + 1, IDC_PNT, IDC_0 + 5, IDC_ADD,  IDC_0,     IDC_PNT,   IDC_0 + 5,
+                                                  IDC_SIN,   IDC_CLOSEP, IDC_MUL, IDC_0 + 3, IDC_LN,   IDC_SUB,   IDC_0 + 2, IDC_SQRT,
+                                                  IDC_PWR,   IDC_0 + 3,  IDC_EQU };
+
+    // FFA1 AND F0F0 << 4 OR 1234 XOR C0DE =
+    const vector<OpCode> s_programmerCommands = { IDC_F,     IDC_F,     IDC_A,     IDC_0 + 1, IDC_AND,   IDC_F,     IDC_0,     IDC_F,
+                                                  IDC_0,     IDC_LSHF,  IDC_0 + 4, IDC_OR,    IDC_0 + 1, IDC_0 + 2, IDC_0 + 3, IDC_0 + 4,
+                                                  IDC_XOR,   IDC_C,     IDC_0,     IDC_D,     IDC_E,     IDC_EQU };
+
+    enum class Mode
+    {
+        Standard,
+        Scientific,
+        Programmer
+    };
+
+    // Sets the engine up the way CalculatorManager does for each mode, then
+    // replays the same command stream every iteration.
+    void BM_ProcessCommand(benchmark::State& state, Mode mode)
+    {
+        EngineResources resources;
+        NullDisplay display;
+        CCalcEngine::InitialOneTimeOnlySetup(resources);
+
+        unique_ptr<CCalcEngine> engine;
+        vector<OpCode> const* commands = nullptr;
+        switch (mode)
+        {
+        case Mode::Standard:
+            engine = make_unique<CCalcEngine>(false, false, &resources, &display, make_shared<CalculatorHistory>(MAX_HISTORY_SIZE));
+            engine->ProcessCommand(IDC_DEC);
+            engine->ProcessCommand(IDC_CLEAR);
+            engine->ChangePrecision(static_cast<int>(CalculatorPrecision::StandardModePrecision));
+            commands = &s_standardCommands;
+            break;
+        case Mode::Scientific:
+            engine = make_unique<CCalcEngine>(true, false, &resources, &display, make_shared<CalculatorHistory>(MAX_HISTORY_SIZE));
+            engine->ProcessCommand(IDC_DEC);
+            engine->ProcessCommand(IDC_CLEAR);
+            engine->ChangePrecision(static_cast<int>(CalculatorPrecision::ScientificModePrecision));
+            commands = &s_scientificCommands;
+            break;
+        case Mode::Programmer:
+            engine = make_unique<CCalcEngine>(true, true, &resources, &display, nullptr);
+            engine->ProcessCommand(IDC_DEC);
+            engine->ProcessCommand(IDC_CLEAR);
+            engine->ChangePrecision(static_cast<int>(CalculatorPrecision::ProgrammerModePrecision));
+            engine->ProcessCommand(IDC_HEX);
+            engine->ProcessCommand(IDC_QWORD);
+            commands = &s_programmerCommands;
+            break;
+        }
+
+        for (OpCode command : *commands)
+        {
+            engine->ProcessCommand(command);
+        }
+        if (engine->FInErrorState())
+        {
+            state.SkipWithError("the command stream put the engine in an error state");
+            return;
+        }
+        engine->ProcessCommand(IDC_CLEAR);
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            for (OpCode command : *commands)
+            {
+                engine->ProcessCommand(command);
+            }
+            engine->ProcessCommand(IDC_CLEAR);
+        }
+        counters.Report(state);
+
+        state.SetItemsProcessed(state.iterations() * (commands->size() + 1));
+    }
+
+    // What the programmer panel asks for on every display update: HEX, DEC,
+    // OCT and BIN grouped, and BIN again ungrouped for the bit flip panel.
+    void BM_ProgrammerPanel(benchmark::State& state, bool batched)
+    {
+        EngineResources resources;
+        NullDisplay display;
+        CCalcEngine::InitialOneTimeOnlySetup(resources);
+
+        CCalcEngine engine(true, true, &resources, &display, nullptr);
+        engine.ProcessCommand(IDC_DEC);
+        engine.ProcessCommand(IDC_CLEAR);
+        engine.ChangePrecision(static_cast<int>(CalculatorPrecision::ProgrammerModePrecision));
+        engine.ProcessCommand(IDC_HEX);
+        engine.ProcessCommand(IDC_QWORD);
+        for (OpCode command : s_programmerCommands)
+        {
+            engine.ProcessCommand(command);
+        }
+
+        constexpr int32_t precision = 64;
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            if (batched)
+            {
+                benchmark::DoNotOptimize(engine.GetCurrentResultsForRadixes({ 16, 10, 8, 2 }, precision));
+            }
+            else
+            {
+                for (uint32_t radix : { 16, 10, 8, 2 })
+                {
+                    benchmark::DoNotOptimize(engine.GetCurrentResultForRadix(radix, precision, true));
+                }
+                benchmark::DoNotOptimize(engine.GetCurrentResultForRadix(2, precision, false));
+            }
+        }
+        counters.Report(state);
+    }
+
+    // Switches a long programmer expression between HEX and DEC. The operands keep the strings they were shown in
+    // before, so only the ones that read differently in the new radix are formatted and redrawn.
+    void BM_RadixSwitch(benchmark::State& state)
+    {
+        EngineResources resources;
+        RedrawCountingDisplay display;
+        CCalcEngine::InitialOneTimeOnlySetup(resources);
+
+        CCalcEngine engine(true, true, &resources, &display, nullptr);
+        engine.ProcessCommand(IDC_DEC);
+        engine.ProcessCommand(IDC_CLEAR);
+        engine.ChangePrecision(static_cast<int>(CalculatorPrecision::ProgrammerModePrecision));
+        engine.ProcessCommand(IDC_HEX);
+        engine.ProcessCommand(IDC_QWORD);
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            engine.ProcessCommand(IDC_0 + static_cast<OpCode>(i % 16));
+            engine.ProcessCommand(IDC_ADD);
+        }
+
+        display.redrawnTokenCount = 0;
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            engine.ProcessCommand(IDC_DEC);
+            engine.ProcessCommand(IDC_HEX);
+        }
+        counters.Report(state);
+
+        state.counters["redrawn/op"] = benchmark::Counter(static_cast<double>(display.redrawnTokenCount), benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * 2);
+    }
+
+    // Replays the standard command stream as a stored calculation, through CalculatorManager with a display
+    // attached, or through BatchEvaluator without one.
+    void BM_Replay(benchmark::State& state, bool batched)
+    {
+        EngineResources resources;
+        NullDisplay display;
+
+        vector<Command> commands;
+        for (OpCode command : s_standardCommands)
+        {
+            commands.push_back(static_cast<Command>(command));
+        }
+
+        CalculatorManager manager(&display, &resources);
+        BatchEvaluator evaluator(&resources);
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            if (batched)
+            {
+                benchmark::DoNotOptimize(evaluator.Evaluate(commands));
+            }
+            else
+            {
+                manager.Reset();
+                for (Command command : commands)
+                {
+                    manager.SendCommand(command);
+                }
+            }
+        }
+        counters.Report(state);
+
+        state.SetItemsProcessed(state.iterations() * commands.size());
+    }
+
+    // Replays a batch of copies of the standard command stream across range(0) workers.
+    void BM_ParallelReplay(benchmark::State& state)
+    {
+        static constexpr size_t BATCH_SIZE = 256;
+
+        EngineResources resources;
+
+        vector<Command> commands;
+        for (OpCode command : s_standardCommands)
+        {
+            commands.push_back(static_cast<Command>(command));
+        }
+        vector<vector<Command>> sequences(BATCH_SIZE, commands);
+
+        ParallelBatchEvaluator evaluator(&resources, static_cast<unsigned int>(state.range(0)));
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(evaluator.Evaluate(sequences));
+        }
+
+        BatchStatistics const& statistics = evaluator.GetLastStatistics();
+        state.counters["shards"] = static_cast<double>(statistics.shardCount);
+        state.counters["stolen"] = static_cast<double>(statistics.stolenShardCount);
+        state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+    }
+
+    // A full Scientific mode history, as CalculatorManager keeps it.
+    vector<shared_ptr<HISTORYITEM>> MakeHistory()
+    {
+        EngineResources resources;
+        NullDisplay display;
+        CalculatorManager manager(&display, &resources);
+        manager.SetScientificMode();
+        for (size_t i = 0; i < MAX_HISTORY_SIZE; i++)
+        {
+            for (OpCode command : s_scientificCommands)
+            {
+                manager.SendCommand(static_cast<Command>(command));
+            }
+        }
+
+        return manager.GetHistoryItems();
+    }
+
+    // Saves the history into the same buffer every iteration.
+    void BM_HistorySave(benchmark::State& state)
+    {
+        vector<shared_ptr<HISTORYITEM>> history = MakeHistory();
+        vector<uint8_t> buffer(HistorySerializer::Serialize(history, nullptr, 0));
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(HistorySerializer::Serialize(history, buffer.data(), buffer.size()));
+        }
+        counters.Report(state);
+
+        state.SetBytesProcessed(state.iterations() * buffer.size());
+    }
+
+    void BM_HistoryLoad(benchmark::State& state)
+    {
+        vector<uint8_t> bytes = HistorySerializer::Serialize(MakeHistory());
+
+        vector<shared_ptr<HISTORYITEM>> history;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(HistorySerializer::TryDeserialize(bytes.data(), bytes.size(), history));
+        }
+
+        state.SetBytesProcessed(state.iterations() * bytes.size());
+    }
+
+    // Adds to a history that is already full, so every item evicts the oldest.
+    void BM_HistoryAdd(benchmark::State& state)
+    {
+        vector<shared_ptr<HISTORYITEM>> items = MakeHistory();
+        CalculatorHistory history(MAX_HISTORY_SIZE);
+        for (auto const& item : items)
+        {
+            history.AddItem(item);
+        }
+
+        AllocationCounters counters;
+        size_t i = 0;
+        for (auto _ : state)
+        {
+            HISTORYITEMVECTOR const& item = items[i++ % items.size()]->historyItemVector;
+            benchmark::DoNotOptimize(history.AddToHistory(item.spTokens, item.spCommands, item.result));
+        }
+        counters.Report(state);
+
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+BENCHMARK_CAPTURE(BM_ProcessCommand, Standard, Mode::Standard);
+BENCHMARK_CAPTURE(BM_ProcessCommand, Scientific, Mode::Scientific);
+BENCHMARK_CAPTURE(BM_ProcessCommand, Programmer, Mode::Programmer);
+
+BENCHMARK_CAPTURE(BM_ProgrammerPanel, PerRadix, false);
+BENCHMARK_CAPTURE(BM_ProgrammerPanel, Batched, true);
+BENCHMARK(BM_RadixSwitch)->RangeMultiplier(4)->Range(4, 256);
+
+BENCHMARK_CAPTURE(BM_Replay, SendCommand, false);
+BENCHMARK_CAPTURE(BM_Replay, Batched, true);
+
+BENCHMARK(BM_ParallelReplay)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+BENCHMARK(BM_HistorySave);
+BENCHMARK(BM_HistoryLoad);
+BENCHMARK(BM_HistoryAdd);
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <string>
+#include "BenchmarkSupport.h"
+#include "NumberFormattingUtils.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+using namespace UnitConversionManager::NumberFormattingUtils;
+
+namespace
+{
+    // A converted value as the unit converter rounds it, with seven digits.
+    constexpr double VALUE = 1047.19452914832;
+    constexpr unsigned int PRECISION = 3;
+
+    enum class Formatter
+    {
+        Stream, // a wstringstream per value, as RoundSignificantDigits and ToScientificNumber used to
+        Buffer, // into a buffer on the stack
+        String  // the wstring returning functions, which allocate only the result
+    };
+
+    void BM_FormatFixed(benchmark::State& state, Formatter formatter)
+    {
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            switch (formatter)
+            {
+            case Formatter::Stream:
+            {
+                wstringstream out(wstringstream::out);
+                out << fixed;
+                out.precision(PRECISION);
+                out << VALUE;
+                benchmark::DoNotOptimize(out.str());
+                break;
+            }
+            case Formatter::Buffer:
+            {
+                wchar_t buffer[MAX_FORMATTED_LENGTH];
+                benchmark::DoNotOptimize(FormatFixed(VALUE, PRECISION, buffer, size(buffer)));
+                benchmark::DoNotOptimize(buffer);
+                break;
+            }
+            case Formatter::String:
+                benchmark::DoNotOptimize(RoundSignificantDigits(VALUE, PRECISION));
+                break;
+            }
+        }
+        counters.Report(state);
+    }
+
+    void BM_FormatScientific(benchmark::State& state, Formatter formatter)
+    {
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            switch (formatter)
+            {
+            case Formatter::Stream:
+            {
+                wstringstream out(wstringstream::out);
+                out << scientific << VALUE;
+                benchmark::DoNotOptimize(out.str());
+                break;
+            }
+            case Formatter::Buffer:
+            {
+                wchar_t buffer[MAX_FORMATTED_LENGTH];
+                benchmark::DoNotOptimize(FormatScientific(VALUE, buffer, size(buffer)));
+                benchmark::DoNotOptimize(buffer);
+                break;
+            }
+            case Formatter::String:
+                benchmark::DoNotOptimize(ToScientificNumber(VALUE));
+                break;
+            }
+        }
+        counters.Report(state);
+    }
+
+    // The shortest form has no stream counterpart, so this is for comparing it with the fixed one.
+    void BM_FormatShortest(benchmark::State& state)
+    {
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            wchar_t buffer[MAX_FORMATTED_LENGTH];
+            benchmark::DoNotOptimize(FormatShortest(VALUE, buffer, size(buffer)));
+            benchmark::DoNotOptimize(buffer);
+        }
+        counters.Report(state);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_FormatFixed, Stream, Formatter::Stream);
+BENCHMARK_CAPTURE(BM_FormatFixed, Buffer, Formatter::Buffer);
+BENCHMARK_CAPTURE(BM_FormatFixed, String, Formatter::String);
+BENCHMARK_CAPTURE(BM_FormatScientific, Stream, Formatter::Stream);
+BENCHMARK_CAPTURE(BM_FormatScientific, Buffer, Formatter::Buffer);
+BENCHMARK_CAPTURE(BM_FormatScientific, String, Formatter::String);
+BENCHMARK(BM_FormatShortest);
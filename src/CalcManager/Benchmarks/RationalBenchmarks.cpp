@@ -0,0 +1,174 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <utility>
+#include "BenchmarkSupport.h"
+#include "Header Files/Rational.h"
+#include "Header Files/RationalMath.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace CalcManagerBenchmarks;
+
+namespace
+{
+    enum class Operands
+    {
+        Small,   // integers that fit a machine word
+        Decimal, // what typing a few digits and a decimal point produces
+        Big      // a few hundred bits in both numerator and denominator
+    };
+
+    pair<Rational, Rational> MakeOperands(Operands operands)
+    {
+        switch (operands)
+        {
+        case Operands::Small:
+            return { Rational{ 123 }, Rational{ -45 } };
+        case Operands::Decimal:
+            return { Rational{ 12345 } / Rational{ 100 }, Rational{ 1 } / Rational{ 3 } };
+        default:
+        {
+            Rational big =
+                Rational{ uint64_t{ 0xFFFFFFFFFFFFFFF1ull } } * Rational{ uint64_t{ 0xFFFFFFFFFFFFFF13ull } } * Rational{ uint64_t{ 0xFFFFFFFFFFFF1234ull } };
+            return { big, big / (big + Rational{ 7 }) };
+        }
+        }
+    }
+
+    template <typename Op>
+    void BenchmarkOperator(benchmark::State& state, Operands operands, Op op)
+    {
+        ChangeConstants(10, 32);
+        auto [lhs, rhs] = MakeOperands(operands);
+        Rational result;
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            result = lhs;
+            op(result, rhs);
+            benchmark::DoNotOptimize(result);
+        }
+        counters.Report(state);
+    }
+
+    template <typename Op>
+    void BenchmarkComparison(benchmark::State& state, Operands operands, Op op)
+    {
+        ChangeConstants(10, 32);
+        auto [lhs, rhs] = MakeOperands(operands);
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(op(lhs, rhs));
+        }
+        counters.Report(state);
+    }
+
+    void BM_RationalAdd(benchmark::State& state, Operands operands)
+    {
+        BenchmarkOperator(state, operands, [](Rational& result, Rational const& rhs) { result += rhs; });
+    }
+
+    void BM_RationalSubtract(benchmark::State& state, Operands operands)
+    {
+        BenchmarkOperator(state, operands, [](Rational& result, Rational const& rhs) { result -= rhs; });
+    }
+
+    void BM_RationalMultiply(benchmark::State& state, Operands operands)
+    {
+        BenchmarkOperator(state, operands, [](Rational& result, Rational const& rhs) { result *= rhs; });
+    }
+
+    void BM_RationalDivide(benchmark::State& state, Operands operands)
+    {
+        BenchmarkOperator(state, operands, [](Rational& result, Rational const& rhs) { result /= rhs; });
+    }
+
+    void BM_RationalEqual(benchmark::State& state, Operands operands)
+    {
+        BenchmarkComparison(state, operands, [](Rational const& lhs, Rational const& rhs) { return lhs == rhs; });
+    }
+
+    void BM_RationalLess(benchmark::State& state, Operands operands)
+    {
+        BenchmarkComparison(state, operands, [](Rational const& lhs, Rational const& rhs) { return lhs < rhs; });
+    }
+
+    // The transcendentals go straight to ratpak, RationalMath always asks
+    // for the same fixed precision. The argument is 7/10, in range for all.
+    void BM_Transcendental(benchmark::State& state, void (*function)(PRAT*, int32_t))
+    {
+        int32_t precision = static_cast<int32_t>(state.range(0));
+        ChangeConstants(10, precision);
+        PRAT x = i32torat(7);
+        PRAT ten = i32torat(10);
+        divrat(&x, ten, precision);
+
+        for (auto _ : state)
+        {
+            PRAT result = nullptr;
+            DUPRAT(result, x);
+            function(&result, precision);
+            destroyrat(result);
+        }
+
+        destroyrat(ten);
+        destroyrat(x);
+    }
+
+    // The same sine again, as when a history item is recalled, either worked
+    // out each time or taken from the results RationalMath keeps.
+    void BM_RepeatedSin(benchmark::State& state, bool cached)
+    {
+        ChangeConstants(10, 32);
+        RationalMath::ClearResultCache();
+        Rational x = Rational{ 5 } / Rational{ 7 };
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            if (!cached)
+            {
+                RationalMath::ClearResultCache();
+            }
+            benchmark::DoNotOptimize(RationalMath::Sin(x, AngleType::Degrees));
+        }
+        counters.Report(state);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_RationalAdd, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalAdd, Decimal, Operands::Decimal);
+BENCHMARK_CAPTURE(BM_RationalAdd, Big, Operands::Big);
+BENCHMARK_CAPTURE(BM_RationalSubtract, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalSubtract, Decimal, Operands::Decimal);
+BENCHMARK_CAPTURE(BM_RationalSubtract, Big, Operands::Big);
+BENCHMARK_CAPTURE(BM_RationalMultiply, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalMultiply, Decimal, Operands::Decimal);
+BENCHMARK_CAPTURE(BM_RationalMultiply, Big, Operands::Big);
+BENCHMARK_CAPTURE(BM_RationalDivide, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalDivide, Decimal, Operands::Decimal);
+BENCHMARK_CAPTURE(BM_RationalDivide, Big, Operands::Big);
+BENCHMARK_CAPTURE(BM_RationalEqual, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalEqual, Big, Operands::Big);
+BENCHMARK_CAPTURE(BM_RationalLess, Small, Operands::Small);
+BENCHMARK_CAPTURE(BM_RationalLess, Big, Operands::Big);
+
+BENCHMARK_CAPTURE(BM_Transcendental, Exp, [](PRAT* px, int32_t precision) { exprat(px, 10, precision); })->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK_CAPTURE(BM_Transcendental, Log, [](PRAT* px, int32_t precision) { lograt(px, precision); })->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK_CAPTURE(BM_Transcendental, Sin, [](PRAT* px, int32_t precision) { sinanglerat(px, AngleType::Radians, 10, precision); })
+    ->Arg(32)
+    ->Arg(128)
+    ->Arg(512);
+BENCHMARK_CAPTURE(BM_Transcendental, ATan, [](PRAT* px, int32_t precision) { atanrat(px, 10, precision); })->Arg(32)->Arg(128)->Arg(512);
+BENCHMARK_CAPTURE(BM_Transcendental, CubeRoot, [](PRAT* px, int32_t precision) {
+    PRAT three = i32torat(3);
+    rootrat(px, three, 10, precision);
+    destroyrat(three);
+})->Arg(32)->Arg(128)->Arg(512);
+
+BENCHMARK_CAPTURE(BM_RepeatedSin, Computed, false);
+BENCHMARK_CAPTURE(BM_RepeatedSin, Cached, true);
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <climits>
+#include "BenchmarkSupport.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+
+// Each algorithm ratpak can pick between is forced in turn over a range of
+// sizes, the crossover in the results is where the thresholds belong.
+
+namespace
+{
+    enum class MulAlgorithm
+    {
+        Schoolbook,
+        Karatsuba,
+        Toom3
+    };
+
+    enum class DivAlgorithm
+    {
+        LongDivision,
+        Newton
+    };
+
+    enum class SeriesAlgorithm
+    {
+        Taylor,
+        BinarySplitting
+    };
+
+    enum class ConvAlgorithm
+    {
+        Horner,
+        Halves
+    };
+
+    // Multiplies two numbers of range(0) BASEX digits. Only the top level
+    // uses the algorithm asked for, the smaller products under it go to the
+    // schoolbook loops, which is the choice a threshold of range(0) makes.
+    void BM_MultiplyAlgorithm(benchmark::State& state, MulAlgorithm algorithm)
+    {
+        int32_t cdigits = static_cast<int32_t>(state.range(0));
+        RatpakThresholds thresholds;
+        switch (algorithm)
+        {
+        case MulAlgorithm::Schoolbook:
+            SetMulThresholds(INT32_MAX, INT32_MAX);
+            break;
+        case MulAlgorithm::Karatsuba:
+            SetMulThresholds(cdigits, INT32_MAX);
+            break;
+        case MulAlgorithm::Toom3:
+            SetMulThresholds(cdigits, cdigits);
+            break;
+        }
+
+        PNUMBER a = MakeNumber(cdigits, BASEX, 1);
+        PNUMBER b = MakeNumber(cdigits, BASEX, 2);
+        for (auto _ : state)
+        {
+            PNUMBER product = nullptr;
+            DUPNUM(product, a);
+            mulnumx(&product, b);
+            destroynum(product);
+        }
+        destroynum(b);
+        destroynum(a);
+    }
+
+    // Divides a number of twice range(1) digits by one of range(1) digits,
+    // in radix range(0), which is 0 for BASEX.
+    void BM_DivideAlgorithm(benchmark::State& state, DivAlgorithm algorithm)
+    {
+        RatpakThresholds thresholds;
+        if (algorithm == DivAlgorithm::LongDivision)
+        {
+            SetDivThresholds(INT32_MAX, INT32_MAX);
+        }
+        else
+        {
+            SetDivThresholds(1, 1);
+        }
+
+        uint64_t radix = state.range(0) == 0 ? BASEX : static_cast<uint64_t>(state.range(0));
+        int32_t cdigits = static_cast<int32_t>(state.range(1));
+        if (radix != BASEX)
+        {
+            ChangeConstants(static_cast<uint32_t>(radix), cdigits);
+        }
+        PNUMBER a = MakeNumber(2 * cdigits, radix, 3);
+        PNUMBER b = MakeNumber(cdigits, radix, 4);
+        for (auto _ : state)
+        {
+            PNUMBER quotient = nullptr;
+            DUPNUM(quotient, a);
+            if (radix == BASEX)
+            {
+                divnumx(&quotient, b, cdigits);
+            }
+            else
+            {
+                divnum(&quotient, b, static_cast<uint32_t>(radix), cdigits);
+            }
+            destroynum(quotient);
+        }
+        destroynum(b);
+        destroynum(a);
+    }
+
+    // e^(7/10) to range(0) decimal digits.
+    void BM_SeriesAlgorithm(benchmark::State& state, SeriesAlgorithm algorithm)
+    {
+        int32_t precision = static_cast<int32_t>(state.range(0));
+        ChangeConstants(10, precision);
+
+        RatpakThresholds thresholds;
+        SetSeriesThreshold(algorithm == SeriesAlgorithm::Taylor ? INT32_MAX : 1);
+
+        PRAT x = i32torat(7);
+        PRAT ten = i32torat(10);
+        divrat(&x, ten, precision);
+        for (auto _ : state)
+        {
+            PRAT result = nullptr;
+            DUPRAT(result, x);
+            exprat(&result, 10, precision);
+            destroyrat(result);
+        }
+        destroyrat(ten);
+        destroyrat(x);
+    }
+
+    // Converts a number of range(0) BASEX digits to radix 10 and back. Unlike
+    // the multiply the halves are split again down to the default threshold,
+    // splitting only the top level leaves two Horner loops of half the size
+    // and the time still grows fourfold with each doubling.
+    void BM_ConvertAlgorithm(benchmark::State& state, ConvAlgorithm algorithm)
+    {
+        int32_t cdigits = static_cast<int32_t>(state.range(0));
+        RatpakThresholds thresholds;
+        if (algorithm == ConvAlgorithm::Horner)
+        {
+            SetConvThreshold(INT32_MAX);
+        }
+
+        PNUMBER a = MakeNumber(cdigits, BASEX, 5);
+        for (auto _ : state)
+        {
+            PNUMBER decimal = nRadixxtonum(a, 10, cdigits);
+            PNUMBER back = numtonRadixx(decimal, 10);
+            destroynum(back);
+            destroynum(decimal);
+        }
+        destroynum(a);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_MultiplyAlgorithm, Schoolbook, MulAlgorithm::Schoolbook)->RangeMultiplier(2)->Range(8, 2048);
+BENCHMARK_CAPTURE(BM_MultiplyAlgorithm, Karatsuba, MulAlgorithm::Karatsuba)->RangeMultiplier(2)->Range(8, 2048);
+BENCHMARK_CAPTURE(BM_MultiplyAlgorithm, Toom3, MulAlgorithm::Toom3)->RangeMultiplier(2)->Range(8, 2048);
+
+BENCHMARK_CAPTURE(BM_DivideAlgorithm, LongDivision, DivAlgorithm::LongDivision)
+    ->ArgsProduct({ { 0, 10 }, benchmark::CreateRange(8, 1024, 2) });
+BENCHMARK_CAPTURE(BM_DivideAlgorithm, Newton, DivAlgorithm::Newton)->ArgsProduct({ { 0, 10 }, benchmark::CreateRange(8, 1024, 2) });
+
+BENCHMARK_CAPTURE(BM_SeriesAlgorithm, Taylor, SeriesAlgorithm::Taylor)->RangeMultiplier(2)->Range(16, 1024);
+BENCHMARK_CAPTURE(BM_SeriesAlgorithm, BinarySplitting, SeriesAlgorithm::BinarySplitting)->RangeMultiplier(2)->Range(16, 1024);
+
+BENCHMARK_CAPTURE(BM_ConvertAlgorithm, Horner, ConvAlgorithm::Horner)->RangeMultiplier(2)->Range(4, 8192);
+BENCHMARK_CAPTURE(BM_ConvertAlgorithm, Halves, ConvAlgorithm::Halves)->RangeMultiplier(2)->Range(4, 8192);
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include "BenchmarkSupport.h"
+#include "ExactConversion.h"
+
+using namespace std;
+using namespace CalcManagerBenchmarks;
+using namespace UnitConversionManager;
+
+namespace
+{
+    // Yobibytes to bytes, a ratio a double can't hold, and a value with as
+    // many digits as the converter usually displays.
+    constexpr wstring_view YOBIBYTE_RATIO = L"1208925819614629174.706176/0.000001";
+    constexpr double YOBIBYTE_FACTOR = 1208925819614629174.706176 / 0.000001;
+    const wstring VALUE = L"123.456";
+
+    enum class Conversion
+    {
+        Double,        // what the converter does by default
+        Exact,         // with the ratio read once, as the converter caches it
+        ExactUncached, // reading the ratio again for every value
+        ExactHexEngine // the constants left in radix 16 by the engine, which converting leaves alone
+    };
+
+    void BM_UnitConversion(benchmark::State& state, Conversion conversion)
+    {
+        ChangeConstants(conversion == Conversion::ExactHexEngine ? 16 : 10, 32);
+        auto exact = ExactConversion::TryCreate(YOBIBYTE_RATIO, L"", false);
+
+        AllocationCounters counters;
+        for (auto _ : state)
+        {
+            switch (conversion)
+            {
+            case Conversion::Double:
+                benchmark::DoNotOptimize(stod(VALUE) * YOBIBYTE_FACTOR);
+                break;
+            case Conversion::ExactUncached:
+                benchmark::DoNotOptimize(ExactConversion::TryCreate(YOBIBYTE_RATIO, L"", false)->TryConvert(VALUE));
+                break;
+            default:
+                benchmark::DoNotOptimize(exact->TryConvert(VALUE));
+                break;
+            }
+        }
+        counters.Report(state);
+    }
+}
+
+BENCHMARK_CAPTURE(BM_UnitConversion, Double, Conversion::Double);
+BENCHMARK_CAPTURE(BM_UnitConversion, Exact, Conversion::Exact);
+BENCHMARK_CAPTURE(BM_UnitConversion, ExactUncached, Conversion::ExactUncached);
+BENCHMARK_CAPTURE(BM_UnitConversion, ExactHexEngine, Conversion::ExactHexEngine);
@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include "Header Files/FixedWidthInteger.h"
+
+using namespace std;
+
+namespace CalcEngine
+{
+    namespace
+    {
+        uint64_t MaskFromWidth(int32_t width)
+        {
+            return width >= 64 ? ~uint64_t{ 0 } : (uint64_t{ 1 } << width) - 1;
+        }
+
+        // Reads p when q is one and p fits 64 bits. Anything else, including
+        // a q that would divide p evenly, is left to ratpak, which would
+        // flatten it first.
+        bool TryGetInteger(Rational const& rat, int32_t& sign, uint64_t& magnitude)
+        {
+            PNUMBER p = rat.P().Lend();
+            PNUMBER q = rat.Q().Lend();
+            if (q->sign != 1 || q->cdigit != 1 || q->exp != 0 || q->mant[0] != 1 || p->exp < 0 || p->cdigit + p->exp > 2)
+            {
+                return false;
+            }
+
+            magnitude = 0;
+            for (int32_t i = p->cdigit - 1; i >= 0; i--)
+            {
+                magnitude = (magnitude << BASEXPWR) | p->mant[i];
+            }
+            if (p->exp > 0)
+            {
+                magnitude <<= BASEXPWR;
+            }
+            sign = p->sign;
+            return true;
+        }
+    }
+
+    FixedWidthInteger::FixedWidthInteger() noexcept
+        : m_bits{ 0 }
+        , m_width{ 64 }
+    {
+    }
+
+    FixedWidthInteger::FixedWidthInteger(uint64_t bits, int32_t width) noexcept
+        : m_bits{ bits & MaskFromWidth(width) }
+        , m_width{ width }
+    {
+    }
+
+    bool FixedWidthInteger::TryFromRational(Rational const& rat, int32_t width, FixedWidthInteger& word) noexcept
+    {
+        int32_t sign;
+        uint64_t magnitude;
+        if (!TryGetInteger(rat, sign, magnitude) || sign != 1 || (magnitude & ~MaskFromWidth(width)) != 0)
+        {
+            return false;
+        }
+
+        word = FixedWidthInteger{ magnitude, width };
+        return true;
+    }
+
+    bool FixedWidthInteger::TryTruncate(Rational const& rat, int32_t width, FixedWidthInteger& word) noexcept
+    {
+        int32_t sign;
+        uint64_t magnitude;
+        if (!TryGetInteger(rat, sign, magnitude) || (sign < 0 && magnitude == 0))
+        {
+            // ratpak carries the sign of -0 through &, leave that to it.
+            return false;
+        }
+
+        // A negative number is kept in two's complement, -x is ~(x - 1).
+        word = FixedWidthInteger{ (sign < 0) ? ~(magnitude - 1) : magnitude, width };
+        return true;
+    }
+
+    Rational FixedWidthInteger::ToRational() const
+    {
+        return Rational{ m_bits };
+    }
+
+    wstring FixedWidthInteger::ToString(uint32_t radix) const
+    {
+        static constexpr wstring_view digits = L"0123456789ABCDEF";
+
+        wstring result;
+        if (radix == 2 || radix == 8 || radix == 16)
+        {
+            // Every digit is a slice of bits, read them from the bottom up.
+            uint32_t bitsPerDigit = (radix == 2) ? 1 : (radix == 8) ? 3 : 4;
+            uint64_t bits = m_bits;
+            do
+            {
+                result += digits[bits & (radix - 1)];
+                bits >>= bitsPerDigit;
+            } while (bits != 0);
+        }
+        else if (radix == 10)
+        {
+            uint64_t magnitude = Magnitude();
+            do
+            {
+                result += digits[magnitude % 10];
+                magnitude /= 10;
+            } while (magnitude != 0);
+
+            if (Msb())
+            {
+                result += L'-';
+            }
+        }
+
+        reverse(result.begin(), result.end());
+        return result;
+    }
+
+    uint64_t FixedWidthInteger::Bits() const noexcept
+    {
+        return m_bits;
+    }
+
+    int32_t FixedWidthInteger::Width() const noexcept
+    {
+        return m_width;
+    }
+
+    uint64_t FixedWidthInteger::Mask() const noexcept
+    {
+        return MaskFromWidth(m_width);
+    }
+
+    bool FixedWidthInteger::Msb() const noexcept
+    {
+        return ((m_bits >> (m_width - 1)) & 1) != 0;
+    }
+
+    uint64_t FixedWidthInteger::Magnitude() const noexcept
+    {
+        return Msb() ? (m_bits ^ Mask()) + 1 : m_bits;
+    }
+
+    FixedWidthInteger FixedWidthInteger::ShiftRightArithmetic(uint32_t shift) const noexcept
+    {
+        uint64_t bits = m_bits >> shift;
+        if (Msb())
+        {
+            bits |= Mask() ^ (Mask() >> shift);
+        }
+        return FixedWidthInteger{ bits, m_width };
+    }
+
+    FixedWidthInteger FixedWidthInteger::operator~() const noexcept
+    {
+        return FixedWidthInteger{ ~m_bits, m_width };
+    }
+
+    FixedWidthInteger operator&(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept
+    {
+        return FixedWidthInteger{ lhs.m_bits & rhs.m_bits, lhs.m_width };
+    }
+
+    FixedWidthInteger operator|(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept
+    {
+        return FixedWidthInteger{ lhs.m_bits | rhs.m_bits, lhs.m_width };
+    }
+
+    FixedWidthInteger operator^(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept
+    {
+        return FixedWidthInteger{ lhs.m_bits ^ rhs.m_bits, lhs.m_width };
+    }
+}
@@ -31,6 +31,7 @@ void CHistoryCollector::ReinitHistory()
     m_lastBinOpStartIndex = -1;
     m_curOperandIndex = 0;
     m_bLastOpndBrace = false;
+    m_firstChangedToken = 0;
     if (m_spTokens != nullptr)
     {
         m_spTokens->clear();
@@ -48,6 +49,8 @@ CHistoryCollector::CHistoryCollector(ICalcDisplay* pCalcDisplay, std::shared_ptr
     , m_pCalcDisplay(pCalcDisplay)
     , m_iCurLineHistStart(-1)
     , m_decimalSymbol(decimalSymbol)
+    , m_bCollecting(pCalcDisplay != nullptr || pHistoryDisplay != nullptr)
+    , m_firstChangedToken(0)
 {
     ReinitHistory();
 }
@@ -65,6 +68,11 @@ CHistoryCollector::~CHistoryCollector()
 
 void CHistoryCollector::AddOpndToHistory(wstring_view numStr, Rational const& rat, bool fRepetition)
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     int iCommandEnd = AddCommand(GetOperandCommandsFromString(numStr, rat));
     m_lastOpStartIndex = IchAddSzToEquationSz(numStr, iCommandEnd);
 
@@ -78,6 +86,11 @@ void CHistoryCollector::AddOpndToHistory(wstring_view numStr, Rational const& ra
 
 void CHistoryCollector::RemoveLastOpndFromHistory()
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     TruncateEquationSzFromIch(m_lastOpStartIndex);
     SetExpressionDisplay();
     m_lastOpStartIndex = -1;
@@ -86,6 +99,11 @@ void CHistoryCollector::RemoveLastOpndFromHistory()
 
 void CHistoryCollector::AddBinOpToHistory(int nOpCode, bool isIntegerMode, bool fNoRepetition)
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     int iCommandEnd = AddCommand(std::make_shared<CBinaryCommand>(nOpCode));
     m_lastBinOpStartIndex = IchAddSzToEquationSz(L" ", -1);
 
@@ -104,6 +122,11 @@ void CHistoryCollector::AddBinOpToHistory(int nOpCode, bool isIntegerMode, bool
 // one isn't. (Eg. 1*2* to 1*2^). It can add explicit brackets to ensure the precedence is inverted. (Eg. (1*2) ^)
 void CHistoryCollector::ChangeLastBinOp(int nOpCode, bool fPrecInvToHigher, bool isIntegerMode)
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     TruncateEquationSzFromIch(m_lastBinOpStartIndex);
     if (fPrecInvToHigher)
     {
@@ -132,6 +155,11 @@ void CHistoryCollector::PopLastOpndStart()
 
 void CHistoryCollector::AddOpenBraceToHistory()
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     AddCommand(std::make_shared<CParentheses>(IDC_OPENP));
     int ichOpndStart = IchAddSzToEquationSz(CCalcEngine::OpCodeToString(IDC_OPENP), -1);
     PushLastOpndStart(ichOpndStart);
@@ -142,6 +170,11 @@ void CHistoryCollector::AddOpenBraceToHistory()
 
 void CHistoryCollector::AddCloseBraceToHistory()
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     AddCommand(std::make_shared<CParentheses>(IDC_CLOSEP));
     IchAddSzToEquationSz(CCalcEngine::OpCodeToString(IDC_CLOSEP), -1);
     SetExpressionDisplay();
@@ -153,6 +186,11 @@ void CHistoryCollector::AddCloseBraceToHistory()
 
 void CHistoryCollector::EnclosePrecInversionBrackets()
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     // Top of the Opnd starts index or 0 is nothing is in top
     int ichStart = (m_curOperandIndex > 0) ? m_operandIndices[m_curOperandIndex - 1] : 0;
 
@@ -172,6 +210,11 @@ bool CHistoryCollector::FOpndAddedToHistory() const
 //
 void CHistoryCollector::AddUnaryOpToHistory(int nOpCode, bool fInv, AngleType angletype)
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     int iCommandEnd;
     // When successfully applying a unary op, there should be an opnd already
     // A very special case of % which is a funny post op unary op.
@@ -303,6 +346,11 @@ void CHistoryCollector::CompleteHistoryLine(wstring_view numStr)
 
 void CHistoryCollector::CompleteEquation(std::wstring_view numStr)
 {
+    if (!m_bCollecting)
+    {
+        return;
+    }
+
     // Add only '=' token and not add EQU command, because
     // EQU command breaks loading from history (it duplicate history entries).
     IchAddSzToEquationSz(CCalcEngine::OpCodeToString(IDC_EQU), -1);
@@ -335,6 +383,7 @@ int CHistoryCollector::IchAddSzToEquationSz(wstring_view str, int icommandIndex)
     }
 
     m_spTokens->push_back(std::pair(wstring(str), icommandIndex));
+    TokensChangedFrom(m_spTokens->size() - 1);
     return static_cast<int>(m_spTokens->size() - 1);
 }
 
@@ -342,6 +391,7 @@ int CHistoryCollector::IchAddSzToEquationSz(wstring_view str, int icommandIndex)
 void CHistoryCollector::InsertSzInEquationSz(wstring_view str, int icommandIndex, int ich)
 {
     m_spTokens->emplace(m_spTokens->begin() + ich, wstring(str), icommandIndex);
+    TokensChangedFrom(ich);
 }
 
 // Chops off the current equation string from the given index
@@ -366,15 +416,24 @@ void CHistoryCollector::TruncateEquationSzFromIch(int ich)
     }
 
     Truncate(*m_spTokens, ich);
+    TokensChangedFrom(ich);
 }
 
-// Adds the m_pszEquation into the running history text
+// Adds the m_pszEquation into the running history text. The display is told where the tokens start to differ from the
+// ones it was last sent, so a long expression does not have to be redrawn for every token added to its end.
 void CHistoryCollector::SetExpressionDisplay()
 {
     if (nullptr != m_pCalcDisplay)
     {
-        m_pCalcDisplay->SetExpressionDisplay(m_spTokens, m_spCommands);
+        m_pCalcDisplay->UpdateExpressionDisplay(m_spTokens, m_spCommands, m_firstChangedToken);
     }
+
+    m_firstChangedToken = (m_spTokens != nullptr) ? m_spTokens->size() : 0;
+}
+
+void CHistoryCollector::TokensChangedFrom(size_t ich)
+{
+    m_firstChangedToken = min(m_firstChangedToken, ich);
 }
 
 int CHistoryCollector::AddCommand(_In_ const std::shared_ptr<IExpressionCommand>& spCommand)
@@ -396,8 +455,9 @@ void CHistoryCollector::UpdateHistoryExpression(uint32_t radix, int32_t precisio
         return;
     }
 
-    for (auto& token : *m_spTokens)
+    for (size_t i = 0; i < m_spTokens->size(); i++)
     {
+        auto& token = (*m_spTokens)[i];
         int commandPosition = token.second;
         if (commandPosition != -1)
         {
@@ -408,7 +468,19 @@ void CHistoryCollector::UpdateHistoryExpression(uint32_t radix, int32_t precisio
                 const std::shared_ptr<COpndCommand>& opndCommand = std::static_pointer_cast<COpndCommand>(expCommand);
                 if (opndCommand != nullptr)
                 {
-                    token.first = opndCommand->GetString(radix, precision);
+                    // A string made for these settings before has had the commands set from it already
+                    bool isCached = opndCommand->IsStringCached(radix, precision, m_decimalSymbol);
+                    const wstring& operandString = opndCommand->GetString(radix, precision, m_decimalSymbol);
+                    if (isCached && token.first == operandString)
+                    {
+                        continue;
+                    }
+
+                    if (token.first != operandString)
+                    {
+                        token.first = operandString;
+                        TokensChangedFrom(i);
+                    }
                     opndCommand->SetCommands(GetOperandCommandsFromString(token.first));
                 }
             }
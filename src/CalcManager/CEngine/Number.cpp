@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 
 #include <algorithm>
+#include <utility>
 #include "Header Files/Number.h"
 
 using namespace std;
@@ -8,58 +9,110 @@ using namespace std;
 namespace CalcEngine
 {
     Number::Number() noexcept
-        : Number(1, 0, { 0 })
+        : m_pnum{ _createnum(1) }
     {
+        m_pnum->sign = 1;
+        m_pnum->cdigit = 1;
     }
 
     Number::Number(int32_t sign, int32_t exp, vector<uint32_t> const& mantissa) noexcept
-        : m_sign{ sign }
-        , m_exp{ exp }
-        , m_mantissa{ mantissa }
+        : m_pnum{ _createnum(static_cast<uint32_t>(mantissa.size()) + 1) }
     {
+        m_pnum->sign = sign;
+        m_pnum->exp = exp;
+        m_pnum->cdigit = static_cast<int32_t>(mantissa.size());
+        copy(mantissa.begin(), mantissa.end(), m_pnum->mant);
     }
 
-    Number::Number(PNUMBER p) noexcept
-        : m_sign{ p->sign }
-        , m_exp{ p->exp }
+    Number::Number(Number const& other)
+        : Number(other.m_pnum)
     {
-        m_mantissa.reserve(p->cdigit);
-        copy_n(p->mant, p->cdigit, back_inserter(m_mantissa));
     }
 
-    PNUMBER Number::ToPNUMBER() const
+    Number::Number(Number&& other) noexcept
+        : m_pnum{ other.Release() }
+    {
+    }
+
+    Number& Number::operator=(Number const& other)
     {
-        PNUMBER ret = _createnum(static_cast<uint32_t>(this->Mantissa().size()) + 1);
-        ret->sign = this->Sign();
-        ret->exp = this->Exp();
-        ret->cdigit = static_cast<int32_t>(this->Mantissa().size());
+        if (this != &other)
+        {
+            Number copy{ other };
+            swap(m_pnum, copy.m_pnum);
+        }
+        return *this;
+    }
 
-        MANTTYPE* ptrRet = ret->mant;
-        for (auto const& digit : this->Mantissa())
+    Number& Number::operator=(Number&& other) noexcept
+    {
+        if (this != &other)
         {
-            *ptrRet++ = digit;
+            destroynum(m_pnum);
+            m_pnum = other.Release();
         }
+        return *this;
+    }
+
+    Number::~Number()
+    {
+        destroynum(m_pnum);
+    }
+
+    Number::Number(PNUMBER p) noexcept
+        : m_pnum{ _createnum(p->cdigit + 1) }
+    {
+        _dupnum(m_pnum, p);
+    }
+
+    Number::Number(Adopted, PNUMBER p) noexcept
+        : m_pnum{ p }
+    {
+    }
+
+    PNUMBER Number::ToPNUMBER() const
+    {
+        PNUMBER ret = _createnum(m_pnum->cdigit + 1);
+        _dupnum(ret, m_pnum);
+        return ret;
+    }
+
+    Number Number::Adopt(PNUMBER p) noexcept
+    {
+        // Anything still in a ScratchArena would be freed along with it.
+        detachnum(&p);
+        return Number{ Adopted{}, p };
+    }
 
+    PNUMBER Number::Release() noexcept
+    {
+        PNUMBER ret = m_pnum;
+        m_pnum = nullptr;
         return ret;
     }
 
+    PNUMBER Number::Lend() const noexcept
+    {
+        return m_pnum;
+    }
+
     int32_t const& Number::Sign() const
     {
-        return m_sign;
+        return m_pnum->sign;
     }
 
     int32_t const& Number::Exp() const
     {
-        return m_exp;
+        return m_pnum->exp;
     }
 
-    vector<uint32_t> const& Number::Mantissa() const
+    vector<uint32_t> Number::Mantissa() const
     {
-        return m_mantissa;
+        return vector<uint32_t>(m_pnum->mant, m_pnum->mant + m_pnum->cdigit);
     }
 
     bool Number::IsZero() const
     {
-        return all_of(m_mantissa.begin(), m_mantissa.end(), [](auto&& i) { return i == 0; });
+        return all_of(m_pnum->mant, m_pnum->mant + m_pnum->cdigit, [](auto&& i) { return i == 0; });
     }
 }
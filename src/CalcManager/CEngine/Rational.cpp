@@ -1,14 +1,290 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 
+#include <algorithm>
+#include <utility>
 #include "Header Files/Rational.h"
 
 using namespace std;
 
 namespace CalcEngine
 {
+    namespace
+    {
+        // Most rationals the engine sees are small integers and short decimals,
+        // whose p and q each fit in 64 bits. Those are added, multiplied, divided
+        // and compared here without going through ratpak, and anything that would
+        // outgrow 64 bits falls back to it. A sign is kept apart from each
+        // magnitude the way a NUMBER keeps it, and every step below follows its
+        // ratpak counterpart, so the results are the same rationals ratpak gives,
+        // down to the sign left on a zero.
+        struct SmallNumber
+        {
+            int32_t sign;
+            uint64_t mag;
+        };
+
+        struct SmallRational
+        {
+            SmallNumber p;
+            SmallNumber q;
+        };
+
+        bool TryGetSmall(Number const& n, SmallNumber& small)
+        {
+            PNUMBER pnum = n.Lend();
+            if (pnum->exp != 0 || pnum->cdigit > 2)
+            {
+                return false;
+            }
+
+            small.sign = pnum->sign;
+            small.mag = pnum->mant[0];
+            if (pnum->cdigit == 2)
+            {
+                small.mag |= static_cast<uint64_t>(pnum->mant[1]) << BASEXPWR;
+            }
+            return true;
+        }
+
+        bool TryGetSmall(Rational const& r, SmallRational& small)
+        {
+            return TryGetSmall(r.P(), small.p) && TryGetSmall(r.Q(), small.q);
+        }
+
+        Number ToNumber(SmallNumber const& small)
+        {
+            PNUMBER pnum = _createnum(2);
+            pnum->sign = small.sign;
+            pnum->mant[0] = static_cast<MANTTYPE>(small.mag);
+            pnum->mant[1] = static_cast<MANTTYPE>(small.mag >> BASEXPWR);
+            pnum->cdigit = (pnum->mant[1] == 0) ? 1 : 2;
+            return Number::Adopt(pnum);
+        }
+
+        Rational ToRational(SmallRational const& small)
+        {
+            return Rational{ ToNumber(small.p), ToNumber(small.q) };
+        }
+
+        int32_t BitLength(uint64_t mag)
+        {
+            int32_t length = 0;
+            for (; mag != 0; mag >>= 1)
+            {
+                length++;
+            }
+            return length;
+        }
+
+        int32_t BitLength(PNUMBER pnum)
+        {
+            int32_t cdigit = pnum->cdigit;
+            while (cdigit > 1 && pnum->mant[cdigit - 1] == 0)
+            {
+                cdigit--;
+            }
+            return (cdigit - 1 + pnum->exp) * BASEXPWR + BitLength(pnum->mant[cdigit - 1]);
+        }
+
+        // mulnumx, fails if the product needs more than 64 bits.
+        bool MulSmall(SmallNumber const& a, SmallNumber const& b, SmallNumber& result)
+        {
+            if (((a.mag | b.mag) >> BASEXPWR) != 0 && a.mag != 0 && b.mag > UINT64_MAX / a.mag)
+            {
+                return false;
+            }
+            result = { a.sign * b.sign, a.mag * b.mag };
+            return true;
+        }
+
+        // addnum, fails if the sum needs more than 64 bits.
+        bool AddSmall(SmallNumber const& a, SmallNumber const& b, SmallNumber& result)
+        {
+            if (b.mag == 0)
+            {
+                result = a;
+            }
+            else if (a.mag == 0)
+            {
+                result = b;
+            }
+            else if (a.sign == b.sign)
+            {
+                if (a.mag > UINT64_MAX - b.mag)
+                {
+                    return false;
+                }
+                result = { a.sign, a.mag + b.mag };
+            }
+            else if (a.mag == b.mag)
+            {
+                result = { 1, 0 };
+            }
+            else if (a.mag > b.mag)
+            {
+                result = { a.sign, a.mag - b.mag };
+            }
+            else
+            {
+                result = { b.sign, b.mag - a.mag };
+            }
+            return true;
+        }
+
+        // _addrat
+        bool AddSmall(SmallRational a, SmallRational b, SmallRational& result)
+        {
+            if (a.q.mag == b.q.mag)
+            {
+                a.p.sign *= a.q.sign;
+                b.p.sign *= b.q.sign;
+                result.q = { 1, a.q.mag };
+                return AddSmall(a.p, b.p, result.p);
+            }
+
+            SmallNumber bottom;
+            SmallNumber left;
+            SmallNumber right;
+            if (!MulSmall(a.q, b.q, bottom) || !MulSmall(a.p, b.q, left) || !MulSmall(a.q, b.p, right) || !AddSmall(left, right, result.p))
+            {
+                return false;
+            }
+            result.p.sign *= bottom.sign;
+            result.q = { 1, bottom.mag };
+            return true;
+        }
+
+        // _snaprat, a sum that vanishes next to its operands becomes zero. Fails
+        // when that can't be ruled out from the bit lengths alone.
+        bool SnapSmall(SmallRational const& a, SmallRational const& b, SmallRational& result)
+        {
+            if (result.p.mag == 0)
+            {
+                if (a.p.mag != 0 || b.p.mag != 0)
+                {
+                    result = { { 1, 0 }, { 1, 1 } };
+                }
+                return true;
+            }
+
+            if (rat_smallest == nullptr)
+            {
+                return false;
+            }
+
+            // The sum is at least 2^(result bits - 1), the threshold is below
+            // 2^(operand bits + smallest bits) counting one bit of slack in each.
+            int32_t operandBits = max(BitLength(a.p.mag) - BitLength(a.q.mag), BitLength(b.p.mag) - BitLength(b.q.mag)) + 1;
+            int32_t smallestBits = BitLength(rat_smallest->pp) - BitLength(rat_smallest->pq) + 1;
+            return BitLength(result.p.mag) - BitLength(result.q.mag) - 1 >= operandBits + smallestBits;
+        }
+
+        // addrat and subrat
+        bool AddSmall(Rational const& lhs, Rational const& rhs, int32_t rhsSign, Rational& result)
+        {
+            SmallRational a;
+            SmallRational b;
+            SmallRational sum;
+            if (!TryGetSmall(lhs, a) || !TryGetSmall(rhs, b))
+            {
+                return false;
+            }
+
+            SmallRational negated = b;
+            negated.p.sign *= rhsSign;
+            if (!AddSmall(a, negated, sum) || !SnapSmall(a, b, sum))
+            {
+                return false;
+            }
+            result = ToRational(sum);
+            return true;
+        }
+
+        // mulrat
+        bool MulSmall(Rational const& lhs, Rational const& rhs, Rational& result)
+        {
+            SmallRational a;
+            SmallRational b;
+            SmallRational product;
+            if (!TryGetSmall(lhs, a) || !TryGetSmall(rhs, b))
+            {
+                return false;
+            }
+
+            if (a.p.mag == 0)
+            {
+                product = { a.p, { 1, 1 } };
+            }
+            else if (!MulSmall(a.p, b.p, product.p) || !MulSmall(a.q, b.q, product.q))
+            {
+                return false;
+            }
+            result = ToRational(product);
+            return true;
+        }
+
+        // divrat
+        bool DivSmall(Rational const& lhs, Rational const& rhs, Rational& result)
+        {
+            SmallRational a;
+            SmallRational b;
+            SmallRational quotient;
+            if (!TryGetSmall(lhs, a) || !TryGetSmall(rhs, b))
+            {
+                return false;
+            }
+
+            if (a.p.mag == 0)
+            {
+                if (b.p.mag == 0)
+                {
+                    throw(CALC_E_INDEFINITE);
+                }
+                quotient = { a.p, { 1, 1 } };
+            }
+            else
+            {
+                if (!MulSmall(a.q, b.p, quotient.q))
+                {
+                    return false;
+                }
+                if (quotient.q.mag == 0)
+                {
+                    throw(CALC_E_DIVIDEBYZERO);
+                }
+                if (!MulSmall(a.p, b.q, quotient.p))
+                {
+                    return false;
+                }
+            }
+            result = ToRational(quotient);
+            return true;
+        }
+
+        // rat_equ and rat_lt, the sign of lhs - rhs as found by _addrat.
+        bool CompareSmall(Rational const& lhs, Rational const& rhs, int32_t& order)
+        {
+            SmallRational a;
+            SmallRational b;
+            SmallRational difference;
+            if (!TryGetSmall(lhs, a) || !TryGetSmall(rhs, b))
+            {
+                return false;
+            }
+
+            b.p.sign *= -1;
+            if (!AddSmall(a, b, difference))
+            {
+                return false;
+            }
+            order = (difference.p.mag == 0) ? 0 : difference.p.sign * difference.q.sign;
+            return true;
+        }
+    }
+
     Rational::Rational() noexcept
         : m_p{}
-        , m_q{ 1, 0, { 1 } }
+        , m_q{ ToNumber(SmallNumber{ 1, 1 }) }
     {
     }
 
@@ -20,45 +296,36 @@ namespace CalcEngine
             qExp -= n.Exp();
         }
 
-        m_p = Number(n.Sign(), 0, n.Mantissa());
+        PNUMBER p = n.ToPNUMBER();
+        p->exp = 0;
+        m_p = Number::Adopt(p);
         m_q = Number(1, qExp, { 1 });
     }
 
-    Rational::Rational(Number const& p, Number const& q) noexcept
-        : m_p{ p }
-        , m_q{ q }
+    Rational::Rational(Number p, Number q) noexcept
+        : m_p{ move(p) }
+        , m_q{ move(q) }
     {
     }
 
+    // The integer constructors build the same p and q as i32torat and
+    // Ui32torat without the round trip through a PRAT.
     Rational::Rational(int32_t i)
+        : m_p{ ToNumber(SmallNumber{ i < 0 ? -1 : 1, i < 0 ? 0u - static_cast<uint32_t>(i) : static_cast<uint32_t>(i) }) }
+        , m_q{ ToNumber(SmallNumber{ 1, 1 }) }
     {
-        PRAT pr = i32torat(static_cast<int32_t>(i));
-
-        m_p = Number{ pr->pp };
-        m_q = Number{ pr->pq };
-
-        destroyrat(pr);
     }
 
     Rational::Rational(uint32_t ui)
+        : m_p{ ToNumber(SmallNumber{ 1, ui }) }
+        , m_q{ ToNumber(SmallNumber{ 1, 1 }) }
     {
-        PRAT pr = Ui32torat(static_cast<uint32_t>(ui));
-
-        m_p = Number{ pr->pp };
-        m_q = Number{ pr->pq };
-
-        destroyrat(pr);
     }
 
     Rational::Rational(uint64_t ui)
+        : m_p{ ToNumber(SmallNumber{ 1, ui }) }
+        , m_q{ ToNumber(SmallNumber{ 1, 1 }) }
     {
-        uint32_t hi = (uint32_t)(((ui) >> 32) & 0xffffffff);
-        uint32_t lo = (uint32_t)ui;
-
-        Rational temp = (Rational{ hi } << 32) | lo;
-
-        m_p = Number{ temp.P() };
-        m_q = Number{ temp.Q() };
     }
 
     Rational::Rational(PRAT prat) noexcept
@@ -77,6 +344,26 @@ namespace CalcEngine
         return ret;
     }
 
+    PRAT Rational::Release()
+    {
+        PRAT ret = _createrat();
+
+        ret->pp = m_p.Release();
+        ret->pq = m_q.Release();
+
+        return ret;
+    }
+
+    void Rational::Adopt(PRAT& prat) noexcept
+    {
+        m_p = Number::Adopt(prat->pp);
+        m_q = Number::Adopt(prat->pq);
+
+        prat->pp = nullptr;
+        prat->pq = nullptr;
+        destroyrat(prat);
+    }
+
     Number const& Rational::P() const
     {
         return m_p;
@@ -89,13 +376,22 @@ namespace CalcEngine
 
     Rational Rational::operator-() const
     {
-        return Rational{ Number{ -1 * m_p.Sign(), m_p.Exp(), m_p.Mantissa() }, m_q };
+        PNUMBER p = m_p.ToPNUMBER();
+        p->sign *= -1;
+
+        return Rational{ Number::Adopt(p), m_q };
     }
 
     Rational& Rational::operator+=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
+        if (AddSmall(*this, rhs, 1, *this))
+        {
+            return *this;
+        }
+
+        // ratpak writes to the sign of rhs while it works, so rhs is copied.
         PRAT rhsRat = rhs.ToPRAT();
+        PRAT lhsRat = this->Release();
 
         try
         {
@@ -106,19 +402,25 @@ namespace CalcEngine
         {
             destroyrat(lhsRat);
             destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator-=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
+        if (AddSmall(*this, rhs, -1, *this))
+        {
+            return *this;
+        }
+
+        // ratpak writes to the sign of rhs while it works, so rhs is copied.
         PRAT rhsRat = rhs.ToPRAT();
+        PRAT lhsRat = this->Release();
 
         try
         {
@@ -129,57 +431,73 @@ namespace CalcEngine
         {
             destroyrat(lhsRat);
             destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator*=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (MulSmall(*this, rhs, *this))
+        {
+            return *this;
+        }
+
+        if (&rhs == this)
+        {
+            return *this *= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            mulrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            mulrat(&lhsRat, &rhsRat, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator/=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (DivSmall(*this, rhs, *this))
+        {
+            return *this;
+        }
+
+        if (&rhs == this)
+        {
+            return *this /= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            divrat(&lhsRat, rhsRat, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            divrat(&lhsRat, &rhsRat, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
@@ -193,136 +511,156 @@ namespace CalcEngine
     /// </remarks>
     Rational& Rational::operator%=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this %= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            remrat(&lhsRat, rhsRat);
-            destroyrat(rhsRat);
+            remrat(&lhsRat, &rhsRat);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator<<=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this <<= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            lshrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            lshrat(&lhsRat, &rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator>>=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this >>= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            rshrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            rshrat(&lhsRat, &rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator&=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this &= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
 
         try
         {
-            andrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            andrat(&lhsRat, &rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator|=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this |= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
+
         try
         {
-            orrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            orrat(&lhsRat, &rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
 
     Rational& Rational::operator^=(Rational const& rhs)
     {
-        PRAT lhsRat = this->ToPRAT();
-        PRAT rhsRat = rhs.ToPRAT();
+        if (&rhs == this)
+        {
+            return *this ^= Rational{ rhs };
+        }
+
+        RAT rhsRat{ rhs.m_p.Lend(), rhs.m_q.Lend() };
+        PRAT lhsRat = this->Release();
+
         try
         {
-            xorrat(&lhsRat, rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
-            destroyrat(rhsRat);
+            xorrat(&lhsRat, &rhsRat, RATIONAL_BASE, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
             destroyrat(lhsRat);
-            destroyrat(rhsRat);
+            *this = Rational{};
             throw(error);
         }
 
-        *this = Rational{ lhsRat };
-        destroyrat(lhsRat);
+        this->Adopt(lhsRat);
 
         return *this;
     }
@@ -396,22 +734,27 @@ namespace CalcEngine
 
     bool operator==(Rational const& lhs, Rational const& rhs)
     {
-        PRAT lhsRat = lhs.ToPRAT();
+        int32_t order = 0;
+        if (CompareSmall(lhs, rhs, order))
+        {
+            return order == 0;
+        }
+
+        // ratpak writes to the sign of rhs while it compares, so only lhs is lent.
+        RAT lhsRat{ lhs.m_p.Lend(), lhs.m_q.Lend() };
         PRAT rhsRat = rhs.ToPRAT();
 
         bool result = false;
         try
         {
-            result = rat_equ(lhsRat, rhsRat, RATIONAL_PRECISION);
+            result = rat_equ(&lhsRat, rhsRat, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
-            destroyrat(lhsRat);
             destroyrat(rhsRat);
             throw(error);
         }
 
-        destroyrat(lhsRat);
         destroyrat(rhsRat);
 
         return result;
@@ -424,22 +767,27 @@ namespace CalcEngine
 
     bool operator<(Rational const& lhs, Rational const& rhs)
     {
-        PRAT lhsRat = lhs.ToPRAT();
+        int32_t order = 0;
+        if (CompareSmall(lhs, rhs, order))
+        {
+            return order < 0;
+        }
+
+        // ratpak writes to the sign of rhs while it compares, so only lhs is lent.
+        RAT lhsRat{ lhs.m_p.Lend(), lhs.m_q.Lend() };
         PRAT rhsRat = rhs.ToPRAT();
 
         bool result = false;
         try
         {
-            result = rat_lt(lhsRat, rhsRat, RATIONAL_PRECISION);
+            result = rat_lt(&lhsRat, rhsRat, RATIONAL_PRECISION);
         }
         catch (uint32_t error)
         {
-            destroyrat(lhsRat);
             destroyrat(rhsRat);
             throw(error);
         }
 
-        destroyrat(lhsRat);
         destroyrat(rhsRat);
 
         return result;
@@ -462,40 +810,16 @@ namespace CalcEngine
 
     wstring Rational::ToString(uint32_t radix, NumberFormat fmt, int32_t precision) const
     {
-        PRAT rat = this->ToPRAT();
-        wstring result{};
+        RAT lent{ m_p.Lend(), m_q.Lend() };
+        PRAT rat = &lent;
 
-        try
-        {
-            result = RatToString(rat, fmt, radix, precision);
-        }
-        catch (uint32_t error)
-        {
-            destroyrat(rat);
-            throw(error);
-        }
-
-        destroyrat(rat);
-
-        return result;
+        return RatToString(rat, fmt, radix, precision);
     }
 
     uint64_t Rational::ToUInt64_t() const
     {
-        PRAT rat = this->ToPRAT();
-        uint64_t result;
-        try
-        {
-            result = rattoUi64(rat, RATIONAL_BASE, RATIONAL_PRECISION);
-        }
-        catch (uint32_t error)
-        {
-            destroyrat(rat);
-            throw(error);
-        }
+        RAT lent{ m_p.Lend(), m_q.Lend() };
 
-        destroyrat(rat);
-
-        return result;
+        return rattoUi64(&lent, RATIONAL_BASE, RATIONAL_PRECISION);
     }
 }
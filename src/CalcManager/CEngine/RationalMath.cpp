@@ -1,11 +1,229 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include "Header Files/RationalMath.h"
 
 using namespace std;
 using namespace CalcEngine;
 
+namespace
+{
+    enum class Function
+    {
+        Pow,
+        Fact,
+        Exp,
+        Log,
+        Sin,
+        Cos,
+        Tan,
+        ASin,
+        ACos,
+        ATan,
+        Sinh,
+        Cosh,
+        Tanh,
+        ASinh,
+        ACosh,
+        ATanh
+    };
+
+    // Looking through this many costs next to nothing beside even the cheapest of the functions.
+    constexpr size_t MAX_CACHED_RESULTS = 64;
+
+    void HashValue(uint64_t& hash, uint32_t value)
+    {
+        hash = (hash ^ value) * 0x100000001B3ull;
+    }
+
+    void HashNumber(uint64_t& hash, PNUMBER pnum)
+    {
+        HashValue(hash, static_cast<uint32_t>(pnum->sign));
+        HashValue(hash, static_cast<uint32_t>(pnum->exp));
+        HashValue(hash, static_cast<uint32_t>(pnum->cdigit));
+        for (int32_t i = 0; i < pnum->cdigit; i++)
+        {
+            HashValue(hash, pnum->mant[i]);
+        }
+    }
+
+    // Equal digit for digit, rather than in value, as ratpak need not come to the same result for 1/2 and 2/4.
+    bool AreSameNumber(PNUMBER a, PNUMBER b)
+    {
+        return a->sign == b->sign && a->exp == b->exp && a->cdigit == b->cdigit && equal(a->mant, a->mant + a->cdigit, b->mant);
+    }
+
+    bool AreSameRational(Rational const& a, Rational const& b)
+    {
+        return AreSameNumber(a.P().Lend(), b.P().Lend()) && AreSameNumber(a.Q().Lend(), b.Q().Lend());
+    }
+
+    class ResultCache
+    {
+    public:
+        struct Entry
+        {
+            uint64_t hash;
+            Function function;
+            AngleType angleType;
+            uint32_t radix;
+            int32_t precision;
+            bool hasY;
+            Rational x;
+            Rational y;
+            Rational result;
+            uint64_t lastUse;
+        };
+
+        static ResultCache& ForThisThread()
+        {
+            // Made on first use, after ratpak has set the thread up, so it is gone again before ratpak cleans up.
+            thread_local ResultCache cache;
+            return cache;
+        }
+
+        ResultCache()
+            : m_generation(g_constantsgeneration)
+            , m_useCount(0)
+            , m_statistics{}
+        {
+        }
+
+        // Empties the cache if the constants its results were worked out with could have changed.
+        void Validate()
+        {
+            if (m_generation != g_constantsgeneration)
+            {
+                if (!m_entries.empty())
+                {
+                    m_entries.clear();
+                    m_statistics.invalidations++;
+                }
+                m_generation = g_constantsgeneration;
+            }
+        }
+
+        template <typename Match>
+        Rational const* Find(uint64_t hash, Match const& match)
+        {
+            for (auto& entry : m_entries)
+            {
+                if (entry.hash == hash && match(entry))
+                {
+                    entry.lastUse = ++m_useCount;
+                    m_statistics.hits++;
+                    return &entry.result;
+                }
+            }
+
+            m_statistics.misses++;
+            return nullptr;
+        }
+
+        void Add(Entry&& entry)
+        {
+            entry.lastUse = ++m_useCount;
+            if (m_entries.size() < MAX_CACHED_RESULTS)
+            {
+                m_entries.push_back(move(entry));
+                return;
+            }
+
+            auto leastRecentlyUsed = min_element(m_entries.begin(), m_entries.end(), [](Entry const& a, Entry const& b) { return a.lastUse < b.lastUse; });
+            *leastRecentlyUsed = move(entry);
+            m_statistics.evictions++;
+        }
+
+        RationalMath::ResultCacheStatistics GetStatistics() const
+        {
+            RationalMath::ResultCacheStatistics statistics = m_statistics;
+            statistics.size = m_entries.size();
+            return statistics;
+        }
+
+        void Clear()
+        {
+            m_entries.clear();
+            m_statistics = {};
+        }
+
+    private:
+        vector<Entry> m_entries;
+        uint32_t m_generation;
+        uint64_t m_useCount;
+        RationalMath::ResultCacheStatistics m_statistics;
+    };
+
+    // One call to a function whose result is worth keeping, looked up before it is worked out and remembered after.
+    class MemoizedCall
+    {
+    public:
+        MemoizedCall(Function function, Rational const& x, Rational const* y = nullptr, AngleType angleType = AngleType::Radians)
+            : m_cache(ResultCache::ForThisThread())
+            , m_function(function)
+            , m_angleType(angleType)
+            , m_x(x)
+            , m_y(y)
+            , m_hash(0xCBF29CE484222325ull)
+        {
+            HashValue(m_hash, static_cast<uint32_t>(function));
+            HashValue(m_hash, static_cast<uint32_t>(angleType));
+            HashValue(m_hash, g_constantsradix);
+            HashValue(m_hash, static_cast<uint32_t>(g_constantsprecision));
+            HashNumber(m_hash, x.P().Lend());
+            HashNumber(m_hash, x.Q().Lend());
+            if (y != nullptr)
+            {
+                HashNumber(m_hash, y->P().Lend());
+                HashNumber(m_hash, y->Q().Lend());
+            }
+        }
+
+        Rational const* Find()
+        {
+            m_cache.Validate();
+            return m_cache.Find(m_hash, [this](ResultCache::Entry const& entry) {
+                return entry.function == m_function && entry.angleType == m_angleType && entry.radix == g_constantsradix
+                       && entry.precision == g_constantsprecision && entry.hasY == (m_y != nullptr) && AreSameRational(entry.x, m_x)
+                       && (m_y == nullptr || AreSameRational(entry.y, *m_y));
+            });
+        }
+
+        void Remember(Rational const& result)
+        {
+            m_cache.Add({ m_hash,
+                          m_function,
+                          m_angleType,
+                          g_constantsradix,
+                          g_constantsprecision,
+                          m_y != nullptr,
+                          m_x,
+                          m_y != nullptr ? *m_y : Rational{},
+                          result,
+                          0 });
+        }
+
+    private:
+        ResultCache& m_cache;
+        Function m_function;
+        AngleType m_angleType;
+        Rational const& m_x;
+        Rational const* m_y;
+        uint64_t m_hash;
+    };
+}
+
+RationalMath::ResultCacheStatistics RationalMath::GetResultCacheStatistics()
+{
+    return ResultCache::ForThisThread().GetStatistics();
+}
+
+void RationalMath::ClearResultCache()
+{
+    ResultCache::ForThisThread().Clear();
+}
+
 Rational RationalMath::Frac(Rational const& rat)
 {
     PRAT prat = rat.ToPRAT();
@@ -46,6 +264,12 @@ Rational RationalMath::Integer(Rational const& rat)
 
 Rational RationalMath::Pow(Rational const& base, Rational const& pow)
 {
+    MemoizedCall call{ Function::Pow, base, &pow };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT baseRat = base.ToPRAT();
     PRAT powRat = pow.ToPRAT();
 
@@ -64,6 +288,7 @@ Rational RationalMath::Pow(Rational const& base, Rational const& pow)
     Rational result{ baseRat };
     destroyrat(baseRat);
 
+    call.Remember(result);
     return result;
 }
 
@@ -74,6 +299,12 @@ Rational RationalMath::Root(Rational const& base, Rational const& root)
 
 Rational RationalMath::Fact(Rational const& rat)
 {
+    MemoizedCall call{ Function::Fact, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -89,11 +320,18 @@ Rational RationalMath::Fact(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Exp(Rational const& rat)
 {
+    MemoizedCall call{ Function::Exp, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -109,11 +347,18 @@ Rational RationalMath::Exp(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Log(Rational const& rat)
 {
+    MemoizedCall call{ Function::Log, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -129,6 +374,7 @@ Rational RationalMath::Log(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
@@ -149,6 +395,12 @@ Rational RationalMath::Abs(Rational const& rat)
 
 Rational RationalMath::Sin(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::Sin, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -164,11 +416,18 @@ Rational RationalMath::Sin(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Cos(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::Cos, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -184,11 +443,18 @@ Rational RationalMath::Cos(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Tan(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::Tan, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -204,11 +470,18 @@ Rational RationalMath::Tan(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ASin(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::ASin, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -224,11 +497,18 @@ Rational RationalMath::ASin(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ACos(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::ACos, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -244,11 +524,18 @@ Rational RationalMath::ACos(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ATan(Rational const& rat, AngleType angletype)
 {
+    MemoizedCall call{ Function::ATan, rat, nullptr, angletype };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -264,11 +551,18 @@ Rational RationalMath::ATan(Rational const& rat, AngleType angletype)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Sinh(Rational const& rat)
 {
+    MemoizedCall call{ Function::Sinh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -284,11 +578,18 @@ Rational RationalMath::Sinh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Cosh(Rational const& rat)
 {
+    MemoizedCall call{ Function::Cosh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -304,11 +605,18 @@ Rational RationalMath::Cosh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::Tanh(Rational const& rat)
 {
+    MemoizedCall call{ Function::Tanh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -324,11 +632,18 @@ Rational RationalMath::Tanh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ASinh(Rational const& rat)
 {
+    MemoizedCall call{ Function::ASinh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -344,11 +659,18 @@ Rational RationalMath::ASinh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ACosh(Rational const& rat)
 {
+    MemoizedCall call{ Function::ACosh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -364,11 +686,18 @@ Rational RationalMath::ACosh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
 Rational RationalMath::ATanh(Rational const& rat)
 {
+    MemoizedCall call{ Function::ATanh, rat };
+    if (Rational const* cached = call.Find())
+    {
+        return *cached;
+    }
+
     PRAT prat = rat.ToPRAT();
 
     try
@@ -384,6 +713,7 @@ Rational RationalMath::ATanh(Rational const& rat)
     Rational result{ prat };
     destroyrat(prat);
 
+    call.Remember(result);
     return result;
 }
 
@@ -24,20 +24,62 @@ static constexpr wstring_view DEFAULT_NUMBER_STR = L"0";
 // Read strings for keys, errors, trig types, etc.
 // These will be copied from the resources to local memory.
 
-unordered_map<wstring_view, wstring> CCalcEngine::s_engineStrings;
+atomic<CCalcEngine::EngineStringTable const*> CCalcEngine::s_engineStrings{ nullptr };
+thread_local CCalcEngine::EngineStringTable const* CCalcEngine::t_threadEngineStrings = nullptr;
+mutex CCalcEngine::s_engineStringsMutex;
+vector<unique_ptr<CCalcEngine::EngineStringTable const>> CCalcEngine::s_engineStringTables;
 
-void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider)
+namespace
 {
-    for (const auto& sid : g_sids)
+    void AddEngineStrings(CalculationManager::IResourceProvider& resourceProvider, CCalcEngine::EngineStringTable& strings)
     {
-        auto locString = resourceProvider.GetCEngineString(sid);
-        if (!locString.empty())
+        for (const auto& sid : g_sids)
         {
-            s_engineStrings[sid] = locString;
+            auto locString = resourceProvider.GetCEngineString(sid);
+            if (!locString.empty())
+            {
+                strings[sid] = locString;
+            }
         }
     }
 }
 
+void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider)
+{
+    lock_guard<mutex> lock(s_engineStringsMutex);
+
+    // Engines on other threads may be reading the current table, so the strings go into a copy of it.
+    EngineStringTable const* current = s_engineStrings.load(memory_order_relaxed);
+    auto strings = current != nullptr ? make_unique<EngineStringTable>(*current) : make_unique<EngineStringTable>();
+    AddEngineStrings(resourceProvider, *strings);
+    if (current == nullptr || *strings != *current)
+    {
+        PublishEngineStrings(move(strings));
+    }
+}
+
+// Called with s_engineStringsMutex held.
+void CCalcEngine::PublishEngineStrings(unique_ptr<EngineStringTable const> strings)
+{
+    s_engineStrings.store(strings.get(), memory_order_release);
+    s_engineStringTables.push_back(move(strings));
+}
+
+unique_ptr<CCalcEngine::EngineStringTable const> CCalcEngine::CreateEngineStrings(CalculationManager::IResourceProvider& resourceProvider)
+{
+    auto strings = make_unique<EngineStringTable>();
+    AddEngineStrings(resourceProvider, *strings);
+
+    // As SettingsChanged would put it in for an engine made with this provider
+    wstring decStr = resourceProvider.GetCEngineString(L"sDecimal");
+    if (!decStr.empty() && decStr.at(0) != DEFAULT_DEC_SEPARATOR)
+    {
+        (*strings)[SIDS_DECIMAL_SEPARATOR] = decStr.at(0);
+    }
+
+    return strings;
+}
+
 //////////////////////////////////////////////////
 //
 // InitialOneTimeOnlyNumberSetup
@@ -46,7 +88,16 @@ void CCalcEngine::LoadEngineStrings(CalculationManager::IResourceProvider& resou
 void CCalcEngine::InitialOneTimeOnlySetup(CalculationManager::IResourceProvider& resourceProvider)
 {
     LoadEngineStrings(resourceProvider);
+    InitialThreadSetup();
+}
 
+//////////////////////////////////////////////////
+//
+// InitialThreadSetup
+//
+//////////////////////////////////////////////////
+void CCalcEngine::InitialThreadSetup()
+{
     // we must now set up all the ratpak constants and our arrayed pointers
     // to these constants.
     ChangeBaseConstants(DEFAULT_RADIX, DEFAULT_MAX_DIGITS, DEFAULT_PRECISION);
@@ -81,6 +132,7 @@ CCalcEngine::CCalcEngine(
     , m_parenVals{}
     , m_precedenceVals{}
     , m_bError(false)
+    , m_nErrorCode(0)
     , m_bInv(false)
     , m_bNoPrevEqu(true)
     , m_radix(DEFAULT_RADIX)
@@ -97,6 +149,7 @@ CCalcEngine::CCalcEngine(
     , m_angletype(AngleType::Degrees)
     , m_numwidth(NUM_WIDTH::QWORD_WIDTH)
     , m_HistoryCollector(pCalcDisplay, pHistoryDisplay, DEFAULT_DEC_SEPARATOR)
+    , m_decimalSeparator(DEFAULT_DEC_SEPARATOR)
     , m_groupSeparator(DEFAULT_GRP_SEPARATOR)
 {
     InitChopNumbers();
@@ -185,8 +238,20 @@ void CCalcEngine::SettingsChanged()
         m_input.SetDecimalSymbol(m_decimalSeparator);
         m_HistoryCollector.SetDecimalSymbol(m_decimalSeparator);
 
-        // put the new decimal symbol into the table used to draw the decimal key
-        s_engineStrings[SIDS_DECIMAL_SEPARATOR] = m_decimalSeparator;
+        // put the new decimal symbol into the table used to draw the decimal key, unless the thread has a table of
+        // its own, which CreateEngineStrings already put it in
+        if (t_threadEngineStrings == nullptr)
+        {
+            lock_guard<mutex> lock(s_engineStringsMutex);
+            EngineStringTable const* current = s_engineStrings.load(memory_order_relaxed);
+            wstring decimal(1, m_decimalSeparator);
+            if (current == nullptr || GetString(SIDS_DECIMAL_SEPARATOR) != decimal)
+            {
+                auto strings = current != nullptr ? make_unique<EngineStringTable>(*current) : make_unique<EngineStringTable>();
+                (*strings)[SIDS_DECIMAL_SEPARATOR] = decimal;
+                PublishEngineStrings(move(strings));
+            }
+        }
 
         // we need to redraw to update the decimal point button
         numChanged = true;
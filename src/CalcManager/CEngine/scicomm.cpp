@@ -563,7 +563,7 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
         if ((m_openParenCount >= MAXPRECDEPTH && (wParam == IDC_OPENP)) || (!m_openParenCount && (wParam != IDC_OPENP))
             || ((m_precedenceOpCount >= MAXPRECDEPTH && m_nPrecOp[m_precedenceOpCount - 1] != 0)))
         {
-            if (!m_openParenCount && (wParam != IDC_OPENP))
+            if (!m_openParenCount && (wParam != IDC_OPENP) && nullptr != m_pCalcDisplay)
             {
                 m_pCalcDisplay->OnNoRightParenAdded();
             }
@@ -622,8 +622,9 @@ void CCalcEngine::ProcessCommandWorker(OpCode wParam)
             m_currentVal = DoOperation(m_nOpCode, m_currentVal, m_lastVal);
             m_nPrevOpCode = m_nOpCode;
 
-            // Now process the precedence stack till we get to an opcode which is zero.
-            for (m_nOpCode = m_nPrecOp[--m_precedenceOpCount]; m_nOpCode; m_nOpCode = m_nPrecOp[--m_precedenceOpCount])
+            // Now process the precedence stack till we get to an opcode which is zero. A digit typed straight after a
+            // ) clears the whole stack, markers included, so it may run out before that.
+            while (m_precedenceOpCount > 0 && (m_nOpCode = m_nPrecOp[--m_precedenceOpCount]) != 0)
             {
                 // Precedence Inversion check
                 int ni = NPrecedenceOfOp(m_nPrevOpCode);
@@ -1158,6 +1159,40 @@ wstring CCalcEngine::GetCurrentResultForRadix(uint32_t radix, int32_t precision,
     }
 }
 
+// Same as GetCurrentResultForRadix for each of radixes, but the constants are switched to precision only once.
+vector<RadixResult> CCalcEngine::GetCurrentResultsForRadixes(vector<uint32_t> const& radixes, int32_t precision)
+{
+    Rational rat = (m_bRecord ? m_input.ToRational(m_radix, m_precision) : m_currentVal);
+
+    ChangeConstants(m_radix, precision);
+
+    // In Programmer mode the value is a word, which can be written out without going through ratpak.
+    FixedWidthInteger word;
+    bool isWord = m_fIntegerMode && (m_nFE == NumberFormat::Float) && FixedWidthInteger::TryFromRational(TruncateNumForIntMath(rat), m_dwWordBitWidth, word);
+
+    vector<RadixResult> results;
+    results.reserve(radixes.size());
+    for (uint32_t radix : radixes)
+    {
+        wstring numberString = isWord ? word.ToString(radix) : wstring{};
+
+        // Past m_precision digits ratpak switches to scientific notation, leave that to it.
+        size_t digitCount = numberString.length() - ((!numberString.empty() && numberString[0] == L'-') ? 1 : 0);
+        if (numberString.empty() || digitCount > static_cast<size_t>(m_precision))
+        {
+            numberString = GetStringForDisplay(rat, radix);
+        }
+
+        wstring groupedString = GroupDigitsPerRadix(numberString, radix);
+        results.push_back({ radix, move(numberString), move(groupedString) });
+    }
+
+    // Revert the precision to previously stored precision
+    ChangeConstants(m_radix, m_precision);
+
+    return results;
+}
+
 wstring CCalcEngine::GetStringForDisplay(Rational const& rat, uint32_t radix)
 {
     wstring result{};
@@ -38,6 +38,7 @@ constexpr wstring_view c_decPostSepStr = L"]?(\\d*)(?:e[+-]?(\\d*))?$";
 //
 typedef struct
 {
+    CCalcEngine const* engine; // the engines on a thread share this, and each keeps its own m_numberString
     Rational value;
     int32_t precision;
     uint32_t radix;
@@ -48,7 +49,7 @@ typedef struct
     bool bUseSep;
 } LASTDISP;
 
-static LASTDISP gldPrevious = { 0, -1, 0, -1, (NUM_WIDTH)-1, false, false, false };
+static thread_local LASTDISP gldPrevious = { nullptr, 0, -1, 0, -1, (NUM_WIDTH)-1, false, false, false };
 
 // Truncates if too big, makes it a non negative - the number in rat. Doesn't do anything if not in INT mode
 CalcEngine::Rational CCalcEngine::TruncateNumForIntMath(CalcEngine::Rational const& rat)
@@ -58,6 +59,13 @@ CalcEngine::Rational CCalcEngine::TruncateNumForIntMath(CalcEngine::Rational con
         return rat;
     }
 
+    // Integers that fit 64 bits are wrapped into the word directly.
+    FixedWidthInteger word;
+    if (FixedWidthInteger::TryTruncate(rat, m_dwWordBitWidth, word))
+    {
+        return word.ToRational();
+    }
+
     // Truncate to an integer. Do not round here.
     auto result = RationalMath::Integer(rat);
 
@@ -84,9 +92,10 @@ void CCalcEngine::DisplayNum(void)
     //  something important has changed since the last time DisplayNum was
     //  called.
     //
-    if (m_bRecord || gldPrevious.value != m_currentVal || gldPrevious.precision != m_precision || gldPrevious.radix != m_radix || gldPrevious.nFE != (int)m_nFE
+    if (m_bRecord || gldPrevious.engine != this || gldPrevious.value != m_currentVal || gldPrevious.precision != m_precision || gldPrevious.radix != m_radix || gldPrevious.nFE != (int)m_nFE
         || !gldPrevious.bUseSep || gldPrevious.numwidth != m_numwidth || gldPrevious.fIntMath != m_fIntegerMode || gldPrevious.bRecord != m_bRecord)
     {
+        gldPrevious.engine = this;
         gldPrevious.precision = m_precision;
         gldPrevious.radix = m_radix;
         gldPrevious.nFE = (int)m_nFE;
@@ -118,7 +127,7 @@ void CCalcEngine::DisplayNum(void)
         {
             DisplayError(CALC_E_OVERFLOW);
         }
-        else
+        else if (m_pCalcDisplay != nullptr)
         {
             // Display the string and return.
             SetPrimaryDisplay(GroupDigitsPerRadix(m_numberString, m_radix));
@@ -43,7 +43,15 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
             }
             else
             {
-                result = rat ^ GetChopNumber();
+                FixedWidthInteger word;
+                if (m_fIntegerMode && FixedWidthInteger::TryFromRational(rat, m_dwWordBitWidth, word))
+                {
+                    result = (~word).ToRational();
+                }
+                else
+                {
+                    result = rat ^ GetChopNumber();
+                }
             }
             break;
 
@@ -51,9 +59,7 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
         case IDC_ROLC:
             if (m_fIntegerMode)
             {
-                result = Integer(rat);
-
-                uint64_t w64Bits = result.ToUInt64_t();
+                uint64_t w64Bits = WordBitsForIntMath(rat);
                 uint64_t msb = (w64Bits >> (m_dwWordBitWidth - 1)) & 1;
                 w64Bits <<= 1; // LShift by 1
 
@@ -75,9 +81,7 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
         case IDC_RORC:
             if (m_fIntegerMode)
             {
-                result = Integer(rat);
-
-                uint64_t w64Bits = result.ToUInt64_t();
+                uint64_t w64Bits = WordBitsForIntMath(rat);
                 uint64_t lsb = ((w64Bits & 0x01) == 1) ? 1 : 0;
                 w64Bits >>= 1; // RShift by 1
 
@@ -290,6 +294,18 @@ CalcEngine::Rational CCalcEngine::SciCalcFunctions(CalcEngine::Rational const& r
     return result;
 }
 
+// The bits of Integer(rat), which rotates work on. Words are read directly.
+uint64_t CCalcEngine::WordBitsForIntMath(CalcEngine::Rational const& rat)
+{
+    FixedWidthInteger word;
+    if (FixedWidthInteger::TryFromRational(rat, m_dwWordBitWidth, word))
+    {
+        return word.Bits();
+    }
+
+    return Integer(rat).ToUInt64_t();
+}
+
 /* Routine to display error messages and set m_bError flag.  Errors are */
 /* called with DisplayError (n), where n is a uint32_t   between 0 and 5. */
 
@@ -300,6 +316,18 @@ void CCalcEngine::DisplayError(uint32_t nError)
     SetPrimaryDisplay(errorString, true /*isError*/);
 
     m_bError = true; /* Set error flag.  Only cleared with CLEAR or CENTR. */
+    m_nErrorCode = nError;
 
     m_HistoryCollector.ClearHistoryLine(errorString);
 }
+
+// What DisplayNum or DisplayError last gave SetPrimaryDisplay, for engines that run without an ICalcDisplay.
+wstring CCalcEngine::GetPrimaryDisplayString()
+{
+    if (m_bError)
+    {
+        return wstring{ GetString(IDS_ERRORS_FIRST + SCODE_CODE(m_nErrorCode)) };
+    }
+
+    return GroupDigitsPerRadix(m_numberString, m_radix);
+}
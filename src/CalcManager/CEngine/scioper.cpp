@@ -14,6 +14,11 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
 
     try
     {
+        if (m_fIntegerMode && TryDoWordOperation(operation, lhs, rhs, result))
+        {
+            return result;
+        }
+
         switch (operation)
         {
         case IDC_AND:
@@ -173,3 +178,144 @@ CalcEngine::Rational CCalcEngine::DoOperation(int operation, CalcEngine::Rationa
 
     return result;
 }
+
+// Programmer mode operations on operands that are both words already, done on
+// the bits. Each result is exactly the value DoOperation gets through ratpak,
+// including the ones that leave the word, such as a carry out of it or a
+// quotient with a remainder, which are left for DisplayNum to truncate as
+// before. Returns false to leave the operation to DoOperation.
+bool CCalcEngine::TryDoWordOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, CalcEngine::Rational& result)
+{
+    FixedWidthInteger lhsWord;
+    FixedWidthInteger rhsWord;
+    if (!FixedWidthInteger::TryFromRational(lhs, m_dwWordBitWidth, lhsWord) || !FixedWidthInteger::TryFromRational(rhs, m_dwWordBitWidth, rhsWord))
+    {
+        return false;
+    }
+
+    uint64_t a = lhsWord.Bits();
+    uint64_t b = rhsWord.Bits();
+
+    switch (operation)
+    {
+    case IDC_AND:
+        result = (lhsWord & rhsWord).ToRational();
+        break;
+
+    case IDC_OR:
+        result = (lhsWord | rhsWord).ToRational();
+        break;
+
+    case IDC_XOR:
+        result = (lhsWord ^ rhsWord).ToRational();
+        break;
+
+    case IDC_NAND:
+        result = (~(lhsWord & rhsWord)).ToRational();
+        break;
+
+    case IDC_NOR:
+        result = (~(lhsWord | rhsWord)).ToRational();
+        break;
+
+    case IDC_RSHF:
+    case IDC_RSHFL:
+    case IDC_LSHF:
+        if (a >= static_cast<uint64_t>(m_dwWordBitWidth)) // Lsh/Rsh >= than current word size is always 0
+        {
+            throw CALC_E_NORESULT;
+        }
+
+        if (operation == IDC_LSHF)
+        {
+            if (a != 0 && (b >> (64 - a)) != 0)
+            {
+                return false;
+            }
+            result = Rational{ b << a };
+        }
+        else if (operation == IDC_RSHF && rhsWord.Msb())
+        {
+            result = rhsWord.ShiftRightArithmetic(static_cast<uint32_t>(a)).ToRational();
+        }
+        else if ((b & ((uint64_t{ 1 } << a) - 1)) == 0)
+        {
+            result = Rational{ b >> a };
+        }
+        else
+        {
+            // rshrat keeps the bits shifted out as a fraction.
+            result = Rational{ b } / Rational{ uint64_t{ 1 } << a };
+        }
+        break;
+
+    case IDC_ADD:
+        if (a + b < a)
+        {
+            return false;
+        }
+        result = Rational{ a + b };
+        break;
+
+    case IDC_SUB:
+        // subrat snaps a difference that is tiny next to its operands to zero,
+        // the small value path in Rational does the same.
+        result = rhsWord.ToRational() - lhsWord.ToRational();
+        break;
+
+    case IDC_MUL:
+        if (a != 0 && b > UINT64_MAX / a)
+        {
+            return false;
+        }
+        result = Rational{ a * b };
+        break;
+
+    case IDC_DIV:
+    case IDC_MOD:
+    {
+        uint64_t numerator = rhsWord.Magnitude();
+        uint64_t denominator = lhsWord.Magnitude();
+
+        if (operation == IDC_DIV)
+        {
+            if (denominator == 0)
+            {
+                throw((numerator == 0) ? CALC_E_INDEFINITE : CALC_E_DIVIDEBYZERO);
+            }
+
+            if (rhsWord.Msb() != lhsWord.Msb())
+            {
+                result = -Rational{ numerator / denominator };
+            }
+            else if (numerator % denominator == 0)
+            {
+                result = Rational{ numerator / denominator };
+            }
+            else
+            {
+                result = Rational{ numerator } / Rational{ denominator };
+            }
+        }
+        else
+        {
+            if (denominator == 0)
+            {
+                throw CALC_E_INDEFINITE;
+            }
+
+            result = Rational{ numerator % denominator };
+            if (rhsWord.Msb())
+            {
+                result = -result;
+            }
+        }
+        break;
+    }
+
+    default:
+        return false;
+    }
+
+    return true;
+}
@@ -1,14 +1,28 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cassert>
 #include "CalculatorHistory.h"
+#include "HistorySerializer.h"
 
 using namespace std;
 using namespace CalculationManager;
 
 namespace
 {
+    // Operator tokens come from a small, fixed set of strings, but the table is bounded anyway so that nothing added to
+    // the history can make it grow without end. Tokens past the limit are stored as they are.
+    constexpr size_t MAX_INTERNED_TOKENS = 256;
+
+    // Each token is stored as a varint reference: an interned token's index shifted left with the low bit set, or zero
+    // followed by the token itself.
+    constexpr uint64_t INLINE_TOKEN = 0;
+
+    // Whether the item's expression is the one generated from its tokens, or follows as a string of its own.
+    constexpr uint8_t GENERATED_EXPRESSION = 0;
+    constexpr uint8_t STORED_EXPRESSION = 1;
+
     static wstring GetGeneratedExpression(const vector<pair<wstring, int>>& tokens)
     {
         wstring expression;
@@ -29,10 +43,24 @@ namespace
 
         return expression;
     }
+
+    // Operand tokens are the numbers typed in, which seldom repeat, so only the tokens of the other commands are
+    // interned.
+    bool IsOperatorToken(pair<wstring, int> const& token, vector<shared_ptr<IExpressionCommand>> const* commands)
+    {
+        if (token.second < 0)
+        {
+            return true;
+        }
+
+        return commands != nullptr && static_cast<size_t>(token.second) < commands->size()
+               && commands->at(token.second)->GetCommandType() != CommandType::OperandCommand;
+    }
 }
 
 CalculatorHistory::CalculatorHistory(size_t maxSize)
-    : m_maxHistorySize(maxSize)
+    : m_firstItem(0)
+    , m_maxHistorySize(maxSize)
 {
 }
 
@@ -41,31 +69,176 @@ unsigned int CalculatorHistory::AddToHistory(
     _In_ shared_ptr<vector<shared_ptr<IExpressionCommand>>> const& commands,
     wstring_view result)
 {
-    shared_ptr<HISTORYITEM> spHistoryItem = make_shared<HISTORYITEM>();
-
-    spHistoryItem->historyItemVector.spTokens = tokens;
-    spHistoryItem->historyItemVector.spCommands = commands;
-    spHistoryItem->historyItemVector.expression = GetGeneratedExpression(*tokens);
-    spHistoryItem->historyItemVector.result = wstring(result);
-    return AddItem(spHistoryItem);
+    return AddEncodedItem(tokens.get(), commands.get(), nullptr, result);
 }
 
 unsigned int CalculatorHistory::AddItem(_In_ shared_ptr<HISTORYITEM> const& spHistoryItem)
 {
-    if (m_historyItems.size() >= m_maxHistorySize)
+    HISTORYITEMVECTOR const& item = spHistoryItem->historyItemVector;
+
+    // An item restored from elsewhere may carry an expression that differs from the one its tokens make.
+    wstring const* expression = nullptr;
+    if (item.spTokens == nullptr || item.expression != GetGeneratedExpression(*item.spTokens))
+    {
+        expression = &item.expression;
+    }
+
+    return AddEncodedItem(item.spTokens.get(), item.spCommands.get(), expression, item.result);
+}
+
+unsigned int CalculatorHistory::AddEncodedItem(
+    _In_opt_ vector<pair<wstring, int>> const* tokens,
+    _In_opt_ vector<shared_ptr<IExpressionCommand>> const* commands,
+    _In_opt_ wstring const* expression,
+    wstring_view result)
+{
+    // Once the history is full, the newest item takes the place of the oldest, reusing its buffer. The view turns in
+    // step with the ring, so only the slot of the new item has to be decoded again.
+    vector<uint8_t>* item;
+    if (m_items.size() < m_maxHistorySize || m_items.empty())
+    {
+        item = &m_items.emplace_back();
+    }
+    else
+    {
+        item = &m_items[m_firstItem];
+        m_firstItem = (m_firstItem + 1) % m_items.size();
+
+        m_historyView.resize(m_items.size());
+        rotate(m_historyView.begin(), m_historyView.begin() + 1, m_historyView.end());
+        m_historyView.back() = nullptr;
+    }
+
+    item->resize(item->capacity());
+    BinaryWriter writer(item->data(), item->size());
+    WriteItem(writer, tokens, commands, expression, result);
+
+    if (!writer.Fits())
+    {
+        item->resize(writer.Size());
+        BinaryWriter resizedWriter(item->data(), item->size());
+        WriteItem(resizedWriter, tokens, commands, expression, result);
+    }
+    item->resize(writer.Size());
+
+    return static_cast<unsigned>(m_items.size() - 1);
+}
+
+void CalculatorHistory::WriteItem(
+    _In_ BinaryWriter& writer,
+    _In_opt_ vector<pair<wstring, int>> const* tokens,
+    _In_opt_ vector<shared_ptr<IExpressionCommand>> const* commands,
+    _In_opt_ wstring const* expression,
+    wstring_view result)
+{
+    writer.WriteVarUInt(tokens != nullptr ? tokens->size() : 0);
+    if (tokens != nullptr)
+    {
+        for (auto const& token : *tokens)
+        {
+            uint64_t reference = INLINE_TOKEN;
+            if (IsOperatorToken(token, commands))
+            {
+                auto interned = m_internedTokenIndexes.find(token.first);
+                if (interned != m_internedTokenIndexes.end())
+                {
+                    reference = (static_cast<uint64_t>(interned->second) << 1) | 1;
+                }
+                else if (m_internedTokens.size() < MAX_INTERNED_TOKENS)
+                {
+                    auto index = static_cast<uint32_t>(m_internedTokens.size());
+                    m_internedTokens.push_back(token.first);
+                    m_internedTokenIndexes.emplace(token.first, index);
+                    reference = (static_cast<uint64_t>(index) << 1) | 1;
+                }
+            }
+
+            writer.WriteVarUInt(reference);
+            if (reference == INLINE_TOKEN)
+            {
+                writer.WriteString(token.first);
+            }
+            writer.WriteVarInt(token.second);
+        }
+    }
+
+    if (commands != nullptr)
+    {
+        HistorySerializer::WriteCommands(writer, *commands);
+    }
+    else
+    {
+        writer.WriteVarUInt(0);
+    }
+
+    if (expression != nullptr)
+    {
+        writer.WriteByte(STORED_EXPRESSION);
+        writer.WriteString(*expression);
+    }
+    else
+    {
+        writer.WriteByte(GENERATED_EXPRESSION);
+    }
+
+    writer.WriteString(result);
+}
+
+shared_ptr<HISTORYITEM> CalculatorHistory::DecodeItem(vector<uint8_t> const& item) const
+{
+    auto spHistoryItem = make_shared<HISTORYITEM>();
+    HISTORYITEMVECTOR& itemVector = spHistoryItem->historyItemVector;
+    itemVector.spTokens = make_shared<vector<pair<wstring, int>>>();
+    itemVector.spCommands = make_shared<vector<shared_ptr<IExpressionCommand>>>();
+
+    BinaryReader reader(item.data(), item.size());
+
+    size_t tokenCount = reader.ReadCount();
+    itemVector.spTokens->reserve(tokenCount);
+    for (size_t i = 0; i < tokenCount; i++)
     {
-        m_historyItems.erase(m_historyItems.begin());
+        uint64_t reference = reader.ReadVarUInt();
+        wstring token = (reference == INLINE_TOKEN) ? reader.ReadString() : m_internedTokens.at(static_cast<size_t>(reference >> 1));
+        int commandIndex = static_cast<int>(reader.ReadVarInt());
+        itemVector.spTokens->emplace_back(move(token), commandIndex);
     }
 
-    m_historyItems.push_back(spHistoryItem);
-    return static_cast<unsigned>(m_historyItems.size() - 1);
+    [[maybe_unused]] bool hasCommands = HistorySerializer::TryReadCommands(reader, *itemVector.spCommands);
+    assert(hasCommands);
+
+    if (reader.ReadByte() == STORED_EXPRESSION)
+    {
+        itemVector.expression = reader.ReadString();
+    }
+    else
+    {
+        itemVector.expression = GetGeneratedExpression(*itemVector.spTokens);
+    }
+
+    itemVector.result = reader.ReadString();
+
+    // Every item was written by WriteItem, so anything else is a bug here rather than bad input.
+    assert(!reader.Failed() && reader.AtEnd());
+    return spHistoryItem;
+}
+
+vector<uint8_t> const& CalculatorHistory::ItemAt(size_t index) const
+{
+    return m_items[(m_firstItem + index) % m_items.size()];
 }
 
 bool CalculatorHistory::RemoveItem(unsigned int uIdx)
 {
-    if (uIdx < m_historyItems.size())
+    if (uIdx < m_items.size())
     {
-        m_historyItems.erase(m_historyItems.begin() + uIdx);
+        // Put the oldest item back at the front, so the ring can be closed up like any other vector.
+        rotate(m_items.begin(), m_items.begin() + m_firstItem, m_items.end());
+        m_firstItem = 0;
+        m_items.erase(m_items.begin() + uIdx);
+        if (uIdx < m_historyView.size())
+        {
+            m_historyView.erase(m_historyView.begin() + uIdx);
+        }
         return true;
     }
 
@@ -74,16 +247,34 @@ bool CalculatorHistory::RemoveItem(unsigned int uIdx)
 
 vector<shared_ptr<HISTORYITEM>> const& CalculatorHistory::GetHistory()
 {
-    return m_historyItems;
+    m_historyView.resize(m_items.size());
+    for (size_t i = 0; i < m_items.size(); i++)
+    {
+        if (m_historyView[i] == nullptr)
+        {
+            m_historyView[i] = DecodeItem(ItemAt(i));
+        }
+    }
+
+    return m_historyView;
 }
 
 shared_ptr<HISTORYITEM> const& CalculatorHistory::GetHistoryItem(unsigned int uIdx)
 {
-    assert(uIdx < m_historyItems.size());
-    return m_historyItems.at(uIdx);
+    assert(uIdx < m_items.size());
+
+    m_historyView.resize(m_items.size());
+    if (uIdx < m_historyView.size() && m_historyView[uIdx] == nullptr)
+    {
+        m_historyView[uIdx] = DecodeItem(ItemAt(uIdx));
+    }
+
+    return m_historyView.at(uIdx);
 }
 
 void CalculatorHistory::ClearHistory()
 {
-    m_historyItems.clear();
+    m_items.clear();
+    m_firstItem = 0;
+    m_historyView.clear();
 }
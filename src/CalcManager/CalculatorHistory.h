@@ -2,11 +2,15 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <string>
+#include <unordered_map>
 #include "ExpressionCommandInterface.h"
 #include "Header Files/IHistoryDisplay.h"
 
 namespace CalculationManager
 {
+    class BinaryWriter;
+
     struct HISTORYITEMVECTOR
     {
         std::shared_ptr<std::vector<std::pair<std::wstring, int>>> spTokens;
@@ -20,6 +24,12 @@ namespace CalculationManager
         HISTORYITEMVECTOR historyItemVector;
     };
 
+    // Keeps each item flattened into one buffer of the compact encoding HistorySerializer uses, with the operator tokens
+    // replaced by indexes into a table of the distinct ones. The buffers are a ring, so once the history is full the
+    // oldest item's buffer is overwritten by the newest in place.
+    //
+    // The HISTORYITEMs handed out are decoded when they are asked for, and the references to them stay valid until the
+    // history next changes. An item keeps the HISTORYITEM decoded for it for as long as it stays in the history.
     class CalculatorHistory : public IHistoryDisplay
     {
     public:
@@ -39,7 +49,27 @@ namespace CalculationManager
         }
 
     private:
-        std::vector<std::shared_ptr<HISTORYITEM>> m_historyItems;
+        std::vector<std::vector<uint8_t>> m_items;
+        size_t m_firstItem;
         const size_t m_maxHistorySize;
+
+        std::vector<std::wstring> m_internedTokens;
+        std::unordered_map<std::wstring, uint32_t> m_internedTokenIndexes;
+
+        std::vector<std::shared_ptr<HISTORYITEM>> m_historyView;
+
+        unsigned int AddEncodedItem(
+            _In_opt_ std::vector<std::pair<std::wstring, int>> const* tokens,
+            _In_opt_ std::vector<std::shared_ptr<IExpressionCommand>> const* commands,
+            _In_opt_ std::wstring const* expression,
+            std::wstring_view result);
+        void WriteItem(
+            _In_ BinaryWriter& writer,
+            _In_opt_ std::vector<std::pair<std::wstring, int>> const* tokens,
+            _In_opt_ std::vector<std::shared_ptr<IExpressionCommand>> const* commands,
+            _In_opt_ std::wstring const* expression,
+            std::wstring_view result);
+        std::shared_ptr<HISTORYITEM> DecodeItem(std::vector<uint8_t> const& item) const;
+        std::vector<uint8_t> const& ItemAt(size_t index) const;
     };
 }
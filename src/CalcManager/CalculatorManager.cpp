@@ -22,6 +22,7 @@ namespace CalculationManager
         , m_currentCalculatorEngine(nullptr)
         , m_resourceProvider(resourceProvider)
         , m_inHistoryItemLoadMode(false)
+        , m_hasMissedExpressionUpdate(false)
         , m_persistedPrimaryValue()
         , m_isExponentialFormat(false)
         , m_currentDegreeMode(Command::CommandNULL)
@@ -87,6 +88,32 @@ namespace CalculationManager
         if (!m_inHistoryItemLoadMode)
         {
             m_displayCallback->SetExpressionDisplay(tokens, commands);
+            m_hasMissedExpressionUpdate = false;
+        }
+        else
+        {
+            m_hasMissedExpressionUpdate = true;
+        }
+    }
+
+    /// <summary>
+    /// Like SetExpressionDisplay, but only the tokens from firstChangedToken on differ from the ones last sent.
+    /// </summary>
+    /// <param name="firstChangedToken">index of the first token that changed</param>
+    void CalculatorManager::UpdateExpressionDisplay(
+        _Inout_ shared_ptr<vector<pair<wstring, int>>> const& tokens,
+        _Inout_ shared_ptr<vector<shared_ptr<IExpressionCommand>>> const& commands,
+        size_t firstChangedToken)
+    {
+        if (!m_inHistoryItemLoadMode)
+        {
+            // Changes the display did not see while a history item was loading start from the front
+            m_displayCallback->UpdateExpressionDisplay(tokens, commands, m_hasMissedExpressionUpdate ? 0 : firstChangedToken);
+            m_hasMissedExpressionUpdate = false;
+        }
+        else
+        {
+            m_hasMissedExpressionUpdate = true;
         }
     }
 
@@ -568,6 +595,11 @@ namespace CalculationManager
         return m_currentCalculatorEngine ? m_currentCalculatorEngine->GetCurrentResultForRadix(radix, precision, groupDigitsPerRadix) : L"";
     }
 
+    vector<RadixResult> CalculatorManager::GetResultsForRadixes(vector<uint32_t> const& radixes, int32_t precision)
+    {
+        return m_currentCalculatorEngine ? m_currentCalculatorEngine->GetCurrentResultsForRadixes(radixes, precision) : vector<RadixResult>{};
+    }
+
     void CalculatorManager::SetPrecision(int32_t precision)
     {
         m_currentCalculatorEngine->ChangePrecision(precision);
@@ -52,6 +52,7 @@ namespace CalculationManager
         std::unique_ptr<CCalcEngine> m_programmerCalculatorEngine;
         IResourceProvider* const m_resourceProvider;
         bool m_inHistoryItemLoadMode;
+        bool m_hasMissedExpressionUpdate;
 
         std::vector<CalcEngine::Rational> m_memorizedNumbers;
         CalcEngine::Rational m_persistedPrimaryValue;
@@ -74,6 +75,10 @@ namespace CalculationManager
         void SetExpressionDisplay(
             _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
             _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands) override;
+        void UpdateExpressionDisplay(
+            _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
+            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands,
+            size_t firstChangedToken) override;
         void SetMemorizedNumbers(_In_ const std::vector<std::wstring>& memorizedNumbers) override;
         void OnHistoryItemAdded(_In_ unsigned int addedItemIndex) override;
         void SetParenthesisNumber(_In_ unsigned int parenthesisCount) override;
@@ -103,6 +108,7 @@ namespace CalculationManager
         void SetRadix(RadixType iRadixType);
         void SetMemorizedNumbersString();
         std::wstring GetResultForRadix(uint32_t radix, int32_t precision, bool groupDigitsPerRadix);
+        std::vector<RadixResult> GetResultsForRadixes(std::vector<uint32_t> const& radixes, int32_t precision);
         void SetPrecision(int32_t precision);
         void UpdateMaxIntDigits();
         wchar_t DecimalSeparator();
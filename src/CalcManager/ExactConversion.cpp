@@ -0,0 +1,315 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include "ExactConversion.h"
+#include "Header Files/Rational.h"
+
+using namespace std;
+using namespace CalcEngine;
+using namespace UnitConversionManager;
+
+namespace
+{
+    using Fraction = ExactConversion::Fraction;
+
+    // How many bits of a quotient are worked out before it is rounded to a double. More than the 53 a double keeps
+    // and the one it rounds by, so that a last bit can stand for whatever is left over, but still short of an int64_t.
+    constexpr int32_t QUOTIENT_BITS = 62;
+
+    // The digits divnumx has to work out for such a quotient: the two it takes, and a leading one that may be zero.
+    // The thread's constants may leave it no more, as they don't have to be set for anything else here.
+    constexpr int32_t QUOTIENT_DIGITS = 3;
+
+    // ratpak throws its errors, and any of them leaves nothing to convert with.
+    template <typename Function>
+    auto CatchRatpakErrors(Function&& function) -> decltype(function())
+    {
+        try
+        {
+            return function();
+        }
+        catch (uint32_t)
+        {
+            return nullopt;
+        }
+    }
+
+    Fraction FromInteger(int32_t value)
+    {
+        return Fraction{ Number::Adopt(i32tonum(value, BASEX)), Number::Adopt(i32tonum(1, BASEX)) };
+    }
+
+    void MultiplyIntegers(Number& a, Number const& b)
+    {
+        PNUMBER product = a.Release();
+        try
+        {
+            mulnumx(&product, b.Lend());
+        }
+        catch (uint32_t)
+        {
+            destroynum(product);
+            throw;
+        }
+        a = Number::Adopt(product);
+    }
+
+    Fraction Multiply(Fraction a, Fraction const& b)
+    {
+        MultiplyIntegers(a.numerator, b.numerator);
+        MultiplyIntegers(a.denominator, b.denominator);
+        return a;
+    }
+
+    Fraction Divide(Fraction a, Fraction const& b)
+    {
+        if (b.numerator.IsZero())
+        {
+            throw(CALC_E_DIVIDEBYZERO);
+        }
+
+        MultiplyIntegers(a.numerator, b.denominator);
+        MultiplyIntegers(a.denominator, b.numerator);
+        return a;
+    }
+
+    // The sum is left over the product of the denominators, as nothing reads it but ToDouble.
+    Fraction Add(Fraction a, Fraction const& b)
+    {
+        if (b.numerator.IsZero())
+        {
+            return a;
+        }
+
+        Number addend = b.numerator;
+        MultiplyIntegers(addend, a.denominator);
+        MultiplyIntegers(a.numerator, b.denominator);
+        MultiplyIntegers(a.denominator, b.denominator);
+
+        PNUMBER sum = a.numerator.Release();
+        try
+        {
+            addnum(&sum, addend.Lend(), BASEX);
+        }
+        catch (uint32_t)
+        {
+            destroynum(sum);
+            throw;
+        }
+        a.numerator = Number::Adopt(sum);
+        return a;
+    }
+
+    Fraction ReadDecimal(wstring_view decimal)
+    {
+        // StringToNumber stops at a character it doesn't expect, rather than failing.
+        if (decimal.find_first_not_of(L"0123456789.+-e") != wstring_view::npos)
+        {
+            throw(CALC_E_DOMAIN);
+        }
+
+        PNUMBER number = StringToNumber(decimal, RATIONAL_BASE, RATIONAL_PRECISION);
+        if (number == nullptr)
+        {
+            throw(CALC_E_DOMAIN);
+        }
+
+        PRAT rat = numtorat(number, RATIONAL_BASE);
+        destroynum(number);
+        Fraction result{ Number::Adopt(rat->pp), Number::Adopt(rat->pq) };
+        rat->pp = nullptr;
+        rat->pq = nullptr;
+        destroyrat(rat);
+        return result;
+    }
+
+    Fraction ReadProduct(wstring_view product)
+    {
+        Fraction result = FromInteger(1);
+        size_t start = 0;
+        while (true)
+        {
+            size_t end = product.find(L'*', start);
+            result = Multiply(move(result), ReadDecimal(product.substr(start, end - start)));
+            if (end == wstring_view::npos)
+            {
+                return result;
+            }
+            start = end + 1;
+        }
+    }
+
+    Fraction ReadExact(wstring_view value)
+    {
+        size_t slash = value.find(L'/');
+        if (slash == wstring_view::npos)
+        {
+            return ReadProduct(value);
+        }
+        return Divide(ReadProduct(value.substr(0, slash)), ReadProduct(value.substr(slash + 1)));
+    }
+
+    // How many bits the mantissa of a number takes, leaving its exponent out.
+    int32_t MantissaBits(PNUMBER number)
+    {
+        int32_t bits = (number->cdigit - 1) * static_cast<int32_t>(BASEXPWR);
+        for (MANTTYPE digit = MSD(number); digit != 0; digit >>= 1)
+        {
+            bits++;
+        }
+        return bits;
+    }
+
+    // The mantissa of a number, as a positive integer, shifted left by some bits.
+    PNUMBER ShiftedMantissa(PNUMBER number, int32_t shift)
+    {
+        PNUMBER shifted = nullptr;
+        DUPNUM(shifted, number);
+        shifted->sign = 1;
+        shifted->exp = shift / static_cast<int32_t>(BASEXPWR);
+
+        PNUMBER power = Ui32tonum(1U << (shift % BASEXPWR), BASEX);
+        mulnumx(&shifted, power);
+        destroynum(power);
+        return shifted;
+    }
+
+    // The integer part of a positive number less than 2^64.
+    uint64_t IntegerPart(PNUMBER number)
+    {
+        uint64_t value = 0;
+        for (int32_t i = 0; i < number->cdigit; i++)
+        {
+            const int32_t position = i + number->exp;
+            if (position >= 0)
+            {
+                value |= static_cast<uint64_t>(number->mant[i]) << (BASEXPWR * position);
+            }
+        }
+        return value;
+    }
+
+    PNUMBER Ui64ToNumber(uint64_t value)
+    {
+        PNUMBER number = nullptr;
+        createnum(number, 2);
+        number->sign = 1;
+        number->exp = 0;
+        number->mant[0] = static_cast<MANTTYPE>(value);
+        number->mant[1] = static_cast<MANTTYPE>(value >> BASEXPWR);
+        number->cdigit = number->mant[1] == 0 ? 1 : 2;
+        return number;
+    }
+
+    // The integer quotient of two positive integers, which has to fit in an int64_t, and whether anything is left over.
+    // divnumx only guesses at the last digit it works out, so the remainder puts right an integer part that is off by one.
+    uint64_t DivideIntegers(PNUMBER dividend, PNUMBER divisor, bool& isInexact)
+    {
+        PNUMBER guess = nullptr;
+        DUPNUM(guess, dividend);
+        divnumx(&guess, divisor, QUOTIENT_DIGITS);
+        uint64_t quotient = IntegerPart(guess);
+        destroynum(guess);
+
+        PNUMBER remainder = Ui64ToNumber(quotient);
+        mulnumx(&remainder, divisor);
+        remainder->sign = -1;
+        addnum(&remainder, dividend, BASEX);
+        while (remainder->sign < 0 && !zernum(remainder))
+        {
+            addnum(&remainder, divisor, BASEX);
+            quotient--;
+        }
+
+        divisor->sign = -1;
+        while (!lessnum(remainder, divisor))
+        {
+            addnum(&remainder, divisor, BASEX);
+            quotient++;
+        }
+        divisor->sign = 1;
+
+        isInexact = !zernum(remainder);
+        destroynum(remainder);
+        return quotient;
+    }
+
+    // The double nearest a fraction. The quotient of its mantissas is worked out to QUOTIENT_BITS bits, with the last
+    // one set when anything is left over, so that converting it to a double rounds once, as the exact value would.
+    // Only results too small for a normal double are rounded again, by ldexp.
+    double ToDouble(Fraction const& value)
+    {
+        PNUMBER p = value.numerator.Lend();
+        PNUMBER q = value.denominator.Lend();
+        if (zernum(p))
+        {
+            return 0.0;
+        }
+
+        // Shift whichever mantissa keeps the quotient to QUOTIENT_BITS bits, or one fewer.
+        const int32_t shift = MantissaBits(q) - MantissaBits(p) + QUOTIENT_BITS;
+        PNUMBER dividend = ShiftedMantissa(p, max(shift, 0));
+        PNUMBER divisor = ShiftedMantissa(q, max(-shift, 0));
+        bool isInexact;
+        uint64_t quotient = DivideIntegers(dividend, divisor, isInexact);
+        destroynum(dividend);
+        destroynum(divisor);
+
+        const double rounded = static_cast<double>(static_cast<int64_t>(quotient | (isInexact ? 1 : 0)));
+        const int exponent = static_cast<int>(BASEXPWR) * (p->exp - q->exp) - shift;
+        return p->sign * q->sign * ldexp(rounded, exponent);
+    }
+}
+
+ExactConversion::ExactConversion(Fraction ratio, Fraction offset, bool offsetFirst)
+    : m_ratio(move(ratio))
+    , m_offset(move(offset))
+    , m_offsetFirst(offsetFirst)
+{
+}
+
+/// <summary>
+/// Reads a ratio and offset written out exactly, once, so converting with them only has to read the value
+/// </summary>
+/// <param name="ratio">what the value is multiplied by</param>
+/// <param name="offset">what is added to the value, before or after the multiplication</param>
+/// <param name="offsetFirst">whether the offset is added before the multiplication</param>
+optional<ExactConversion> ExactConversion::TryCreate(wstring_view ratio, wstring_view offset, bool offsetFirst)
+{
+    if (ratio.empty())
+    {
+        return nullopt;
+    }
+
+    return CatchRatpakErrors([&]() -> optional<ExactConversion> {
+        return ExactConversion{ ReadExact(ratio), offset.empty() ? FromInteger(0) : ReadExact(offset), offsetFirst };
+    });
+}
+
+/// <summary>
+/// Reads the ratio between two units from their factors, without writing out the quotient of the two first
+/// </summary>
+/// <param name="dividend">the factor of the unit converted from</param>
+/// <param name="divisor">the factor of the unit converted to</param>
+optional<ExactConversion> ExactConversion::TryCreateQuotient(wstring_view dividend, wstring_view divisor)
+{
+    if (dividend.empty() || divisor.empty())
+    {
+        return nullopt;
+    }
+
+    return CatchRatpakErrors([&]() -> optional<ExactConversion> {
+        return ExactConversion{ Divide(ReadExact(dividend), ReadExact(divisor)), FromInteger(0), false };
+    });
+}
+
+optional<double> ExactConversion::TryConvert(wstring_view value) const
+{
+    return CatchRatpakErrors([&]() -> optional<double> {
+        Fraction result = ReadDecimal(value);
+        result = m_offsetFirst ? Multiply(Add(move(result), m_offset), m_ratio) : Add(Multiply(move(result), m_ratio), m_offset);
+        return ToDouble(result);
+    });
+}
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include "Header Files/Number.h"
+
+namespace UnitConversionManager
+{
+    // A unit conversion worked out exactly rather than in doubles. The ratio and offset are written out exactly, as
+    // decimals multiplied with '*', and at most one '/' before the product they are divided by, e.g. L"0.3048/0.0254"
+    // or L"400*0.0254/121".
+    class ExactConversion final
+    {
+    public:
+        // nullopt when there is no ratio, or it can't be read. An empty offset is zero.
+        static std::optional<ExactConversion> TryCreate(std::wstring_view ratio, std::wstring_view offset, bool offsetFirst);
+        // Multiplies by one exact factor and divides by another, as between two units that are each a factor of some
+        // base unit. nullopt when either is missing or can't be read.
+        static std::optional<ExactConversion> TryCreateQuotient(std::wstring_view dividend, std::wstring_view divisor);
+
+        // Converts a decimal as the converter displays it, rounding only the result to a double.
+        std::optional<double> TryConvert(std::wstring_view value) const;
+
+        // A rational kept as two integers, which are only ever multiplied and added. Unlike a Rational it is never
+        // trimmed, and unlike Rational arithmetic that reads none of the constants an engine on the same thread has set
+        // for its radix, so converting doesn't have to switch them.
+        struct Fraction
+        {
+            CalcEngine::Number numerator;
+            CalcEngine::Number denominator;
+        };
+
+    private:
+        ExactConversion(Fraction ratio, Fraction offset, bool offsetFirst);
+
+        Fraction m_ratio;
+        Fraction m_offset;
+        bool m_offsetFirst;
+    };
+}
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <string>
 #include "Header Files/CCommand.h"
 #include "ExpressionCommand.h"
@@ -12,6 +13,9 @@ constexpr wchar_t chNegate = L'-';
 constexpr wchar_t chExp = L'e';
 constexpr wchar_t chPlus = L'+';
 
+// One for each radix the engine has
+constexpr size_t MAX_CACHED_STRINGS = 4;
+
 CParentheses::CParentheses(_In_ int command)
     : m_command(command)
 {
@@ -273,14 +277,36 @@ const wstring& COpndCommand::GetToken(wchar_t decimalSymbol)
     return m_token;
 }
 
-wstring COpndCommand::GetString(uint32_t radix, int32_t precision)
+const wstring& COpndCommand::GetString(uint32_t radix, int32_t precision, wchar_t decimalSymbol)
 {
-    if (m_fInitialized)
+    static const wstring empty;
+    if (!m_fInitialized)
+    {
+        return empty;
+    }
+
+    for (auto const& cached : m_strings)
+    {
+        if (cached.radix == radix && cached.precision == precision && cached.decimalSymbol == decimalSymbol)
+        {
+            return cached.value;
+        }
+    }
+
+    if (m_strings.size() >= MAX_CACHED_STRINGS)
     {
-        return m_value.ToString(radix, NumberFormat::Float, precision);
+        m_strings.erase(m_strings.begin());
     }
 
-    return wstring{};
+    m_strings.push_back({ radix, precision, decimalSymbol, m_value.ToString(radix, NumberFormat::Float, precision) });
+    return m_strings.back().value;
+}
+
+bool COpndCommand::IsStringCached(uint32_t radix, int32_t precision, wchar_t decimalSymbol) const
+{
+    return any_of(m_strings.begin(), m_strings.end(), [&](CachedString const& cached) {
+        return cached.radix == radix && cached.precision == precision && cached.decimalSymbol == decimalSymbol;
+    });
 }
 
 void COpndCommand::Accept(_In_ ISerializeCommandVisitor& commandVisitor)
@@ -63,9 +63,21 @@ public:
     const std::wstring& GetToken(wchar_t decimalSymbol) override;
     CalculationManager::CommandType GetCommandType() const override;
     void Accept(_In_ ISerializeCommandVisitor& commandVisitor) override;
-    std::wstring GetString(uint32_t radix, int32_t precision);
+
+    // The value as the expression shows it in the given radix and precision. The last few strings are kept, so going
+    // back to a radix does not convert the value again.
+    const std::wstring& GetString(uint32_t radix, int32_t precision, wchar_t decimalSymbol);
+    bool IsStringCached(uint32_t radix, int32_t precision, wchar_t decimalSymbol) const;
 
 private:
+    struct CachedString
+    {
+        uint32_t radix;
+        int32_t precision;
+        wchar_t decimalSymbol;
+        std::wstring value;
+    };
+
     std::shared_ptr<std::vector<int>> m_commands;
     bool m_fNegative;
     bool m_fSciFmt;
@@ -73,6 +85,7 @@ private:
     bool m_fInitialized;
     std::wstring m_token;
     CalcEngine::Rational m_value;
+    std::vector<CachedString> m_strings;
     void ClearAllAndAppendCommand(CalculationManager::Command command);
 };
 
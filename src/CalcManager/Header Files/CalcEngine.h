@@ -14,6 +14,8 @@
 *
 \****************************************************************************/
 
+#include <atomic>
+#include <mutex>
 #include <random>
 #include "CCommand.h"
 #include "EngineStrings.h"
@@ -24,6 +26,7 @@
 #include "CalcInput.h"
 #include "CalcUtils.h"
 #include "ICalcDisplay.h"
+#include "FixedWidthInteger.h"
 #include "Rational.h"
 #include "RationalMath.h"
 
@@ -40,6 +43,14 @@ enum class NUM_WIDTH
 };
 static constexpr size_t NUM_WIDTH_LENGTH = 4;
 
+// The current value in one radix, as GetCurrentResultForRadix returns it with and without digit grouping.
+struct RadixResult
+{
+    uint32_t radix;
+    std::wstring ungroupedString;
+    std::wstring groupedString;
+};
+
 namespace CalculationManager
 {
     class IResourceProvider;
@@ -75,10 +86,16 @@ public:
     {
         return m_bRecord;
     }
+    bool FInExponentialFormat()
+    {
+        return m_nFE == NumberFormat::Scientific;
+    }
+    std::wstring GetPrimaryDisplayString();
     void SettingsChanged();
     bool IsCurrentTooBigForTrig();
     uint32_t GetCurrentRadix();
     std::wstring GetCurrentResultForRadix(uint32_t radix, int32_t precision, bool groupDigitsPerRadix);
+    std::vector<RadixResult> GetCurrentResultsForRadixes(std::vector<uint32_t> const& radixes, int32_t precision);
     void ChangePrecision(int32_t precision)
     {
         m_precision = precision;
@@ -91,17 +108,35 @@ public:
 
     std::vector<std::shared_ptr<IExpressionCommand>> GetHistoryCollectorCommandsSnapshot() const;
 
+    // The strings for keys, errors, trig types, etc. A table is never changed once other threads can see it.
+    using EngineStringTable = std::unordered_map<std::wstring_view, std::wstring>;
+
     // Static methods for the instance
     static void
     InitialOneTimeOnlySetup(CalculationManager::IResourceProvider& resourceProvider); // Once per load time to call to initialize all shared global variables
+    static void InitialThreadSetup(); // Once on each other thread that runs an engine, ratpak's constants are per thread
+    // A table of the provider's strings with its decimal separator in, for SetThreadEngineStrings
+    static std::unique_ptr<EngineStringTable const> CreateEngineStrings(CalculationManager::IResourceProvider& resourceProvider);
+    // Has the calling thread read its strings from the table given instead of the shared one, until called with nullptr
+    static void SetThreadEngineStrings(EngineStringTable const* strings)
+    {
+        t_threadEngineStrings = strings;
+    }
     // returns the ptr to string representing the operator. Mostly same as the button, but few special cases for x^y etc.
     static std::wstring_view GetString(int ids)
     {
-        return s_engineStrings[std::to_wstring(ids)];
+        return GetString(std::to_wstring(ids));
     }
     static std::wstring_view GetString(std::wstring_view ids)
     {
-        return s_engineStrings[ids];
+        EngineStringTable const* strings = t_threadEngineStrings != nullptr ? t_threadEngineStrings : s_engineStrings.load(std::memory_order_acquire);
+        if (strings == nullptr)
+        {
+            return {};
+        }
+
+        auto it = strings->find(ids);
+        return it != strings->end() ? std::wstring_view{ it->second } : std::wstring_view{};
     }
     static std::wstring_view OpCodeToString(int nOpCode)
     {
@@ -133,6 +168,7 @@ private:
     std::array<CalcEngine::Rational, MAXPRECDEPTH> m_parenVals;      // Holding array for parenthesis values.
     std::array<CalcEngine::Rational, MAXPRECDEPTH> m_precedenceVals; // Holding array for precedence values.
     bool m_bError;                                                   // Error flag.
+    uint32_t m_nErrorCode;                                           // The error shown while m_bError is set.
     bool m_bInv;                                                     // Inverse on/off flag.
     bool m_bNoPrevEqu;                                               /* Flag for previous equals.          */
 
@@ -162,7 +198,11 @@ private:
 
     std::array<CalcEngine::Rational, NUM_WIDTH_LENGTH> m_chopNumbers;           // word size enforcement
     std::array<std::wstring, NUM_WIDTH_LENGTH> m_maxDecimalValueStrings;        // maximum values represented by a given word width based off m_chopNumbers
-    static std::unordered_map<std::wstring_view, std::wstring> s_engineStrings; // the string table shared across all instances
+    static std::atomic<EngineStringTable const*> s_engineStrings; // the string table shared across all instances
+    static thread_local EngineStringTable const* t_threadEngineStrings; // used instead of s_engineStrings when set
+    static std::mutex s_engineStringsMutex;                             // held while replacing s_engineStrings
+    // Every table s_engineStrings has pointed to. GetString hands out views into them, so they are never freed.
+    static std::vector<std::unique_ptr<EngineStringTable const>> s_engineStringTables;
     wchar_t m_decimalSeparator;
     wchar_t m_groupSeparator;
 
@@ -180,6 +220,8 @@ private:
     CalcEngine::Rational TruncateNumForIntMath(CalcEngine::Rational const& rat);
     CalcEngine::Rational SciCalcFunctions(CalcEngine::Rational const& rat, uint32_t op);
     CalcEngine::Rational DoOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs);
+    bool TryDoWordOperation(int operation, CalcEngine::Rational const& lhs, CalcEngine::Rational const& rhs, CalcEngine::Rational& result);
+    uint64_t WordBitsForIntMath(CalcEngine::Rational const& rat);
     void SetRadixTypeAndNumWidth(RadixType radixtype, NUM_WIDTH numwidth);
     int32_t DwWordBitWidthFromNumWidth(NUM_WIDTH numwidth);
     uint32_t NRadixFromRadixType(RadixType radixtype);
@@ -193,6 +235,7 @@ private:
     std::wstring GetMaxDecimalValueString() const;
 
     static void LoadEngineStrings(CalculationManager::IResourceProvider& resourceProvider);
+    static void PublishEngineStrings(std::unique_ptr<EngineStringTable const> strings);
     static int IdStrFromCmdId(int id)
     {
         return id - IDC_FIRSTCONTROL + IDS_ENGINESTR_FIRST;
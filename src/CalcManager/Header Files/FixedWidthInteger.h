@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "Rational.h"
+
+namespace CalcEngine
+{
+    // A Programmer mode value as the bits of a word of 8, 16, 32 or 64 bits.
+    // Operands that are already words, which is what TruncateNumForIntMath
+    // leaves behind, can be worked on natively instead of through ratpak.
+    class FixedWidthInteger
+    {
+    public:
+        FixedWidthInteger() noexcept;
+        FixedWidthInteger(uint64_t bits, int32_t width) noexcept;
+
+        // Succeeds when rat is an integer over one in [0, 2^width).
+        static bool TryFromRational(Rational const& rat, int32_t width, FixedWidthInteger& word) noexcept;
+
+        // Succeeds when rat is an integer over one that fits 64 bits either
+        // side of zero, with the word TruncateNumForIntMath makes of it.
+        static bool TryTruncate(Rational const& rat, int32_t width, FixedWidthInteger& word) noexcept;
+
+        Rational ToRational() const;
+
+        // The digits Programmer mode displays for the word, unsigned in
+        // radix 2, 8 and 16 and two's complement in radix 10. Empty for any
+        // other radix.
+        std::wstring ToString(uint32_t radix) const;
+
+        uint64_t Bits() const noexcept;
+        int32_t Width() const noexcept;
+        uint64_t Mask() const noexcept;
+        bool Msb() const noexcept;
+
+        // The magnitude of the word read as a two's complement number.
+        uint64_t Magnitude() const noexcept;
+
+        // Shifts right, copying the msb into the bits vacated.
+        FixedWidthInteger ShiftRightArithmetic(uint32_t shift) const noexcept;
+
+        FixedWidthInteger operator~() const noexcept;
+        friend FixedWidthInteger operator&(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept;
+        friend FixedWidthInteger operator|(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept;
+        friend FixedWidthInteger operator^(FixedWidthInteger const& lhs, FixedWidthInteger const& rhs) noexcept;
+
+    private:
+        uint64_t m_bits;
+        int32_t m_width;
+    };
+}
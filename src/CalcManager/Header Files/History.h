@@ -56,14 +56,17 @@ private:
     int m_curOperandIndex; // Stack index for the above stack
     bool m_bLastOpndBrace; // iff the last opnd in history is already braced so we can avoid putting another one for unary operator
     wchar_t m_decimalSymbol;
+    bool m_bCollecting; // false when there is neither a display nor a history to show the equation to
     std::shared_ptr<std::vector<std::pair<std::wstring, int>>> m_spTokens;
     std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> m_spCommands;
+    size_t m_firstChangedToken; // the first token that differs from the ones last sent to the display
 
 private:
     void ReinitHistory();
     int IchAddSzToEquationSz(std::wstring_view str, int icommandIndex);
     void TruncateEquationSzFromIch(int ich);
     void SetExpressionDisplay();
+    void TokensChangedFrom(size_t ich);
     void InsertSzInEquationSz(std::wstring_view str, int icommandIndex, int ich);
     std::shared_ptr<std::vector<int>> GetOperandCommandsFromString(std::wstring_view numStr) const;
 };
@@ -14,6 +14,17 @@ public:
     virtual void SetExpressionDisplay(
         _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
         _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands) = 0;
+
+    // Sent instead of SetExpressionDisplay by the engine. When the display last showed these same tokens, the ones
+    // before firstChangedToken have not changed since, so only the rest have to be shown again.
+    virtual void UpdateExpressionDisplay(
+        _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
+        _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands,
+        size_t /*firstChangedToken*/)
+    {
+        SetExpressionDisplay(tokens, commands);
+    }
+
     virtual void SetParenthesisNumber(_In_ unsigned int count) = 0;
     virtual void OnNoRightParenAdded() = 0;
     virtual void MaxDigitsReached() = 0; // not an error but still need to inform UI layer.
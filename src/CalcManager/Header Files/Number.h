@@ -8,24 +8,45 @@
 
 namespace CalcEngine
 {
+    // A Number owns a ratpak NUMBER, so it can be handed to ratpak and taken
+    // back from it without copying the digits.
     class Number
     {
     public:
         Number() noexcept;
         Number(int32_t sign, int32_t exp, std::vector<uint32_t> const& mantissa) noexcept;
 
+        Number(Number const& other);
+        Number(Number&& other) noexcept;
+        Number& operator=(Number const& other);
+        Number& operator=(Number&& other) noexcept;
+        ~Number();
+
         explicit Number(PNUMBER p) noexcept;
         PNUMBER ToPNUMBER() const;
 
+        // Takes ownership of p, which must have been allocated by ratpak.
+        static Number Adopt(PNUMBER p) noexcept;
+
+        // Gives up ownership of the NUMBER, which leaves this Number empty
+        // until it is assigned to again.
+        PNUMBER Release() noexcept;
+
+        // The NUMBER itself, for ratpak calls that only read it.
+        PNUMBER Lend() const noexcept;
+
         int32_t const& Sign() const;
         int32_t const& Exp() const;
-        std::vector<uint32_t> const& Mantissa() const;
+        std::vector<uint32_t> Mantissa() const;
 
         bool IsZero() const;
 
     private:
-        int32_t m_sign;
-        int32_t m_exp;
-        std::vector<uint32_t> m_mantissa;
+        struct Adopted
+        {
+        };
+        Number(Adopted, PNUMBER p) noexcept;
+
+        PNUMBER m_pnum;
     };
 }
@@ -19,7 +19,7 @@ namespace CalcEngine
     public:
         Rational() noexcept;
         Rational(Number const& n) noexcept;
-        Rational(Number const& p, Number const& q) noexcept;
+        Rational(Number p, Number q) noexcept;
         Rational(int32_t i);
         Rational(uint32_t ui);
         Rational(uint64_t ui);
@@ -68,6 +68,12 @@ namespace CalcEngine
         uint64_t ToUInt64_t() const;
 
     private:
+        // Operators hand p and q over to ratpak and take its result back
+        // without copying the digits. If ratpak throws, the value it was
+        // working on is lost and the rational is left zero.
+        PRAT Release();
+        void Adopt(PRAT& prat) noexcept;
+
         Number m_p;
         Number m_q;
     };
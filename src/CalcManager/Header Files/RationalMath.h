@@ -7,6 +7,23 @@
 
 namespace CalcEngine::RationalMath
 {
+    // Pow, Fact, Exp, Log and the trigonometric and hyperbolic functions keep
+    // their results for the inputs they were called with most recently. Like
+    // the rest of ratpak's state the cache is per thread, and it is keyed by
+    // the radix and precision of the constants as well, so ChangeConstants
+    // never leaves it handing out results worked out with other constants.
+    struct ResultCacheStatistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t invalidations; // times the constants changed under the cache and it had to be emptied
+        size_t size;
+    };
+
+    ResultCacheStatistics GetResultCacheStatistics();
+    void ClearResultCache(); // and the statistics with it
+
     Rational Frac(Rational const& rat);
     Rational Integer(Rational const& rat);
 
@@ -0,0 +1,547 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include "HistorySerializer.h"
+#include "ExpressionCommand.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    // Every blob starts with these, then the format version and what kind of data follows.
+    constexpr uint8_t c_signature[] = { 0xCA, 0x1C };
+
+    enum class PayloadKind : uint8_t
+    {
+        HistoryItem = 1,
+        History = 2,
+        Expression = 3
+    };
+
+    // Flags of an operand command.
+    constexpr uint8_t c_operandNegative = 0x1;
+    constexpr uint8_t c_operandDecimal = 0x2;
+    constexpr uint8_t c_operandSciFmt = 0x4;
+
+    constexpr uint32_t c_maxCodePoint = 0x10FFFF;
+    constexpr uint32_t c_replacementCharacter = 0xFFFD;
+
+    bool IsSurrogate(uint32_t codePoint)
+    {
+        return codePoint >= 0xD800 && codePoint <= 0xDFFF;
+    }
+
+    // Whether value[i] starts a UTF-16 surrogate pair, which can only happen where wchar_t is 16 bits.
+    bool IsSurrogatePair(wstring_view value, size_t i)
+    {
+        return sizeof(wchar_t) == 2 && value[i] >= 0xD800 && value[i] <= 0xDBFF && i + 1 < value.size() && value[i + 1] >= 0xDC00 && value[i + 1] <= 0xDFFF;
+    }
+
+    void WriteHeader(BinaryWriter& writer, PayloadKind kind)
+    {
+        for (uint8_t b : c_signature)
+        {
+            writer.WriteByte(b);
+        }
+        writer.WriteVarUInt(HistorySerializer::FormatVersion);
+        writer.WriteByte(static_cast<uint8_t>(kind));
+    }
+
+    bool TryReadHeader(BinaryReader& reader, PayloadKind kind)
+    {
+        for (uint8_t b : c_signature)
+        {
+            if (reader.ReadByte() != b)
+            {
+                return false;
+            }
+        }
+
+        // A newer format is not read at all, rather than read wrongly.
+        return reader.ReadVarUInt() == HistorySerializer::FormatVersion && reader.ReadByte() == static_cast<uint8_t>(kind) && !reader.Failed();
+    }
+
+    void WriteInts(BinaryWriter& writer, vector<int> const& values)
+    {
+        writer.WriteVarUInt(values.size());
+        for (int value : values)
+        {
+            writer.WriteVarInt(value);
+        }
+    }
+
+    bool TryReadInt(BinaryReader& reader, int& value)
+    {
+        int64_t wide = reader.ReadVarInt();
+        if (reader.Failed() || wide < numeric_limits<int>::min() || wide > numeric_limits<int>::max())
+        {
+            return false;
+        }
+
+        value = static_cast<int>(wide);
+        return true;
+    }
+
+    bool TryReadInts(BinaryReader& reader, vector<int>& values)
+    {
+        size_t count = reader.ReadCount();
+        values.resize(count);
+        for (int& value : values)
+        {
+            if (!TryReadInt(reader, value))
+            {
+                return false;
+            }
+        }
+
+        return !reader.Failed();
+    }
+
+    class BinarySerializeCommandVisitor final : public ISerializeCommandVisitor
+    {
+    public:
+        BinarySerializeCommandVisitor(BinaryWriter& writer)
+            : m_writer(writer)
+        {
+        }
+
+        void Visit(_In_ COpndCommand& opndCmd) override
+        {
+            uint8_t flags = (opndCmd.IsNegative() ? c_operandNegative : 0) | (opndCmd.IsDecimalPresent() ? c_operandDecimal : 0)
+                            | (opndCmd.IsSciFmt() ? c_operandSciFmt : 0);
+            m_writer.WriteByte(flags);
+            WriteInts(m_writer, *opndCmd.GetCommands());
+        }
+
+        void Visit(_In_ CUnaryCommand& unaryCmd) override
+        {
+            WriteInts(m_writer, *unaryCmd.GetCommands());
+        }
+
+        void Visit(_In_ CBinaryCommand& binaryCmd) override
+        {
+            m_writer.WriteVarInt(binaryCmd.GetCommand());
+        }
+
+        void Visit(_In_ CParentheses& paraCmd) override
+        {
+            m_writer.WriteVarInt(paraCmd.GetCommand());
+        }
+
+    private:
+        BinaryWriter& m_writer;
+    };
+
+    void WriteCommands(BinaryWriter& writer, vector<shared_ptr<IExpressionCommand>> const* commands)
+    {
+        if (commands == nullptr)
+        {
+            writer.WriteVarUInt(0);
+            return;
+        }
+
+        HistorySerializer::WriteCommands(writer, *commands);
+    }
+
+    shared_ptr<IExpressionCommand> ReadCommand(BinaryReader& reader)
+    {
+        int command;
+        switch (static_cast<CommandType>(reader.ReadVarUInt()))
+        {
+        case CommandType::OperandCommand:
+        {
+            uint8_t flags = reader.ReadByte();
+            auto commands = make_shared<vector<int>>();
+            if ((flags & ~(c_operandNegative | c_operandDecimal | c_operandSciFmt)) != 0 || !TryReadInts(reader, *commands))
+            {
+                return nullptr;
+            }
+            return make_shared<COpndCommand>(commands, (flags & c_operandNegative) != 0, (flags & c_operandDecimal) != 0, (flags & c_operandSciFmt) != 0);
+        }
+
+        case CommandType::UnaryCommand:
+        {
+            vector<int> commands;
+            if (!TryReadInts(reader, commands))
+            {
+                return nullptr;
+            }
+            if (commands.size() == 1)
+            {
+                return make_shared<CUnaryCommand>(commands[0]);
+            }
+            if (commands.size() == 2)
+            {
+                return make_shared<CUnaryCommand>(commands[0], commands[1]);
+            }
+            return nullptr;
+        }
+
+        case CommandType::BinaryCommand:
+            return TryReadInt(reader, command) ? make_shared<CBinaryCommand>(command) : nullptr;
+
+        case CommandType::Parentheses:
+            return TryReadInt(reader, command) ? make_shared<CParentheses>(command) : nullptr;
+
+        default:
+            return nullptr;
+        }
+    }
+
+    void WriteTokens(BinaryWriter& writer, vector<pair<wstring, int>> const* tokens)
+    {
+        if (tokens == nullptr)
+        {
+            writer.WriteVarUInt(0);
+            return;
+        }
+
+        writer.WriteVarUInt(tokens->size());
+        for (auto const& token : *tokens)
+        {
+            writer.WriteString(token.first);
+            writer.WriteVarInt(token.second);
+        }
+    }
+
+    bool TryReadTokens(BinaryReader& reader, vector<pair<wstring, int>>& tokens)
+    {
+        size_t count = reader.ReadCount();
+        tokens.clear();
+        tokens.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            wstring token = reader.ReadString();
+            int commandIndex;
+            if (!TryReadInt(reader, commandIndex))
+            {
+                return false;
+            }
+            tokens.emplace_back(move(token), commandIndex);
+        }
+
+        return !reader.Failed();
+    }
+
+    void WriteItem(BinaryWriter& writer, HISTORYITEM const& item)
+    {
+        HISTORYITEMVECTOR const& itemVector = item.historyItemVector;
+        WriteTokens(writer, itemVector.spTokens.get());
+        WriteCommands(writer, itemVector.spCommands.get());
+        writer.WriteString(itemVector.expression);
+        writer.WriteString(itemVector.result);
+    }
+
+    bool TryReadItem(BinaryReader& reader, HISTORYITEM& item)
+    {
+        HISTORYITEMVECTOR& itemVector = item.historyItemVector;
+        itemVector.spTokens = make_shared<vector<pair<wstring, int>>>();
+        itemVector.spCommands = make_shared<vector<shared_ptr<IExpressionCommand>>>();
+        if (!TryReadTokens(reader, *itemVector.spTokens) || !HistorySerializer::TryReadCommands(reader, *itemVector.spCommands))
+        {
+            return false;
+        }
+
+        itemVector.expression = reader.ReadString();
+        itemVector.result = reader.ReadString();
+        return !reader.Failed();
+    }
+
+    template <typename TWrite>
+    vector<uint8_t> SerializeToVector(TWrite write)
+    {
+        // Measure first, then write into a buffer of exactly that size.
+        size_t size = write(nullptr, 0);
+        vector<uint8_t> buffer(size);
+        write(buffer.data(), buffer.size());
+        return buffer;
+    }
+}
+
+BinaryWriter::BinaryWriter(_Out_ uint8_t* buffer, size_t capacity)
+    : m_buffer(buffer)
+    , m_capacity(buffer != nullptr ? capacity : 0)
+    , m_size(0)
+{
+}
+
+void BinaryWriter::WriteByte(uint8_t value)
+{
+    if (m_size < m_capacity)
+    {
+        m_buffer[m_size] = value;
+    }
+    m_size++;
+}
+
+void BinaryWriter::WriteVarUInt(uint64_t value)
+{
+    // Seven bits at a time, least significant first, with the high bit set on every byte but the last.
+    while (value >= 0x80)
+    {
+        WriteByte(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    WriteByte(static_cast<uint8_t>(value));
+}
+
+void BinaryWriter::WriteVarInt(int64_t value)
+{
+    WriteVarUInt((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void BinaryWriter::WriteString(wstring_view value)
+{
+    // Written as code points, so a surrogate pair is one value, and a surrogate on its own is written as the
+    // replacement character.
+    size_t count = 0;
+    for (size_t i = 0; i < value.size(); i++, count++)
+    {
+        if (IsSurrogatePair(value, i))
+        {
+            i++;
+        }
+    }
+
+    WriteVarUInt(count);
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        uint32_t codePoint = static_cast<uint32_t>(value[i]);
+        if (IsSurrogatePair(value, i))
+        {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (static_cast<uint32_t>(value[i + 1]) - 0xDC00);
+            i++;
+        }
+        else if (IsSurrogate(codePoint) || codePoint > c_maxCodePoint)
+        {
+            codePoint = c_replacementCharacter;
+        }
+
+        WriteVarUInt(codePoint);
+    }
+}
+
+BinaryReader::BinaryReader(_In_ uint8_t const* data, size_t size)
+    : m_current(data)
+    , m_end(data + size)
+    , m_failed(false)
+{
+}
+
+void BinaryReader::Fail()
+{
+    m_failed = true;
+    m_current = m_end;
+}
+
+uint8_t BinaryReader::ReadByte()
+{
+    if (m_current == m_end)
+    {
+        Fail();
+        return 0;
+    }
+
+    return *m_current++;
+}
+
+uint64_t BinaryReader::ReadVarUInt()
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        uint8_t b = ReadByte();
+        if (m_failed)
+        {
+            return 0;
+        }
+
+        // The tenth byte has room for only the top bit of the 64.
+        if (shift == 63 && b > 1)
+        {
+            break;
+        }
+
+        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    Fail();
+    return 0;
+}
+
+int64_t BinaryReader::ReadVarInt()
+{
+    uint64_t value = ReadVarUInt();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+size_t BinaryReader::ReadCount()
+{
+    uint64_t count = ReadVarUInt();
+    if (count > static_cast<uint64_t>(m_end - m_current))
+    {
+        Fail();
+        return 0;
+    }
+
+    return static_cast<size_t>(count);
+}
+
+wstring BinaryReader::ReadString()
+{
+    size_t count = ReadCount();
+
+    wstring value;
+    value.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t codePoint = ReadVarUInt();
+        if (codePoint > c_maxCodePoint || IsSurrogate(static_cast<uint32_t>(codePoint)))
+        {
+            Fail();
+        }
+        if (m_failed)
+        {
+            return {};
+        }
+
+        if (sizeof(wchar_t) == 2 && codePoint >= 0x10000)
+        {
+            codePoint -= 0x10000;
+            value.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+            value.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+        }
+        else
+        {
+            value.push_back(static_cast<wchar_t>(codePoint));
+        }
+    }
+
+    return value;
+}
+
+void HistorySerializer::WriteCommands(_In_ BinaryWriter& writer, _In_ vector<shared_ptr<IExpressionCommand>> const& commands)
+{
+    BinarySerializeCommandVisitor visitor(writer);
+    writer.WriteVarUInt(commands.size());
+    for (auto const& command : commands)
+    {
+        writer.WriteVarUInt(static_cast<uint64_t>(command->GetCommandType()));
+        command->Accept(visitor);
+    }
+}
+
+bool HistorySerializer::TryReadCommands(_In_ BinaryReader& reader, _Out_ vector<shared_ptr<IExpressionCommand>>& commands)
+{
+    size_t count = reader.ReadCount();
+    commands.clear();
+    commands.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto command = ReadCommand(reader);
+        if (command == nullptr)
+        {
+            return false;
+        }
+        commands.push_back(move(command));
+    }
+
+    return !reader.Failed();
+}
+
+size_t HistorySerializer::Serialize(_In_ HISTORYITEM const& item, _Out_ uint8_t* buffer, size_t capacity)
+{
+    BinaryWriter writer(buffer, capacity);
+    WriteHeader(writer, PayloadKind::HistoryItem);
+    WriteItem(writer, item);
+    return writer.Size();
+}
+
+size_t HistorySerializer::Serialize(_In_ vector<shared_ptr<HISTORYITEM>> const& history, _Out_ uint8_t* buffer, size_t capacity)
+{
+    BinaryWriter writer(buffer, capacity);
+    WriteHeader(writer, PayloadKind::History);
+    writer.WriteVarUInt(history.size());
+    for (auto const& item : history)
+    {
+        WriteItem(writer, *item);
+    }
+    return writer.Size();
+}
+
+size_t HistorySerializer::SerializeExpression(
+    _In_ vector<pair<wstring, int>> const& tokens,
+    _In_ vector<shared_ptr<IExpressionCommand>> const& commands,
+    _Out_ uint8_t* buffer,
+    size_t capacity)
+{
+    BinaryWriter writer(buffer, capacity);
+    WriteHeader(writer, PayloadKind::Expression);
+    WriteTokens(writer, &tokens);
+    WriteCommands(writer, commands);
+    return writer.Size();
+}
+
+vector<uint8_t> HistorySerializer::Serialize(_In_ HISTORYITEM const& item)
+{
+    return SerializeToVector([&item](uint8_t* buffer, size_t capacity) { return Serialize(item, buffer, capacity); });
+}
+
+vector<uint8_t> HistorySerializer::Serialize(_In_ vector<shared_ptr<HISTORYITEM>> const& history)
+{
+    return SerializeToVector([&history](uint8_t* buffer, size_t capacity) { return Serialize(history, buffer, capacity); });
+}
+
+bool HistorySerializer::TryDeserialize(_In_ uint8_t const* data, size_t size, _Out_ HISTORYITEM& item)
+{
+    BinaryReader reader(data, size);
+    return TryReadHeader(reader, PayloadKind::HistoryItem) && TryReadItem(reader, item) && reader.AtEnd();
+}
+
+bool HistorySerializer::TryDeserialize(_In_ uint8_t const* data, size_t size, _Out_ vector<shared_ptr<HISTORYITEM>>& history)
+{
+    history.clear();
+
+    BinaryReader reader(data, size);
+    if (!TryReadHeader(reader, PayloadKind::History))
+    {
+        return false;
+    }
+
+    size_t count = reader.ReadCount();
+    history.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        auto item = make_shared<HISTORYITEM>();
+        if (!TryReadItem(reader, *item))
+        {
+            history.clear();
+            return false;
+        }
+        history.push_back(move(item));
+    }
+
+    if (reader.Failed() || !reader.AtEnd())
+    {
+        history.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool HistorySerializer::TryDeserializeExpression(
+    _In_ uint8_t const* data,
+    size_t size,
+    _Out_ vector<pair<wstring, int>>& tokens,
+    _Out_ vector<shared_ptr<IExpressionCommand>>& commands)
+{
+    BinaryReader reader(data, size);
+    return TryReadHeader(reader, PayloadKind::Expression) && TryReadTokens(reader, tokens) && TryReadCommands(reader, commands) && reader.AtEnd();
+}
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "CalculatorHistory.h"
+
+namespace CalculationManager
+{
+    // Writes the varint encoding into a buffer the caller owns, and never allocates. Once the buffer is full it keeps
+    // counting, so Size() is what the whole write needs and a caller whose buffer was too small can grow it and
+    // write again.
+    class BinaryWriter final
+    {
+    public:
+        BinaryWriter(_Out_ uint8_t* buffer, size_t capacity);
+
+        void WriteByte(uint8_t value);
+        void WriteVarUInt(uint64_t value);
+        void WriteVarInt(int64_t value); // zigzag encoded, so small negative numbers stay short
+        void WriteString(std::wstring_view value);
+
+        size_t Size() const
+        {
+            return m_size;
+        }
+        bool Fits() const
+        {
+            return m_size <= m_capacity;
+        }
+
+    private:
+        uint8_t* const m_buffer;
+        const size_t m_capacity;
+        size_t m_size;
+    };
+
+    // Decodes straight out of the caller's buffer, without copying it. A read past the end or of a malformed value
+    // sets Failed(), after which every read returns zero or empty.
+    class BinaryReader final
+    {
+    public:
+        BinaryReader(_In_ uint8_t const* data, size_t size);
+
+        uint8_t ReadByte();
+        uint64_t ReadVarUInt();
+        int64_t ReadVarInt();
+        std::wstring ReadString();
+
+        // A count of elements that take at least a byte each, which can be no more than the bytes that are left.
+        size_t ReadCount();
+
+        bool Failed() const
+        {
+            return m_failed;
+        }
+        bool AtEnd() const
+        {
+            return m_current == m_end;
+        }
+
+    private:
+        uint8_t const* m_current;
+        uint8_t const* const m_end;
+        bool m_failed;
+
+        void Fail();
+    };
+
+    // A portable, versioned binary format for history items, the expression commands and tokens they are made of, and
+    // expression snapshots. Every integer is a varint, and strings are their code points, so the bytes are the same
+    // whatever the size of wchar_t or the byte order of the machine that wrote them.
+    //
+    // The Serialize functions return the number of bytes the data needs. When that is more than capacity, the buffer
+    // holds only the start of it and should be grown to that size.
+    class HistorySerializer final
+    {
+    public:
+        static constexpr uint32_t FormatVersion = 1;
+
+        static size_t Serialize(_In_ HISTORYITEM const& item, _Out_ uint8_t* buffer, size_t capacity);
+        static size_t Serialize(_In_ std::vector<std::shared_ptr<HISTORYITEM>> const& history, _Out_ uint8_t* buffer, size_t capacity);
+        static size_t SerializeExpression(
+            _In_ std::vector<std::pair<std::wstring, int>> const& tokens,
+            _In_ std::vector<std::shared_ptr<IExpressionCommand>> const& commands,
+            _Out_ uint8_t* buffer,
+            size_t capacity);
+
+        static std::vector<uint8_t> Serialize(_In_ HISTORYITEM const& item);
+        static std::vector<uint8_t> Serialize(_In_ std::vector<std::shared_ptr<HISTORYITEM>> const& history);
+
+        static bool TryDeserialize(_In_ uint8_t const* data, size_t size, _Out_ HISTORYITEM& item);
+        static bool TryDeserialize(_In_ uint8_t const* data, size_t size, _Out_ std::vector<std::shared_ptr<HISTORYITEM>>& history);
+        static bool TryDeserializeExpression(
+            _In_ uint8_t const* data,
+            size_t size,
+            _Out_ std::vector<std::pair<std::wstring, int>>& tokens,
+            _Out_ std::vector<std::shared_ptr<IExpressionCommand>>& commands);
+
+        // Just the encoding of a command list, for storage that frames it in its own way.
+        static void WriteCommands(_In_ BinaryWriter& writer, _In_ std::vector<std::shared_ptr<IExpressionCommand>> const& commands);
+        static bool TryReadCommands(_In_ BinaryReader& reader, _Out_ std::vector<std::shared_ptr<IExpressionCommand>>& commands);
+    };
+}
@@ -1,8 +1,31 @@
 #include "pch.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
 #include "NumberFormattingUtils.h"
 
 using namespace std;
 
+namespace
+{
+    // Copies what to_chars wrote, which is only ASCII, into the caller's buffer.
+    size_t Widen(const char* first, const char* last, _Out_ wchar_t* buffer, size_t capacity)
+    {
+        const size_t length = static_cast<size_t>(last - first);
+        copy_n(first, min(length, capacity), buffer);
+        return length;
+    }
+
+    template <typename... Format>
+    size_t FormatBuffered(double value, _Out_ wchar_t* buffer, size_t capacity, Format... format)
+    {
+        char chars[UnitConversionManager::NumberFormattingUtils::MAX_FORMATTED_LENGTH];
+        const auto result = to_chars(begin(chars), end(chars), value, format...);
+        assert(result.ec == errc{});
+        return Widen(chars, result.ptr, buffer, capacity);
+    }
+}
+
 namespace UnitConversionManager::NumberFormattingUtils
 {
     /// <summary>
@@ -11,34 +34,44 @@ namespace UnitConversionManager::NumberFormattingUtils
     /// <param name="number">number to trim</param>
     void TrimTrailingZeros(_Inout_ wstring& number)
     {
-        if (number.find(L'.') == wstring::npos)
+        number.resize(WithoutTrailingZeros(number).size());
+    }
+
+    /// <summary>
+    /// Returns the given input string without any trailing zeros or decimals
+    /// </summary>
+    /// <param name="number">number to trim</param>
+    wstring_view WithoutTrailingZeros(wstring_view number)
+    {
+        if (number.find(L'.') == wstring_view::npos)
         {
-            return;
+            return number;
         }
 
-        if (auto i = number.find_last_not_of(L'0'); i != wstring::npos)
+        if (auto i = number.find_last_not_of(L'0'); i != wstring_view::npos)
         {
-            number.erase(number.cbegin() + i + 1, number.cend());
+            number.remove_suffix(number.size() - i - 1);
         }
 
         if (number.back() == L'.')
         {
-            number.pop_back();
+            number.remove_suffix(1);
         }
+        return number;
     }
 
     /// <summary>
     /// Get number of digits (whole number part + decimal part)</summary>
     /// <param name="value">the number</param>
-    unsigned int GetNumberDigits(wstring value)
+    unsigned int GetNumberDigits(wstring_view value)
     {
-        TrimTrailingZeros(value);
+        value = WithoutTrailingZeros(value);
         unsigned int numberSignificantDigits = static_cast<unsigned int>(value.size());
-        if (value.find(L'.') != wstring::npos)
+        if (value.find(L'.') != wstring_view::npos)
         {
             --numberSignificantDigits;
         }
-        if (value.find(L'-') != wstring::npos)
+        if (value.find(L'-') != wstring_view::npos)
         {
             --numberSignificantDigits;
         }
@@ -60,11 +93,16 @@ namespace UnitConversionManager::NumberFormattingUtils
     /// <param name="numSignificant">unsigned int number of significant digits to round to</param>
     wstring RoundSignificantDigits(double num, unsigned int numSignificant)
     {
-        wstringstream out(wstringstream::out);
-        out << fixed;
-        out.precision(numSignificant);
-        out << num;
-        return out.str();
+        wchar_t buffer[MAX_FORMATTED_LENGTH];
+        const size_t length = FormatFixed(num, numSignificant, buffer, size(buffer));
+        if (length <= size(buffer))
+        {
+            return wstring(buffer, length);
+        }
+
+        wstring result(length, L'\0');
+        FormatFixed(num, numSignificant, result.data(), length);
+        return result;
     }
 
     /// <summary>
@@ -73,8 +111,44 @@ namespace UnitConversionManager::NumberFormattingUtils
     /// <param name="number">number to convert</param>
     wstring ToScientificNumber(double number)
     {
-        wstringstream out(wstringstream::out);
-        out << scientific << number;
-        return out.str();
+        wchar_t buffer[MAX_FORMATTED_LENGTH];
+        return wstring(buffer, FormatScientific(number, buffer, size(buffer)));
+    }
+
+    /// <summary>
+    /// Writes a number with the given count of decimals into the buffer
+    /// </summary>
+    /// <param name="value">number to write</param>
+    /// <param name="precision">count of decimals, the last of them rounded</param>
+    /// <param name="buffer">where the number is written, as much of it as fits</param>
+    /// <param name="capacity">size of the buffer</param>
+    size_t FormatFixed(double value, unsigned int precision, _Out_ wchar_t* buffer, size_t capacity)
+    {
+        if (precision <= MAX_BUFFERED_PRECISION)
+        {
+            return FormatBuffered(value, buffer, capacity, chars_format::fixed, static_cast<int>(precision));
+        }
+
+        string chars(MAX_FORMATTED_LENGTH - MAX_BUFFERED_PRECISION + precision, '\0');
+        const auto result = to_chars(chars.data(), chars.data() + chars.size(), value, chars_format::fixed, static_cast<int>(precision));
+        assert(result.ec == errc{});
+        return Widen(chars.data(), result.ptr, buffer, capacity);
+    }
+
+    /// <summary>
+    /// Writes a number in scientific notation with six decimals into the buffer
+    /// </summary>
+    size_t FormatScientific(double value, _Out_ wchar_t* buffer, size_t capacity)
+    {
+        return FormatBuffered(value, buffer, capacity, chars_format::scientific, 6);
+    }
+
+    /// <summary>
+    /// Writes the shortest form of a number that reads back as the same double into the buffer, in fixed or scientific
+    /// notation whichever is shorter
+    /// </summary>
+    size_t FormatShortest(double value, _Out_ wchar_t* buffer, size_t capacity)
+    {
+        return FormatBuffered(value, buffer, capacity);
     }
 }
@@ -3,14 +3,29 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
+#include <string_view>
 #include "sal_cross_platform.h"
 
 namespace UnitConversionManager::NumberFormattingUtils
 {
     void TrimTrailingZeros(_Inout_ std::wstring& input);
-    unsigned int GetNumberDigits(std::wstring value);
+    std::wstring_view WithoutTrailingZeros(std::wstring_view input);
+    unsigned int GetNumberDigits(std::wstring_view value);
     unsigned int GetNumberDigitsWholeNumberPart(double value);
     std::wstring RoundSignificantDigits(double value, unsigned int numberSignificantDigits);
     std::wstring ToScientificNumber(double number);
+
+    // Long enough for any double in scientific or shortest notation, and in fixed notation with up to
+    // MAX_BUFFERED_PRECISION decimals: a sign, 309 whole digits, the decimal point and the decimals.
+    constexpr unsigned int MAX_BUFFERED_PRECISION = 17;
+    constexpr size_t MAX_FORMATTED_LENGTH = 1 + (std::numeric_limits<double>::max_exponent10 + 1) + 1 + MAX_BUFFERED_PRECISION;
+
+    // These write a number into a buffer the caller owns, without a terminator, and return the number of characters it
+    // needs. When that is more than capacity, the buffer holds only the start of it. They round as RoundSignificantDigits
+    // and ToScientificNumber do, and only allocate for fixed notation with more than MAX_BUFFERED_PRECISION decimals.
+    size_t FormatFixed(double value, unsigned int precision, _Out_ wchar_t* buffer, size_t capacity);
+    size_t FormatScientific(double value, _Out_ wchar_t* buffer, size_t capacity); // six decimals, as ToScientificNumber
+    size_t FormatShortest(double value, _Out_ wchar_t* buffer, size_t capacity);   // the fewest digits that read back as value
 }
@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <utility>
+#include "ParallelBatchEvaluator.h"
+
+using namespace std;
+using namespace CalculationManager;
+
+namespace
+{
+    // Enough shards per worker that stealing can even out sequences of very different cost, but not so many that
+    // taking them costs more than running them.
+    constexpr size_t SHARDS_PER_WORKER = 8;
+    constexpr size_t MAX_SHARD_SIZE = 256;
+}
+
+ParallelBatchEvaluator::EngineSettings::EngineSettings(IResourceProvider& resourceProvider)
+    : m_decimal(resourceProvider.GetCEngineString(L"sDecimal"))
+    , m_thousand(resourceProvider.GetCEngineString(L"sThousand"))
+    , m_grouping(resourceProvider.GetCEngineString(L"sGrouping"))
+{
+}
+
+wstring ParallelBatchEvaluator::EngineSettings::GetCEngineString(wstring_view id)
+{
+    if (id == L"sDecimal")
+    {
+        return m_decimal;
+    }
+    if (id == L"sThousand")
+    {
+        return m_thousand;
+    }
+    if (id == L"sGrouping")
+    {
+        return m_grouping;
+    }
+
+    // The workers read the engine strings from the evaluator's own table.
+    return {};
+}
+
+ParallelBatchEvaluator::ParallelBatchEvaluator(_In_ IResourceProvider* resourceProvider, unsigned int workerCount)
+    : m_settings(*resourceProvider)
+    , m_engineStrings(CCalcEngine::CreateEngineStrings(*resourceProvider))
+    , m_generation(0)
+    , m_isStopping(false)
+    , m_sequences(nullptr)
+    , m_results(nullptr)
+    , m_remainingShards(0)
+    , m_stolenShards(0)
+    , m_statistics{}
+{
+    if (workerCount == 0)
+    {
+        workerCount = max(thread::hardware_concurrency(), 1u);
+    }
+
+    for (unsigned int i = 0; i < workerCount; i++)
+    {
+        m_workers.push_back(make_unique<Worker>());
+    }
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+        m_workers[i]->thread = thread(&ParallelBatchEvaluator::WorkerMain, this, i);
+    }
+}
+
+ParallelBatchEvaluator::~ParallelBatchEvaluator()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_workAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+/// <summary>
+/// Run every sequence as BatchEvaluator::Evaluate would, spread across the workers.
+/// </summary>
+/// <param name="sequences">independent command sequences, as they would be given to CalculatorManager::SendCommand</param>
+/// <remarks>If evaluating any of the sequences throws, the first exception is rethrown once the batch is done.</remarks>
+vector<BatchResult> ParallelBatchEvaluator::Evaluate(_In_ vector<vector<Command>> const& sequences)
+{
+    auto start = chrono::steady_clock::now();
+
+    vector<BatchResult> results(sequences.size());
+    size_t workerCount = m_workers.size();
+    size_t shardSize = clamp<size_t>(sequences.size() / (workerCount * SHARDS_PER_WORKER), 1, MAX_SHARD_SIZE);
+    size_t shardCount = (sequences.size() + shardSize - 1) / shardSize;
+
+    m_sequences = &sequences;
+    m_results = &results;
+    m_remainingShards = shardCount;
+    m_stolenShards = 0;
+    m_exception = nullptr;
+
+    for (auto& worker : m_workers)
+    {
+        lock_guard<mutex> lock(worker->mutex);
+        worker->sequenceCount = 0;
+    }
+
+    // Each worker starts on a contiguous run of the shards. One still looking for work from the last batch may start
+    // taking them straight away.
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        Worker& worker = *m_workers[i];
+        lock_guard<mutex> lock(worker.mutex);
+        for (size_t shard = i * shardCount / workerCount; shard < (i + 1) * shardCount / workerCount; shard++)
+        {
+            worker.shards.push_back({ shard * shardSize, min((shard + 1) * shardSize, sequences.size()) });
+        }
+    }
+
+    if (shardCount > 0)
+    {
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_generation++;
+        }
+        m_workAvailable.notify_all();
+
+        unique_lock<mutex> lock(m_mutex);
+        m_workDone.wait(lock, [this] { return m_remainingShards == 0; });
+    }
+
+    m_sequences = nullptr;
+    m_results = nullptr;
+    if (m_exception)
+    {
+        rethrow_exception(exchange(m_exception, nullptr));
+    }
+
+    m_statistics.sequenceCount = sequences.size();
+    m_statistics.commandCount = 0;
+    for (auto const& commands : sequences)
+    {
+        m_statistics.commandCount += commands.size();
+    }
+    m_statistics.shardCount = shardCount;
+    m_statistics.stolenShardCount = m_stolenShards;
+    m_statistics.sequencesPerWorker.clear();
+    for (auto const& worker : m_workers)
+    {
+        m_statistics.sequencesPerWorker.push_back(worker->sequenceCount);
+    }
+    m_statistics.elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+
+    return results;
+}
+
+void ParallelBatchEvaluator::WorkerMain(size_t index)
+{
+    // Made on this thread, so the engines and everything ratpak allocates for them stay on it.
+    CCalcEngine::SetThreadEngineStrings(m_engineStrings.get());
+    unique_ptr<BatchEvaluator> evaluator(new BatchEvaluator(&m_settings, false /* loadEngineStrings */));
+    Worker& worker = *m_workers[index];
+
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this, generation] { return m_isStopping || m_generation != generation; });
+            if (m_isStopping)
+            {
+                CCalcEngine::SetThreadEngineStrings(nullptr);
+                return;
+            }
+            generation = m_generation;
+        }
+
+        Shard shard;
+        while (TryTakeShard(index, shard))
+        {
+            for (size_t i = shard.begin; i < shard.end; i++)
+            {
+                try
+                {
+                    (*m_results)[i] = evaluator->Evaluate((*m_sequences)[i]);
+                }
+                catch (...)
+                {
+                    {
+                        lock_guard<mutex> lock(m_mutex);
+                        if (!m_exception)
+                        {
+                            m_exception = current_exception();
+                        }
+                    }
+
+                    // The engines may have been left part way through a command, so the next sequence gets new ones.
+                    evaluator.reset(new BatchEvaluator(&m_settings, false /* loadEngineStrings */));
+                }
+            }
+            worker.sequenceCount += shard.end - shard.begin;
+
+            if (--m_remainingShards == 0)
+            {
+                lock_guard<mutex> lock(m_mutex);
+                m_workDone.notify_one();
+            }
+        }
+    }
+}
+
+// Takes the next shard from the front of the worker's own queue, or steals one from the back of another's.
+bool ParallelBatchEvaluator::TryTakeShard(size_t index, Shard& shard)
+{
+    {
+        Worker& worker = *m_workers[index];
+        lock_guard<mutex> lock(worker.mutex);
+        if (!worker.shards.empty())
+        {
+            shard = worker.shards.front();
+            worker.shards.pop_front();
+            return true;
+        }
+    }
+
+    for (size_t i = 1; i < m_workers.size(); i++)
+    {
+        Worker& victim = *m_workers[(index + i) % m_workers.size()];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.shards.empty())
+        {
+            shard = victim.shards.back();
+            victim.shards.pop_back();
+            m_stolenShards++;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include "BatchEvaluator.h"
+#include "CalculatorResource.h"
+
+namespace CalculationManager
+{
+    // Counters for the last ParallelBatchEvaluator::Evaluate call.
+    struct BatchStatistics
+    {
+        size_t sequenceCount;
+        size_t commandCount;
+        size_t shardCount;
+        size_t stolenShardCount;                // shards a worker took from another worker's queue
+        std::vector<size_t> sequencesPerWorker; // how the sequences ended up spread across the workers
+        std::chrono::nanoseconds elapsed;
+    };
+
+    // Shards a large vector of independent command sequences across a pool of worker threads. Each worker owns a
+    // BatchEvaluator, and so its own engines and its own ratpak state, for as long as the pool lives. Workers start on
+    // their own share of the shards and steal from the others once it runs out. The results come back in the order of
+    // the sequences and are the same as a single BatchEvaluator gives. Every evaluator has its own copy of the engine
+    // strings, so evaluators made with different resource providers don't see each other's.
+    class ParallelBatchEvaluator final
+    {
+    public:
+        // A workerCount of 0 uses one worker per hardware thread.
+        ParallelBatchEvaluator(_In_ IResourceProvider* resourceProvider, unsigned int workerCount = 0);
+        ~ParallelBatchEvaluator();
+
+        std::vector<BatchResult> Evaluate(_In_ std::vector<std::vector<Command>> const& sequences);
+
+        BatchStatistics const& GetLastStatistics() const
+        {
+            return m_statistics;
+        }
+        size_t WorkerCount() const
+        {
+            return m_workers.size();
+        }
+
+    private:
+        // What an engine reads from its resource provider when it is created, read once up front so the workers never
+        // call into the caller's provider.
+        class EngineSettings final : public IResourceProvider
+        {
+        public:
+            EngineSettings(IResourceProvider& resourceProvider);
+            std::wstring GetCEngineString(std::wstring_view id) override;
+
+        private:
+            std::wstring m_decimal;
+            std::wstring m_thousand;
+            std::wstring m_grouping;
+        };
+
+        // The sequences [begin, end) of the current batch.
+        struct Shard
+        {
+            size_t begin;
+            size_t end;
+        };
+
+        struct Worker
+        {
+            std::thread thread;
+            std::mutex mutex; // guards shards, which other workers steal from the back of
+            std::deque<Shard> shards;
+            size_t sequenceCount;
+        };
+
+        EngineSettings m_settings;
+        std::unique_ptr<CCalcEngine::EngineStringTable const> m_engineStrings; // what the workers' engines read, never changed
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        std::mutex m_mutex; // guards m_generation, m_isStopping and m_exception
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_workDone;
+        uint64_t m_generation; // bumped for every batch, so idle workers know to look for shards
+        bool m_isStopping;
+
+        std::vector<std::vector<Command>> const* m_sequences;
+        std::vector<BatchResult>* m_results;
+        std::atomic<size_t> m_remainingShards;
+        std::atomic<size_t> m_stolenShards;
+        std::exception_ptr m_exception; // the first one a sequence of the current batch threw
+        BatchStatistics m_statistics;
+
+        void WorkerMain(size_t index);
+        bool TryTakeShard(size_t index, Shard& shard);
+    };
+}
@@ -0,0 +1,530 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//-----------------------------------------------------------------------------
+//  Package Title  ratpak
+//  File           alloc.cpp
+//
+//
+//  Description
+//
+//     Contains the allocator behind _createnum, _createrat and their destroy
+//  counterparts.  Nodes are handed out from size classed free lists, one class
+//  per mantissa length for the common small numbers and power of two classes
+//  for the larger ones.  While a ScratchArena is open, nodes are carved out of
+//  the arena instead and the whole region is released at once when the arena
+//  goes out of scope.
+//
+//  Every node is preceded by an ALLOCHDR recording where it came from, so a
+//  node can always be released correctly regardless of the mode that was
+//  active when it was allocated.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdlib> // for calloc, free
+#include <cstring> // for memset, memcpy
+#include "ratpak.h"
+
+using namespace std;
+
+typedef struct _allochdr
+{
+    uint32_t cls;   // Size class of the node, NOCLASS if it is not pooled.
+    uint32_t owner; // OWNER_SYSTEM, OWNER_POOL or OWNER_ARENA + arena depth.
+} ALLOCHDR, *PALLOCHDR;
+
+namespace
+{
+    constexpr uint32_t NOCLASS = UINT32_MAX;
+
+    constexpr uint32_t OWNER_SYSTEM = 0;
+    constexpr uint32_t OWNER_POOL = 1;
+    constexpr uint32_t OWNER_ARENA = 2;
+
+    // Nodes up to SMALLMAX bytes get a class per mantissa length, beyond that
+    // the classes double in size up to LARGEMAX bytes, anything larger goes
+    // straight to the system heap.
+    constexpr size_t SMALLDIGITS = 64;
+    constexpr size_t SMALLMAX = sizeof(NUMBER) + SMALLDIGITS * sizeof(MANTTYPE);
+    constexpr uint32_t SMALLCLASSES = static_cast<uint32_t>((SMALLMAX + sizeof(MANTTYPE) - 1) / sizeof(MANTTYPE)) + 1;
+    constexpr size_t LARGEMIN = 512;
+    constexpr size_t LARGEMAX = 64 * 1024;
+    constexpr uint32_t LARGECLASSES = 8; // 512 .. 64K
+    constexpr uint32_t NUMCLASSES = SMALLCLASSES + LARGECLASSES;
+
+    // Maximum number of free nodes kept per class, the rest go back to the heap.
+    constexpr uint32_t POOLDEPTH = 64;
+
+    // Arena chunks, and the largest node an arena will hand out.
+    constexpr size_t CHUNKSIZE = 64 * 1024;
+    constexpr size_t ARENAMAXNODE = 4 * 1024;
+    constexpr uint32_t MAXARENADEPTH = 8;
+
+    // Node headers and bump allocations are kept pointer aligned so the free
+    // list links can live in the body of a released node.
+    constexpr size_t NODEALIGN = sizeof(void*) > sizeof(ALLOCHDR) ? sizeof(void*) : sizeof(ALLOCHDR);
+    constexpr size_t HDRSIZE = (sizeof(ALLOCHDR) + NODEALIGN - 1) & ~(NODEALIGN - 1);
+
+    typedef struct _freenode
+    {
+        struct _freenode* next;
+    } FREENODE, *PFREENODE;
+
+    typedef struct _chunk
+    {
+        struct _chunk* next;
+    } CHUNK, *PCHUNK;
+
+    constexpr size_t CHUNKHDRSIZE = (sizeof(CHUNK) + NODEALIGN - 1) & ~(NODEALIGN - 1);
+
+    typedef struct _arena
+    {
+        PCHUNK chunks;             // Chunks owned by the arena, the first one is kept on release.
+        unsigned char* next;       // Bump pointer into the current chunk.
+        size_t remaining;          // Bytes left in the current chunk.
+        uint64_t clive;            // Nodes handed out and not yet destroyed.
+        PFREENODE free[NUMCLASSES]; // Nodes destroyed while the arena is open.
+    } ARENA, *PARENA;
+
+    // Each thread has an allocator of its own, a node released on another
+    // thread than the one it came from simply joins that thread's free list.
+    thread_local AllocatorMode s_mode = AllocatorMode::Pooled;
+    thread_local ALLOCSTATS s_stats{};
+
+    thread_local PFREENODE s_pool[NUMCLASSES];
+    thread_local uint32_t s_pooldepth[NUMCLASSES];
+
+    thread_local ARENA s_arenas[MAXARENADEPTH];
+    thread_local uint32_t s_arenadepth = 0;  // Number of ScratchArena objects currently open.
+    thread_local uint32_t s_bypassarena = 0; // Non zero while detaching nodes out of an arena.
+
+    uint32_t sizetoclass(size_t cb)
+    {
+        // A released node has to be able to hold its free list link.
+        cb = max(cb, sizeof(FREENODE));
+
+        if (cb <= SMALLMAX)
+        {
+            return static_cast<uint32_t>((cb + sizeof(MANTTYPE) - 1) / sizeof(MANTTYPE));
+        }
+
+        if (cb <= LARGEMAX)
+        {
+            uint32_t cls = SMALLCLASSES;
+            for (size_t cbclass = LARGEMIN; cbclass < cb; cbclass <<= 1)
+            {
+                cls++;
+            }
+            return cls;
+        }
+
+        return NOCLASS;
+    }
+
+    size_t classtosize(uint32_t cls)
+    {
+        if (cls < SMALLCLASSES)
+        {
+            return cls * sizeof(MANTTYPE);
+        }
+
+        return LARGEMIN << (cls - SMALLCLASSES);
+    }
+
+    void* nodebody(PALLOCHDR phdr)
+    {
+        return reinterpret_cast<unsigned char*>(phdr) + HDRSIZE;
+    }
+
+    PALLOCHDR nodeheader(void* p)
+    {
+        return reinterpret_cast<PALLOCHDR>(static_cast<unsigned char*>(p) - HDRSIZE);
+    }
+
+    void releasepool()
+    {
+        for (uint32_t cls = 0; cls < NUMCLASSES; cls++)
+        {
+            while (s_pool[cls] != nullptr)
+            {
+                PFREENODE pnode = s_pool[cls];
+                s_pool[cls] = pnode->next;
+                free(nodeheader(pnode));
+            }
+            s_pooldepth[cls] = 0;
+        }
+    }
+
+    // Releases every chunk but the first one, which is recycled by the next
+    // arena opened at the same depth.
+    void releasearena(ARENA& arena, bool keepfirst)
+    {
+        PCHUNK pkeep = nullptr;
+        while (arena.chunks != nullptr)
+        {
+            PCHUNK pchunk = arena.chunks;
+            arena.chunks = pchunk->next;
+            if (keepfirst && arena.chunks == nullptr)
+            {
+                pkeep = pchunk;
+            }
+            else
+            {
+                free(pchunk);
+            }
+        }
+
+        if (pkeep != nullptr)
+        {
+            pkeep->next = nullptr;
+        }
+        arena.chunks = pkeep;
+        arena.next = nullptr;
+        arena.remaining = 0;
+        arena.clive = 0;
+        memset(arena.free, 0, sizeof(arena.free));
+    }
+
+    // Gives the free lists and arena chunks of a thread back to the system
+    // when it exits, whatever is released after that is freed right away.
+    struct ALLOCATOROWNER
+    {
+        ~ALLOCATOROWNER()
+        {
+            s_mode = AllocatorMode::Calloc;
+            releasepool();
+            for (ARENA& arena : s_arenas)
+            {
+                releasearena(arena, false);
+            }
+        }
+    };
+
+    // Called whenever memory comes from the system, which is bound to happen
+    // before a thread has anything to give back.
+    void ownallocator()
+    {
+        thread_local ALLOCATOROWNER owner;
+    }
+
+    void noteallocation(uint64_t& counter)
+    {
+        counter++;
+        s_stats.cnodealloc++;
+        s_stats.cinuse++;
+        if (s_stats.cinuse > s_stats.cpeakinuse)
+        {
+            s_stats.cpeakinuse = s_stats.cinuse;
+        }
+    }
+
+    void* systemalloc(size_t cb, uint32_t cls, uint32_t owner)
+    {
+        ownallocator();
+        PALLOCHDR phdr = static_cast<PALLOCHDR>(calloc(1, HDRSIZE + cb));
+        if (phdr == nullptr)
+        {
+            throw(CALC_E_OUTOFMEMORY);
+        }
+        phdr->cls = cls;
+        phdr->owner = owner;
+        noteallocation(s_stats.csystemalloc);
+        return nodebody(phdr);
+    }
+
+    void* poolalloc(size_t cb, uint32_t cls)
+    {
+        PFREENODE pnode = s_pool[cls];
+        if (pnode == nullptr)
+        {
+            return systemalloc(classtosize(cls), cls, OWNER_POOL);
+        }
+
+        s_pool[cls] = pnode->next;
+        s_pooldepth[cls]--;
+        memset(pnode, 0, cb);
+        noteallocation(s_stats.cpoolhit);
+        return pnode;
+    }
+
+    void* arenaalloc(uint32_t depth, size_t cb, uint32_t cls)
+    {
+        ARENA& arena = s_arenas[depth];
+
+        PFREENODE pnode = arena.free[cls];
+        if (pnode != nullptr)
+        {
+            arena.free[cls] = pnode->next;
+            memset(pnode, 0, cb);
+        }
+        else
+        {
+            size_t cbnode = (HDRSIZE + classtosize(cls) + NODEALIGN - 1) & ~(NODEALIGN - 1);
+            if (arena.remaining < cbnode)
+            {
+                // The first chunk of an arena is kept around after release, so
+                // only grow when the existing chunk is exhausted.
+                PCHUNK pchunk = nullptr;
+                if (arena.chunks != nullptr && arena.next == nullptr)
+                {
+                    pchunk = arena.chunks;
+                }
+                else
+                {
+                    ownallocator();
+                    pchunk = static_cast<PCHUNK>(malloc(CHUNKSIZE));
+                    if (pchunk == nullptr)
+                    {
+                        throw(CALC_E_OUTOFMEMORY);
+                    }
+                    pchunk->next = arena.chunks;
+                    arena.chunks = pchunk;
+                }
+                arena.next = reinterpret_cast<unsigned char*>(pchunk) + CHUNKHDRSIZE;
+                arena.remaining = CHUNKSIZE - CHUNKHDRSIZE;
+            }
+
+            PALLOCHDR phdr = reinterpret_cast<PALLOCHDR>(arena.next);
+            arena.next += cbnode;
+            arena.remaining -= cbnode;
+            phdr->cls = cls;
+            phdr->owner = OWNER_ARENA + depth;
+            pnode = static_cast<PFREENODE>(nodebody(phdr));
+            memset(pnode, 0, cb);
+        }
+
+        arena.clive++;
+        noteallocation(s_stats.carenaalloc);
+        return pnode;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: zmalloc
+//
+//    ARGUMENTS: size of the node in bytes
+//
+//    RETURN: pointer to zeroed out memory
+//
+//    DESCRIPTION: allocates a NUMBER or RAT node, from the innermost open
+//    ScratchArena if there is one, otherwise from the free list of the
+//    node's size class. Falls back to calloc when the allocator mode is
+//    AllocatorMode::Calloc or the node is too large to be pooled.
+//
+//-----------------------------------------------------------------------------
+
+void* zmalloc(size_t cb)
+{
+    uint32_t cls = sizetoclass(cb);
+
+    if (s_mode == AllocatorMode::Calloc || cls == NOCLASS)
+    {
+        return systemalloc(cb, NOCLASS, OWNER_SYSTEM);
+    }
+
+    if (s_arenadepth > 0 && s_arenadepth <= MAXARENADEPTH && s_bypassarena == 0 && classtosize(cls) <= ARENAMAXNODE)
+    {
+        return arenaalloc(s_arenadepth - 1, cb, cls);
+    }
+
+    return poolalloc(cb, cls);
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: zfree
+//
+//    ARGUMENTS: pointer returned by zmalloc
+//
+//    RETURN: None
+//
+//    DESCRIPTION: returns a node to wherever it was allocated from. Arena
+//    nodes are only recycled within their arena, the memory itself goes
+//    away when the arena is closed.
+//
+//-----------------------------------------------------------------------------
+
+void zfree(_Frees_ptr_opt_ void* p)
+{
+    if (p == nullptr)
+    {
+        return;
+    }
+
+    PALLOCHDR phdr = nodeheader(p);
+    s_stats.cnodefree++;
+    s_stats.cinuse--;
+
+    if (phdr->owner >= OWNER_ARENA)
+    {
+        uint32_t depth = phdr->owner - OWNER_ARENA;
+        if (depth < s_arenadepth)
+        {
+            ARENA& arena = s_arenas[depth];
+            PFREENODE pnode = static_cast<PFREENODE>(p);
+            pnode->next = arena.free[phdr->cls];
+            arena.free[phdr->cls] = pnode;
+            arena.clive--;
+        }
+    }
+    else if (phdr->owner == OWNER_POOL && s_mode == AllocatorMode::Pooled && s_pooldepth[phdr->cls] < POOLDEPTH)
+    {
+        PFREENODE pnode = static_cast<PFREENODE>(p);
+        pnode->next = s_pool[phdr->cls];
+        s_pool[phdr->cls] = pnode;
+        s_pooldepth[phdr->cls]++;
+    }
+    else
+    {
+        free(phdr);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: detachnum, detachrat
+//
+//    ARGUMENTS: pointer to a number or rational
+//
+//    RETURN: None, changes the pointer if the value lives in an arena.
+//
+//    DESCRIPTION: moves a value allocated inside a ScratchArena out to the
+//    regular heap so it survives the arena being closed. Values that are
+//    not arena owned are left untouched.
+//
+//-----------------------------------------------------------------------------
+
+void detachnum(_Inout_ PNUMBER* pnum)
+{
+    if (*pnum != nullptr && nodeheader(*pnum)->owner >= OWNER_ARENA)
+    {
+        PNUMBER pnumret = nullptr;
+        s_bypassarena++;
+        try
+        {
+            createnum(pnumret, (*pnum)->cdigit);
+        }
+        catch (...)
+        {
+            s_bypassarena--;
+            throw;
+        }
+        s_bypassarena--;
+
+        _dupnum(pnumret, *pnum);
+        destroynum(*pnum);
+        *pnum = pnumret;
+    }
+}
+
+void detachrat(_Inout_ PRAT* prat)
+{
+    if (*prat != nullptr)
+    {
+        detachnum(&((*prat)->pp));
+        detachnum(&((*prat)->pq));
+        if (nodeheader(*prat)->owner >= OWNER_ARENA)
+        {
+            PRAT pratret = nullptr;
+            s_bypassarena++;
+            try
+            {
+                createrat(pratret);
+            }
+            catch (...)
+            {
+                s_bypassarena--;
+                throw;
+            }
+            s_bypassarena--;
+
+            pratret->pp = (*prat)->pp;
+            pratret->pq = (*prat)->pq;
+            zfree(*prat);
+            *prat = pratret;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//    ScratchArena
+//
+//    Opening an arena redirects every node allocation to the arena until it
+//    is closed again, at which point all of them are released together,
+//    including the ones that were never destroyed because an error was
+//    thrown half way through a calculation. Anything that has to outlive
+//    the arena must be passed through detachnum/detachrat first.
+//
+//-----------------------------------------------------------------------------
+
+ScratchArena::ScratchArena()
+{
+    s_arenadepth++;
+}
+
+ScratchArena::~ScratchArena()
+{
+    s_arenadepth--;
+    if (s_arenadepth < MAXARENADEPTH)
+    {
+        ARENA& arena = s_arenas[s_arenadepth];
+        s_stats.cbulkfree += arena.clive;
+        s_stats.cinuse -= arena.clive;
+        releasearena(arena, true);
+    }
+}
+
+void SetAllocatorMode(AllocatorMode mode)
+{
+    if (mode != s_mode)
+    {
+        s_mode = mode;
+        if (mode == AllocatorMode::Calloc)
+        {
+            releasepool();
+        }
+    }
+}
+
+AllocatorMode GetAllocatorMode()
+{
+    return s_mode;
+}
+
+ALLOCSTATS GetAllocatorStats()
+{
+    return s_stats;
+}
+
+void ResetAllocatorStats()
+{
+    uint64_t cinuse = s_stats.cinuse;
+    s_stats = {};
+    s_stats.cinuse = cinuse;
+    s_stats.cpeakinuse = cinuse;
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: TrimAllocator
+//
+//    ARGUMENTS: None
+//
+//    RETURN: None
+//
+//    DESCRIPTION: hands every cached free node and arena chunk back to the
+//    system heap. Arenas that are still open are left alone.
+//
+//-----------------------------------------------------------------------------
+
+void TrimAllocator()
+{
+    releasepool();
+    for (uint32_t depth = s_arenadepth; depth < MAXARENADEPTH; depth++)
+    {
+        releasearena(s_arenas[depth], false);
+    }
+}
@@ -89,17 +89,20 @@ void _mulnumx(PNUMBER* pa, PNUMBER b)
     int32_t iadigit = 0;  // Index of digit being used in the first number.
     int32_t ibdigit = 0;  // Index of digit being used in the second number.
     MANTTYPE da = 0;      // da is the digit from the fist number.
-    TWO_MANTTYPE cy = 0;  // cy is the carry resulting from the addition of
-                          // a multiplied row into the result.
-    TWO_MANTTYPE mcy = 0; // mcy is the resultant from a single
-                          // multiply, AND the carry of that multiply.
-    int32_t icdigit = 0;  // Index of digit being calculated in final result.
+    TWO_MANTTYPE cy = 0;  // cy is the product of two digits plus the digit
+                          // already in the result plus the carry, with full
+                          // BASEX digits that is at most 2^64-1.
+
+    if (mulnumlarge(pa, b, BASEX))
+    {
+        // Large enough for Karatsuba or Toom-3 to beat the loops below.
+        return;
+    }
 
     a = *pa;
 
-    ibdigit = a->cdigit + b->cdigit - 1;
-    createnum(c, ibdigit + 1);
-    c->cdigit = ibdigit;
+    createnum(c, a->cdigit + b->cdigit);
+    c->cdigit = a->cdigit + b->cdigit;
     c->sign = a->sign * b->sign;
 
     c->exp = a->exp + b->exp;
@@ -114,36 +117,21 @@ void _mulnumx(PNUMBER* pa, PNUMBER b)
         // Shift ptrc, and ptrcoffset, one for each digit
         ptrc = ptrcoffset++;
 
-        for (ibdigit = b->cdigit; ibdigit > 0; ibdigit--)
+        if (da == 0)
         {
-            cy = 0;
-            mcy = (uint64_t)da * (*ptrb);
-            if (mcy)
-            {
-                icdigit = 0;
-                if (ibdigit == 1 && iadigit == 1)
-                {
-                    c->cdigit++;
-                }
-            }
-
-            // If result is nonzero, or while result of carry is nonzero...
-            while (mcy || cy)
-            {
-                // update carry from addition(s) and multiply.
-                cy += (TWO_MANTTYPE)ptrc[icdigit] + ((uint32_t)mcy & ((uint32_t)~BASEX));
-
-                // update result digit from
-                ptrc[icdigit++] = (MANTTYPE)((uint32_t)cy & ((uint32_t)~BASEX));
-
-                // update carries from
-                mcy >>= BASEXPWR;
-                cy >>= BASEXPWR;
-            }
+            continue;
+        }
 
-            ptrb++;
-            ptrc++;
+        cy = 0;
+        for (ibdigit = b->cdigit; ibdigit > 0; ibdigit--)
+        {
+            cy += (TWO_MANTTYPE)da * (*ptrb++) + *ptrc;
+            *ptrc++ = (MANTTYPE)cy;
+            cy >>= BASEXPWR;
         }
+
+        // Nothing has been added this far up yet.
+        *ptrc = (MANTTYPE)cy;
     }
 
     // prevent different kinds of zeros, by stripping leading duplicate zeros.
@@ -284,6 +272,12 @@ void _divnumx(PNUMBER* pa, PNUMBER b, int32_t precision)
         thismax = b->cdigit;
     }
 
+    if (divnumlarge(pa, b, BASEX, thismax))
+    {
+        // Large enough for Newton's iteration to beat the loops below.
+        return;
+    }
+
     // Create c (the divide answer) and set up exponent and sign.
     createnum(c, thismax + 1);
     c->exp = (a->cdigit + a->exp) - (b->cdigit + b->exp) + 1;
@@ -298,7 +292,7 @@ void _divnumx(PNUMBER* pa, PNUMBER b, int32_t precision)
 
     while (cdigits++ < thismax && !zernum(rem))
     {
-        int32_t digit = 0;
+        TWO_MANTTYPE digit = 0; // a full BASEX digit, doubled once past it before backing up.
         *ptrc = 0;
         while (!lessnum(rem, b))
         {
@@ -326,7 +320,7 @@ void _divnumx(PNUMBER* pa, PNUMBER b, int32_t precision)
             addnum(&rem, tmp, BASEX);
             destroynum(tmp);
             destroynum(lasttmp);
-            *ptrc |= digit;
+            *ptrc |= static_cast<MANTTYPE>(digit);
         }
         rem->exp++;
         ptrc--;
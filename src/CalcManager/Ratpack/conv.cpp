@@ -18,6 +18,8 @@
 //---------------------------------------------------------------------------
 
 #include <algorithm>
+#include <cmath>
+#include <vector>
 #include "winerror_cross_platform.h"
 #include <sstream>
 #include <cstring> // for memmove, memcpy
@@ -32,9 +34,9 @@ static constexpr wstring_view DIGITS = L"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabc
 
 // ratio of internal 'digits' to output 'digits'
 // Calculated elsewhere as part of initialization and when base is changed
-int32_t g_ratio; // int(log(2L^BASEXPWR)/log(radix))
+thread_local int32_t g_ratio; // int(log(2L^BASEXPWR)/log(radix))
 // Default decimal separator
-wchar_t g_decimalSeparator = L'.';
+thread_local wchar_t g_decimalSeparator = L'.';
 
 // The following defines and Calc_ULong* functions were taken from
 // https://github.com/dotnet/coreclr/blob/8b1595b74c943b33fa794e63e440e6f4c9679478/src/pal/inc/rt/intsafe.h
@@ -98,6 +100,277 @@ namespace
 
         return Calc_ULongLongToULong(ull64Result, pulResult);
     }
+
+    // Threshold is in BASEX digits of the number converted, see
+    // SetConvThreshold. The Horner loops run in place and hold out to about
+    // a hundred digits.
+    thread_local int32_t s_convthreshold = 128;
+
+    // Bits in a digit of radix when radix is a power of two, 0 otherwise.
+    uint32_t bitsperdigit(uint64_t radix)
+    {
+        uint32_t bits = 0;
+        while ((uint64_t{ 1 } << bits) < radix)
+        {
+            bits++;
+        }
+        return ((uint64_t{ 1 } << bits) == radix) ? bits : 0;
+    }
+
+    // Digits of radix that fit in one BASEX digit, and radix to that power.
+    // The power is kept to half of BASEX, addnum needs the sum of two digits
+    // to fit a MANTTYPE in any radix other than BASEX.
+    uint32_t digitsperx(uint64_t radix, uint64_t* ppower)
+    {
+        uint32_t cdigits = 0;
+        uint64_t power = 1;
+        while (power * radix <= BASEX / 2)
+        {
+            power *= radix;
+            cdigits++;
+        }
+        *ppower = power;
+        return cdigits;
+    }
+
+    void stripleadingzeros(PNUMBER pnum)
+    {
+        while (pnum->cdigit > 1 && pnum->mant[pnum->cdigit - 1] == 0)
+        {
+            pnum->cdigit--;
+        }
+    }
+
+    PNUMBER createinteger(int32_t size)
+    {
+        PNUMBER pnumret = nullptr;
+        createnum(pnumret, size);
+        pnumret->sign = 1;
+        pnumret->exp = 0;
+        pnumret->cdigit = 1;
+        fill(pnumret->mant, pnumret->mant + size, 0);
+        return pnumret;
+    }
+
+    // The integer in the BASEX digits mant[0..cdigit) as a number in radix,
+    // which is a power of two with bits bits to the digit. Every digit is
+    // just a slice of the bits.
+    PNUMBER slicextonum(const MANTTYPE* mant, int32_t cdigit, uint64_t radix, uint32_t bits)
+    {
+        int32_t cout = (cdigit * BASEXPWR + bits - 1) / bits;
+        PNUMBER pnumret = createinteger(cout);
+        pnumret->cdigit = cout;
+        for (int32_t idigit = 0; idigit < cout; idigit++)
+        {
+            uint32_t bit = idigit * bits;
+            uint32_t ix = bit / BASEXPWR;
+            uint32_t shift = bit % BASEXPWR;
+            uint64_t window = mant[ix] >> shift;
+            if (shift + bits > BASEXPWR && static_cast<int32_t>(ix) + 1 < cdigit)
+            {
+                window |= static_cast<uint64_t>(mant[ix + 1]) << (BASEXPWR - shift);
+            }
+            pnumret->mant[idigit] = static_cast<MANTTYPE>(window & (radix - 1));
+        }
+        stripleadingzeros(pnumret);
+        return pnumret;
+    }
+
+    // The digits mant[0..cdigit) of radix, a power of two with bits bits to
+    // the digit, packed into BASEX digits.
+    PNUMBER packnumtox(const MANTTYPE* mant, int32_t cdigit, uint32_t bits)
+    {
+        int32_t cout = (cdigit * bits + BASEXPWR - 1) / BASEXPWR;
+        PNUMBER pnumret = createinteger(cout);
+        pnumret->cdigit = cout;
+        for (int32_t idigit = 0; idigit < cdigit; idigit++)
+        {
+            uint32_t bit = idigit * bits;
+            uint32_t ix = bit / BASEXPWR;
+            uint32_t shift = bit % BASEXPWR;
+            uint64_t window = static_cast<uint64_t>(mant[idigit]) << shift;
+            pnumret->mant[ix] |= static_cast<MANTTYPE>(window);
+            if (shift + bits > BASEXPWR)
+            {
+                pnumret->mant[ix + 1] |= static_cast<MANTTYPE>(window >> BASEXPWR);
+            }
+        }
+        stripleadingzeros(pnumret);
+        return pnumret;
+    }
+
+    // Groups the digits mant[0..cdigit) of radix cchunk at a time, into the
+    // digits of radix^cchunk.
+    PNUMBER groupdigits(const MANTTYPE* mant, int32_t cdigit, uint64_t radix, uint32_t cchunk)
+    {
+        int32_t cout = (cdigit + cchunk - 1) / cchunk;
+        PNUMBER pnumret = createinteger(cout);
+        pnumret->cdigit = cout;
+        for (int32_t ichunk = 0; ichunk < cout; ichunk++)
+        {
+            int32_t ilast = min<int32_t>((ichunk + 1) * cchunk, cdigit);
+            uint64_t chunk = 0;
+            for (int32_t idigit = ilast - 1; idigit >= ichunk * static_cast<int32_t>(cchunk); idigit--)
+            {
+                chunk = chunk * radix + mant[idigit];
+            }
+            pnumret->mant[ichunk] = static_cast<MANTTYPE>(chunk);
+        }
+        stripleadingzeros(pnumret);
+        return pnumret;
+    }
+
+    // The reverse of groupdigits, splits each digit of radix^cchunk into
+    // cchunk digits of radix.
+    PNUMBER ungroupdigits(PNUMBER pnum, uint64_t radix, uint32_t cchunk)
+    {
+        PNUMBER pnumret = createinteger(pnum->cdigit * cchunk);
+        pnumret->cdigit = pnum->cdigit * cchunk;
+        MANTTYPE* ptr = pnumret->mant;
+        for (int32_t ichunk = 0; ichunk < pnum->cdigit; ichunk++)
+        {
+            uint64_t chunk = pnum->mant[ichunk];
+            for (uint32_t idigit = 0; idigit < cchunk; idigit++)
+            {
+                *ptr++ = static_cast<MANTTYPE>(chunk % radix);
+                chunk /= radix;
+            }
+        }
+        stripleadingzeros(pnumret);
+        return pnumret;
+    }
+
+    // The integer in the BASEX digits mant[0..cdigit) as a number in radix,
+    // by Horner's rule from the MSD down, carried out in place.
+    PNUMBER hornerxtonum(const MANTTYPE* mant, int32_t cdigit, uint64_t radix)
+    {
+        PNUMBER pnumret = createinteger(static_cast<int32_t>(ceil(cdigit * BASEXPWR / log2(radix))) + 1);
+        for (const MANTTYPE* ptr = mant + cdigit - 1; ptr >= mant; ptr--)
+        {
+            TWO_MANTTYPE cy = *ptr;
+            for (int32_t idigit = 0; idigit < pnumret->cdigit; idigit++)
+            {
+                cy += static_cast<TWO_MANTTYPE>(pnumret->mant[idigit]) << BASEXPWR;
+                pnumret->mant[idigit] = static_cast<MANTTYPE>(cy % radix);
+                cy /= radix;
+            }
+            while (cy > 0)
+            {
+                pnumret->mant[pnumret->cdigit++] = static_cast<MANTTYPE>(cy % radix);
+                cy /= radix;
+            }
+        }
+        return pnumret;
+    }
+
+    // The digits mant[0..cdigit) of radix in BASEX, by Horner's rule from the
+    // MSD down, carried out in place.
+    PNUMBER hornernumtox(const MANTTYPE* mant, int32_t cdigit, uint64_t radix)
+    {
+        PNUMBER pnumret = createinteger(cdigit + 1);
+        for (const MANTTYPE* ptr = mant + cdigit - 1; ptr >= mant; ptr--)
+        {
+            TWO_MANTTYPE cy = *ptr;
+            for (int32_t ix = 0; ix < pnumret->cdigit; ix++)
+            {
+                cy += static_cast<TWO_MANTTYPE>(pnumret->mant[ix]) * radix;
+                pnumret->mant[ix] = static_cast<MANTTYPE>(cy);
+                cy >>= BASEXPWR;
+            }
+            if (cy > 0)
+            {
+                pnumret->mant[pnumret->cdigit++] = static_cast<MANTTYPE>(cy);
+            }
+        }
+        stripleadingzeros(pnumret);
+        return pnumret;
+    }
+
+    // Splits the BASEX digits in two at the largest power of two below
+    // cdigit, converts each half and puts them back together as hi *
+    // BASEX^half + lo in radix. ppowers[k] caches BASEX^(2^k) in radix.
+    PNUMBER splitxtonum(const MANTTYPE* mant, int32_t cdigit, uint64_t radix, vector<PNUMBER>& ppowers)
+    {
+        if (cdigit < s_convthreshold)
+        {
+            return hornerxtonum(mant, cdigit, radix);
+        }
+
+        size_t k = 0;
+        while ((int32_t{ 2 } << k) < cdigit)
+        {
+            k++;
+        }
+        while (ppowers.size() <= k)
+        {
+            PNUMBER power = nullptr;
+            if (ppowers.empty())
+            {
+                const MANTTYPE basex[] = { 0, 1 };
+                power = hornerxtonum(basex, 2, radix);
+            }
+            else
+            {
+                DUPNUM(power, ppowers.back());
+                mulnum(&power, ppowers.back(), radix);
+            }
+            ppowers.push_back(power);
+        }
+
+        int32_t half = int32_t{ 1 } << k;
+        PNUMBER hi = splitxtonum(mant + half, cdigit - half, radix, ppowers);
+        PNUMBER lo = splitxtonum(mant, half, radix, ppowers);
+        mulnum(&hi, ppowers[k], radix);
+        addnum(&hi, lo, radix);
+        destroynum(lo);
+        return hi;
+    }
+
+    // The reverse of splitxtonum, hi * radix^half + lo worked out in BASEX.
+    // ppowers[k] caches radix^(2^k) in BASEX.
+    PNUMBER splitnumtox(const MANTTYPE* mant, int32_t cdigit, uint64_t radix, vector<PNUMBER>& ppowers)
+    {
+        if (cdigit < s_convthreshold)
+        {
+            return hornernumtox(mant, cdigit, radix);
+        }
+
+        size_t k = 0;
+        while ((int32_t{ 2 } << k) < cdigit)
+        {
+            k++;
+        }
+        while (ppowers.size() <= k)
+        {
+            PNUMBER power = nullptr;
+            if (ppowers.empty())
+            {
+                power = Ui32tonum(static_cast<uint32_t>(radix), BASEX);
+            }
+            else
+            {
+                DUPNUM(power, ppowers.back());
+                mulnumx(&power, ppowers.back());
+            }
+            ppowers.push_back(power);
+        }
+
+        int32_t half = int32_t{ 1 } << k;
+        PNUMBER hi = splitnumtox(mant + half, cdigit - half, radix, ppowers);
+        PNUMBER lo = splitnumtox(mant, half, radix, ppowers);
+        mulnumx(&hi, ppowers[k]);
+        addnum(&hi, lo, BASEX);
+        destroynum(lo);
+        return hi;
+    }
+
+    void destroypowers(vector<PNUMBER>& ppowers)
+    {
+        for (PNUMBER& power : ppowers)
+        {
+            destroynum(power);
+        }
+    }
 }
 
 // Used to strip trailing zeros, and prevent combinatorial explosions
@@ -108,14 +381,6 @@ void SetDecimalSeparator(wchar_t decimalSeparator)
     g_decimalSeparator = decimalSeparator;
 }
 
-//
-// Windows heap allocation
-//
-void* zmalloc(size_t a)
-{
-    return calloc(a, sizeof(unsigned char));
-}
-
 //-----------------------------------------------------------------------------
 //
 //    FUNCTION: _dupnum
@@ -150,7 +415,7 @@ void _destroynum(_Frees_ptr_opt_ PNUMBER pnum)
 {
     if (pnum != nullptr)
     {
-        free(pnum);
+        zfree(pnum);
     }
 }
 
@@ -174,7 +439,7 @@ void _destroyrat(_Frees_ptr_opt_ PRAT prat)
     {
         destroynum(prat->pp);
         destroynum(prat->pq);
-        free(prat);
+        zfree(prat);
     }
 }
 
@@ -303,8 +568,9 @@ PRAT numtorat(_In_ PNUMBER pin, uint32_t radix)
 PNUMBER nRadixxtonum(_In_ PNUMBER a, uint32_t radix, int32_t precision)
 
 {
-    PNUMBER sum = i32tonum(0, radix);
-    PNUMBER powofnRadix = i32tonum(BASEX, radix);
+    // BASEX itself doesn't fit in 32 bits, so double half of it.
+    PNUMBER powofnRadix = Ui32tonum(BASEX / 2, radix);
+    addnum(&powofnRadix, powofnRadix, radix);
 
     // A large penalty is paid for conversion of digits no one will see anyway.
     // limit the digits to the minimum of the existing precision or the
@@ -318,18 +584,27 @@ PNUMBER nRadixxtonum(_In_ PNUMBER a, uint32_t radix, int32_t precision)
     // scale by the internal base to the internal exponent offset of the LSD
     numpowi32(&powofnRadix, a->exp + (a->cdigit - cdigits), radix, precision);
 
-    // Loop over all the relative digits from MSD to LSD
-    for (MANTTYPE* ptr = &(a->mant[a->cdigit - 1]); cdigits > 0; ptr--, cdigits--)
+    // Convert the relative digits from MSD to LSD. The digits of a power of
+    // two radix are just slices of the bits, anything else is converted in
+    // halves so the long numbers don't take quadratic time.
+    PNUMBER sum = nullptr;
+    MANTTYPE* ptr = &(a->mant[a->cdigit - cdigits]);
+    uint32_t bits = bitsperdigit(radix);
+    if (bits != 0)
     {
-        // Loop over all the bits from MSB to LSB
-        for (uint32_t bitmask = BASEX / 2; bitmask > 0; bitmask /= 2)
-        {
-            addnum(&sum, sum, radix);
-            if (*ptr & bitmask)
-            {
-                sum->mant[0] |= 1;
-            }
-        }
+        sum = slicextonum(ptr, cdigits, radix, bits);
+    }
+    else
+    {
+        // Worked out in the largest power of radix that fits a BASEX digit,
+        // and only then spread out into single digits.
+        uint64_t chunkradix;
+        uint32_t cchunk = digitsperx(radix, &chunkradix);
+        vector<PNUMBER> powers;
+        PNUMBER chunks = splitxtonum(ptr, cdigits, chunkradix, powers);
+        destroypowers(powers);
+        sum = ungroupdigits(chunks, radix, cchunk);
+        destroynum(chunks);
     }
 
     // Scale answer by power of internal exponent.
@@ -356,23 +631,25 @@ PNUMBER nRadixxtonum(_In_ PNUMBER a, uint32_t radix, int32_t precision)
 
 PNUMBER numtonRadixx(_In_ PNUMBER a, uint32_t radix)
 {
-    PNUMBER pnumret = i32tonum(0, BASEX); // pnumret is the number in internal form.
+    PNUMBER pnumret = nullptr; // pnumret is the number in internal form.
     PNUMBER num_radix = i32tonum(radix, BASEX);
-    MANTTYPE* ptrdigit = a->mant; // pointer to digit being worked on.
 
-    // Digits are in reverse order, back over them LSD first.
-    ptrdigit += a->cdigit - 1;
-
-    PNUMBER thisdigit = nullptr; // thisdigit holds the current digit of a
-    for (int32_t idigit = 0; idigit < a->cdigit; idigit++)
+    // Same as for nRadixxtonum, bits are packed for a power of two radix and
+    // anything else is converted in halves.
+    uint32_t bits = bitsperdigit(radix);
+    if (bits != 0)
+    {
+        pnumret = packnumtox(a->mant, a->cdigit, bits);
+    }
+    else
     {
-        mulnumx(&pnumret, num_radix);
-        // WARNING:
-        // This should just smack in each digit into a 'special' thisdigit.
-        // and not do the overhead of recreating the number type each time.
-        thisdigit = i32tonum(*ptrdigit--, BASEX);
-        addnum(&pnumret, thisdigit, BASEX);
-        destroynum(thisdigit);
+        uint64_t chunkradix;
+        uint32_t cchunk = digitsperx(radix, &chunkradix);
+        PNUMBER chunks = groupdigits(a->mant, a->cdigit, radix, cchunk);
+        vector<PNUMBER> powers;
+        pnumret = splitnumtox(chunks->mant, chunks->cdigit, chunkradix, powers);
+        destroypowers(powers);
+        destroynum(chunks);
     }
 
     // Calculate the exponent of the external base for scaling.
@@ -389,6 +666,16 @@ PNUMBER numtonRadixx(_In_ PNUMBER a, uint32_t radix)
     return (pnumret);
 }
 
+void SetConvThreshold(int32_t split)
+{
+    s_convthreshold = max(split, 2);
+}
+
+void GetConvThreshold(_Out_ int32_t* split)
+{
+    *split = s_convthreshold;
+}
+
 //-----------------------------------------------------------------------------
 //
 //  FUNCTION: StringToRat
@@ -802,11 +1089,12 @@ PRAT Ui32torat(uint32_t inui32)
 //
 //-----------------------------------------------------------------------------
 
-PNUMBER i32tonum(int32_t ini32, uint32_t radix)
+PNUMBER i32tonum(int32_t ini32, uint64_t radix)
 
 {
     MANTTYPE* pmant;
     PNUMBER pnumret = nullptr;
+    uint32_t ui32; // magnitude of ini32, INT32_MIN included.
 
     createnum(pnumret, MAX_LONG_SIZE);
     pmant = pnumret->mant;
@@ -815,19 +1103,20 @@ PNUMBER i32tonum(int32_t ini32, uint32_t radix)
     if (ini32 < 0)
     {
         pnumret->sign = -1;
-        ini32 *= -1;
+        ui32 = 0u - static_cast<uint32_t>(ini32);
     }
     else
     {
         pnumret->sign = 1;
+        ui32 = static_cast<uint32_t>(ini32);
     }
 
     do
     {
-        *pmant++ = (MANTTYPE)(ini32 % radix);
-        ini32 /= radix;
+        *pmant++ = (MANTTYPE)(ui32 % radix);
+        ui32 = (uint32_t)(ui32 / radix);
         pnumret->cdigit++;
-    } while (ini32);
+    } while (ui32);
 
     return (pnumret);
 }
@@ -846,7 +1135,7 @@ PNUMBER i32tonum(int32_t ini32, uint32_t radix)
 //
 //-----------------------------------------------------------------------------
 
-PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix)
+PNUMBER Ui32tonum(uint32_t ini32, uint64_t radix)
 {
     MANTTYPE* pmant;
     PNUMBER pnumret = nullptr;
@@ -860,7 +1149,7 @@ PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix)
     do
     {
         *pmant++ = (MANTTYPE)(ini32 % radix);
-        ini32 /= radix;
+        ini32 = (uint32_t)(ini32 / radix);
         pnumret->cdigit++;
     } while (ini32);
 
@@ -988,9 +1277,11 @@ uint64_t rattoUi64(_In_ PRAT prat, uint32_t radix, int32_t precision)
 //    base   claimed.
 //
 //-----------------------------------------------------------------------------
-int32_t numtoi32(_In_ PNUMBER pnum, uint32_t radix)
+int32_t numtoi32(_In_ PNUMBER pnum, uint64_t radix)
 {
-    int32_t lret = 0;
+    // Accumulate unsigned, a single BASEX digit already fills all 32 bits
+    // and rattoUi32 relies on getting those back unchanged.
+    uint32_t lret = 0;
 
     MANTTYPE* pmant = pnum->mant;
     pmant += pnum->cdigit - 1;
@@ -998,17 +1289,16 @@ int32_t numtoi32(_In_ PNUMBER pnum, uint32_t radix)
     int32_t expt = pnum->exp;
     for (int32_t length = pnum->cdigit; length > 0 && length + expt > 0; length--)
     {
-        lret *= radix;
+        lret = (uint32_t)(lret * radix);
         lret += *(pmant--);
     }
 
     while (expt-- > 0)
     {
-        lret *= radix;
+        lret = (uint32_t)(lret * radix);
     }
-    lret *= pnum->sign;
 
-    return lret;
+    return (int32_t)((pnum->sign < 0) ? 0u - lret : lret);
 }
 
 //-----------------------------------------------------------------------------
@@ -1193,73 +1483,74 @@ wstring NumberToString(_Inout_ PNUMBER& pnum, NumberFormat format, uint32_t radi
         eout = 0;
     }
 
-    // Begin building the result string
-    wstring result;
+    // Begin building the result string. Everything that can go into it is
+    // counted up front, a sign, a leading "0." and one more decimal point,
+    // the zeros either side of the digits and the exponent, so the digits
+    // are written straight into place.
+    int32_t cleadingzeros = max(-exponent, 0);
+    int32_t ctrailingzeros = max(exponent - length, 0);
+    wstring result(4 + cleadingzeros + max(length, 0) + ctrailingzeros + (useSciForm ? 2 + 32 : 0), L'0');
+    wchar_t* const pchstart = &result[0];
+    wchar_t* pch = pchstart;
 
     // Make sure negative zeros aren't allowed.
     if ((pnum->sign == -1) && (length > 0))
     {
-        result = L'-';
+        *pch++ = L'-';
     }
 
     if (exponent <= 0 && !useSciForm)
     {
-        result += L'0';
-        result += g_decimalSeparator;
+        *pch++ = L'0';
+        *pch++ = g_decimalSeparator;
         // Used up a digit unaccounted for.
     }
 
-    while (exponent < 0)
-    {
-        result += L'0';
-        exponent++;
-    }
+    // The string starts out all zeros.
+    pch += cleadingzeros;
+    exponent += cleadingzeros;
 
     while (length > 0)
     {
         exponent--;
-        result += DIGITS[*pmant--];
+        *pch++ = DIGITS[*pmant--];
         length--;
 
         // Be more regular in using a decimal point.
         if (exponent == 0)
         {
-            result += g_decimalSeparator;
+            *pch++ = g_decimalSeparator;
         }
     }
 
-    while (exponent > 0)
+    if (exponent > 0)
     {
-        result += L'0';
-        exponent--;
-        // Be more regular in using a decimal point.
-        if (exponent == 0)
-        {
-            result += g_decimalSeparator;
-        }
+        pch += exponent;
+        *pch++ = g_decimalSeparator;
     }
 
     if (useSciForm)
     {
-        result += (radix == 10 ? L'e' : L'^');
-        result += (eout < 0 ? L'-' : L'+');
+        *pch++ = (radix == 10 ? L'e' : L'^');
+        *pch++ = (eout < 0 ? L'-' : L'+');
         eout = abs(eout);
-        wstring expString{};
+        wchar_t* pchexp = pch;
         do
         {
-            expString += DIGITS[eout % radix];
+            *pch++ = DIGITS[eout % radix];
             eout /= radix;
         } while (eout > 0);
 
-        result.insert(result.end(), expString.crbegin(), expString.crend());
+        reverse(pchexp, pch);
     }
 
     // Remove trailing decimal
-    if (!result.empty() && result.back() == g_decimalSeparator)
+    if (pch != pchstart && *(pch - 1) == g_decimalSeparator)
     {
-        result.pop_back();
+        pch--;
     }
 
+    result.resize(pch - pchstart);
     return result;
 }
 
@@ -1285,6 +1576,8 @@ wstring NumberToString(_Inout_ PNUMBER& pnum, NumberFormat format, uint32_t radi
 //-----------------------------------------------------------------------------
 wstring RatToString(_Inout_ PRAT& prat, NumberFormat format, uint32_t radix, int32_t precision)
 {
+    // Everything allocated below is scratch, only the string survives.
+    ScratchArena arena;
     PNUMBER p = RatToNumber(prat, radix, precision);
 
     wstring result = NumberToString(p, format, radix, precision);
@@ -1466,7 +1759,7 @@ PNUMBER i32prodnum(int32_t start, int32_t stop, uint32_t radix)
 //
 //-----------------------------------------------------------------------------
 
-void numpowi32(_Inout_ PNUMBER* proot, int32_t power, uint32_t radix, int32_t precision)
+void numpowi32(_Inout_ PNUMBER* proot, int32_t power, uint64_t radix, int32_t precision)
 {
     PNUMBER lret = i32tonum(1, radix);
 
@@ -0,0 +1,292 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//-----------------------------------------------------------------------------
+//  Package Title  ratpak
+//  File           div.cpp
+//
+//
+//  Description
+//
+//     Contains the Newton iteration division used by _divnum and _divnumx
+//  once the divisor is large enough. Below the thresholds the long division
+//  loops in num.cpp and basex.cpp are cheaper and are still used.
+//
+//     The reciprocal of the divisor is refined by Newton's method, doubling
+//  the number of correct digits each step, so the cost is a small multiple of
+//  one multiplication and the Karatsuba and Toom-3 code in mul.cpp does the
+//  heavy lifting. The quotient is then corrected against the exact remainder,
+//  so the digits produced are the same as the long division produces.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include <cstring> // for memmove
+#include "ratpak.h"
+
+using namespace std;
+
+namespace
+{
+    // Thresholds are in digits of the divisor, see SetDivThresholds. The
+    // BASEX long division finds each digit by doubling, so it loses to
+    // Newton's iteration right away. The long division in other radixes
+    // holds out to a few hundred digits.
+    thread_local int32_t s_basexthreshold = 1;
+    thread_local int32_t s_radixthreshold = 900;
+
+    // Bits the first guess at the reciprocal is known to be good for.
+    constexpr int32_t GUESSBITS = 30;
+
+    void mulradix(PNUMBER* pa, PNUMBER b, uint64_t radix)
+    {
+        if (radix == BASEX)
+        {
+            mulnumx(pa, b);
+        }
+        else
+        {
+            mulnum(pa, b, radix);
+        }
+    }
+
+    // Keeps only the cdigits most significant digits of x.
+    void trimdigits(PNUMBER x, int32_t cdigits)
+    {
+        int32_t trim = x->cdigit - cdigits;
+        if (trim > 0)
+        {
+            memmove(x->mant, &(x->mant[trim]), sizeof(MANTTYPE) * cdigits);
+            x->cdigit = cdigits;
+            x->exp += trim;
+        }
+    }
+
+    // Drops the digits of x below the radix point.
+    void truncnum(PNUMBER x)
+    {
+        if (x->exp < 0)
+        {
+            int32_t drop = -x->exp;
+            if (drop >= x->cdigit)
+            {
+                x->mant[0] = 0;
+                x->cdigit = 1;
+            }
+            else
+            {
+                memmove(x->mant, &(x->mant[drop]), sizeof(MANTTYPE) * (x->cdigit - drop));
+                x->cdigit -= drop;
+            }
+            x->exp = 0;
+        }
+    }
+
+    // First guess at 1/b for b in [1/radix, 1), from the leading digits of b
+    // in double precision.
+    PNUMBER recipguess(PNUMBER b, uint64_t radix, double digitbits)
+    {
+        double v = 0;
+        double scale = 1;
+        for (int32_t i = b->cdigit - 1; i >= 0 && scale < 0x1p64; i--)
+        {
+            v = v * radix + b->mant[i];
+            scale *= radix;
+        }
+
+        // 1/b lies in (1, radix], a fraction of it is enough for the guess.
+        double w = scale / v;
+        int32_t cfrac = max(1, static_cast<int32_t>(45 / digitbits));
+        PNUMBER y = nullptr;
+        createnum(y, cfrac + 2);
+        y->sign = 1;
+        y->exp = -cfrac;
+        y->cdigit = cfrac + 1;
+
+        double ipart = floor(w);
+        if (ipart >= radix)
+        {
+            // b is exactly 1/radix
+            y->mant[cfrac + 1] = 1;
+            y->cdigit++;
+        }
+        else
+        {
+            y->mant[cfrac] = static_cast<MANTTYPE>(ipart);
+            double f = w - ipart;
+            for (int32_t i = cfrac - 1; i >= 0; i--)
+            {
+                f *= radix;
+                double d = floor(f);
+                y->mant[i] = static_cast<MANTTYPE>(d);
+                f -= d;
+            }
+        }
+
+        return y;
+    }
+}
+
+//----------------------------------------------------------------------------
+//
+//    FUNCTION: divnumlarge
+//
+//    ARGUMENTS: pointer to a number, a second number, the radix and the
+//    count of quotient digits wanted.
+//
+//    RETURN: true if *pa has been replaced by *pa / b, false if b is too
+//    small for this to pay off and the caller should divide them itself.
+//
+//    DESCRIPTION: Produces the same cdigits quotient digits the long
+//    division in _divnum and _divnumx produces, including stopping early
+//    when the division comes out exact, and normalizes the result the same
+//    way. Rather than digit by digit, the whole integer quotient
+//
+//        floor(|a| * radix^shift / |b|)
+//
+//    is computed at once from a Newton reciprocal of b, shift being chosen
+//    so that quotient has cdigits digits counting a possible leading zero.
+//
+//----------------------------------------------------------------------------
+
+bool divnumlarge(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix, int32_t cdigits)
+{
+    PNUMBER a = *pa;
+    if (b->cdigit < (radix == BASEX ? s_basexthreshold : s_radixthreshold) || zernum(a))
+    {
+        return false;
+    }
+
+    double digitbits = log2(static_cast<double>(radix));
+    PNUMBER one = i32tonum(1, radix);
+
+    // The integer divisor, and the divisor as a fraction in [1/radix, 1).
+    PNUMBER divisor = nullptr;
+    DUPNUM(divisor, b);
+    divisor->sign = 1;
+    divisor->exp = 0;
+    while (divisor->cdigit > 1 && divisor->mant[divisor->cdigit - 1] == 0)
+    {
+        divisor->cdigit--;
+    }
+    PNUMBER frac = nullptr;
+    DUPNUM(frac, divisor);
+    frac->exp = -frac->cdigit;
+
+    // The integer dividend, a shifted so that the quotient has cdigits digits.
+    PNUMBER dividend = nullptr;
+    DUPNUM(dividend, a);
+    dividend->sign = 1;
+    dividend->exp = b->cdigit - a->cdigit + cdigits - 1;
+
+    // Newton's iteration y += y * (1 - frac * y) roughly doubles the good
+    // bits each time, only carry the digits the next step can use.
+    PNUMBER y = recipguess(frac, radix, digitbits);
+    int32_t cbits = GUESSBITS;
+    int32_t ctargetbits = static_cast<int32_t>((cdigits + 2) * digitbits);
+    while (cbits < ctargetbits)
+    {
+        int32_t cgood = static_cast<int32_t>(cbits / digitbits);
+        cbits = min(2 * cbits - 2, ctargetbits);
+        int32_t cwork = static_cast<int32_t>(ceil(cbits / digitbits)) + 2;
+
+        PNUMBER err = nullptr;
+        DUPNUM(err, frac);
+        trimdigits(err, cwork);
+        mulradix(&err, y, radix);
+        err->sign *= -1;
+        addnum(&err, one, radix);
+
+        // err is below radix^-cgood, the digits past cwork don't matter.
+        trimdigits(err, max(cwork - cgood + 2, 1));
+        mulradix(&err, y, radix);
+        addnum(&y, err, radix);
+        trimdigits(y, cwork);
+        destroynum(err);
+    }
+
+    // Truncated quotient, off by a few units at most.
+    PNUMBER quot = nullptr;
+    DUPNUM(quot, dividend);
+    mulradix(&quot, y, radix);
+    quot->exp -= divisor->cdigit;
+    truncnum(quot);
+
+    // Correct it against the exact remainder.
+    PNUMBER rem = nullptr;
+    DUPNUM(rem, quot);
+    mulradix(&rem, divisor, radix);
+    rem->sign = -1;
+    addnum(&rem, dividend, radix);
+    while (rem->sign < 0 && !zernum(rem))
+    {
+        addnum(&rem, divisor, radix);
+        one->sign = -1;
+        addnum(&quot, one, radix);
+        one->sign = 1;
+    }
+    while (!zernum(rem) && !lessnum(rem, divisor))
+    {
+        divisor->sign = -1;
+        addnum(&rem, divisor, radix);
+        divisor->sign = 1;
+        addnum(&quot, one, radix);
+    }
+
+    // Place the digits where the long division would have, it writes out
+    // every low zero digit that the products above may have folded into exp.
+    if (quot->exp > 0)
+    {
+        PNUMBER shifted = nullptr;
+        createnum(shifted, quot->cdigit + quot->exp);
+        shifted->cdigit = quot->cdigit + quot->exp;
+        memcpy(&(shifted->mant[quot->exp]), quot->mant, sizeof(MANTTYPE) * quot->cdigit);
+        destroynum(quot);
+        quot = shifted;
+    }
+    quot->exp =(a->cdigit + a->exp) - (b->cdigit + b->exp) + 1 - cdigits;
+    quot->sign = a->sign * b->sign;
+    if (zernum(rem))
+    {
+        // The long division stops as soon as there is nothing left.
+        int32_t czero = 0;
+        while (czero < quot->cdigit - 1 && quot->mant[czero] == 0)
+        {
+            czero++;
+        }
+        if (czero > 0)
+        {
+            memmove(quot->mant, &(quot->mant[czero]), sizeof(MANTTYPE) * (quot->cdigit - czero));
+            quot->cdigit -= czero;
+            quot->exp += czero;
+        }
+    }
+    if (zernum(quot))
+    {
+        quot->exp = 0;
+    }
+
+    destroynum(y);
+    destroynum(rem);
+    destroynum(dividend);
+    destroynum(frac);
+    destroynum(divisor);
+    destroynum(one);
+
+    destroynum(*pa);
+    *pa = quot;
+    return true;
+}
+
+void SetDivThresholds(int32_t basex, int32_t radix)
+{
+    s_basexthreshold = max(basex, 1);
+    s_radixthreshold = max(radix, 1);
+}
+
+void GetDivThresholds(_Out_ int32_t* basex, _Out_ int32_t* radix)
+{
+    *basex = s_basexthreshold;
+    *radix = s_radixthreshold;
+}
@@ -42,6 +42,12 @@
 void _exprat(_Inout_ PRAT* px, int32_t precision)
 
 {
+    if (splitexprat(px, precision))
+    {
+        // Enough digits for binary splitting to beat the series below.
+        return;
+    }
+
     CREATETAYLOR();
 
     addnum(&(pret->pp), num_one, BASEX);
@@ -128,15 +134,22 @@ void exprat(_Inout_ PRAT* px, uint32_t radix, int32_t precision)
 void __lograt(PRAT* px, int32_t precision)
 
 {
-    CREATETAYLOR();
-
-    createrat(thisterm);
+    if (splitlograt(px, precision))
+    {
+        // Enough digits for binary splitting to beat the series below.
+        return;
+    }
 
-    // sub one from x
+    // sub one from x, before the taylor scratch arena is set up since *px
+    // has to outlive it.
     (*px)->pq->sign *= -1;
     addnum(&((*px)->pp), (*px)->pq, BASEX);
     (*px)->pq->sign *= -1;
 
+    CREATETAYLOR();
+
+    createrat(thisterm);
+
     DUPRAT(pret, *px);
     DUPRAT(thisterm, *px);
 
@@ -64,6 +64,12 @@ void ascalerat(_Inout_ PRAT* pa, AngleType angletype, int32_t precision)
 void _asinrat(PRAT* px, int32_t precision)
 
 {
+    if (splitasinrat(px, precision))
+    {
+        // Enough digits for binary splitting to beat the series below.
+        return;
+    }
+
     CREATETAYLOR();
     DUPRAT(pret, *px);
     DUPRAT(thisterm, *px);
@@ -259,6 +265,12 @@ void atananglerat(_Inout_ PRAT* pa, AngleType angletype, uint32_t radix, int32_t
 void _atanrat(PRAT* px, int32_t precision)
 
 {
+    if (splitatanrat(px, precision))
+    {
+        // Enough digits for binary splitting to beat the series below.
+        return;
+    }
+
     CREATETAYLOR();
 
     DUPRAT(pret, *px);
@@ -246,7 +246,8 @@ void modrat(_Inout_ PRAT* pa, _In_ PRAT b)
 
     if (needAdjust && !zerrat(*pa))
     {
-        _addrat(pa, b, BASEX);
+        // No precision was given, add exactly instead of trimming.
+        _addrat(pa, b, INT32_MAX);
     }
 
     // Get *pa back in the integer over integer form.
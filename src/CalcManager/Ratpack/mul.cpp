@@ -0,0 +1,474 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//-----------------------------------------------------------------------------
+//  Package Title  ratpak
+//  File           mul.cpp
+//
+//
+//  Description
+//
+//     Contains the subquadratic multiplication used by _mulnum and _mulnumx
+//  once both operands are large enough. Below the Karatsuba threshold the
+//  grade school loops in num.cpp and basex.cpp are faster and are still
+//  used, above the Toom-3 threshold the operands are split in three.
+//
+//     All of these compute the exact product, so the digits produced are the
+//  same whichever algorithm is picked.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <vector>
+#include "ratpak.h"
+
+using namespace std;
+
+namespace
+{
+    // Thresholds are in digits of the smaller operand, see SetMulThresholds.
+    // The defaults are the measured crossovers on x64, they are about the
+    // same for BASEX and for radix 10.
+    thread_local int32_t s_karatsubathreshold = 20;
+    thread_local int32_t s_toom3threshold = 200;
+
+    typedef vector<MANTTYPE> MANTVECTOR;
+
+    // Digit arithmetic for the internal BASEX radix, which is a power of two.
+    struct BinaryRadix
+    {
+        MANTTYPE low(TWO_MANTTYPE v) const
+        {
+            return static_cast<MANTTYPE>(v);
+        }
+        TWO_MANTTYPE high(TWO_MANTTYPE v) const
+        {
+            return v >> BASEXPWR;
+        }
+        TWO_MANTTYPE radix() const
+        {
+            return BASEX;
+        }
+    };
+
+    // Digit arithmetic for any other radix.
+    struct AnyRadix
+    {
+        TWO_MANTTYPE r;
+
+        MANTTYPE low(TWO_MANTTYPE v) const
+        {
+            return static_cast<MANTTYPE>(v % r);
+        }
+        TWO_MANTTYPE high(TWO_MANTTYPE v) const
+        {
+            return v / r;
+        }
+        TWO_MANTTYPE radix() const
+        {
+            return r;
+        }
+    };
+
+    size_t significant(const MANTTYPE* pa, size_t ca)
+    {
+        while (ca > 0 && pa[ca - 1] == 0)
+        {
+            ca--;
+        }
+        return ca;
+    }
+
+    // pc[0..cc) += pa[0..ca), the caller guarantees the sum fits in cc digits.
+    template <typename R>
+    void addto(MANTTYPE* pc, size_t cc, const MANTTYPE* pa, size_t ca, const R& r)
+    {
+        TWO_MANTTYPE cy = 0;
+        size_t i = 0;
+        for (; i < ca; i++)
+        {
+            cy += static_cast<TWO_MANTTYPE>(pc[i]) + pa[i];
+            pc[i] = r.low(cy);
+            cy = r.high(cy);
+        }
+        for (; cy != 0 && i < cc; i++)
+        {
+            cy += pc[i];
+            pc[i] = r.low(cy);
+            cy = r.high(cy);
+        }
+    }
+
+    // pc[0..cc) -= pa[0..ca), the caller guarantees the result is not negative.
+    template <typename R>
+    void subfrom(MANTTYPE* pc, size_t cc, const MANTTYPE* pa, size_t ca, const R& r)
+    {
+        MANTTYPE borrow = 0;
+        size_t i = 0;
+        for (; i < ca; i++)
+        {
+            TWO_MANTTYPE sub = static_cast<TWO_MANTTYPE>(pa[i]) + borrow;
+            if (pc[i] >= sub)
+            {
+                pc[i] = static_cast<MANTTYPE>(pc[i] - sub);
+                borrow = 0;
+            }
+            else
+            {
+                pc[i] = static_cast<MANTTYPE>(r.radix() + pc[i] - sub);
+                borrow = 1;
+            }
+        }
+        for (; borrow != 0 && i < cc; i++)
+        {
+            if (pc[i] != 0)
+            {
+                pc[i]--;
+                borrow = 0;
+            }
+            else
+            {
+                pc[i] = static_cast<MANTTYPE>(r.radix() - 1);
+            }
+        }
+    }
+
+    template <typename R>
+    void schoolbook(const MANTTYPE* pa, size_t ca, const MANTTYPE* pb, size_t cb, MANTTYPE* pc, const R& r)
+    {
+        for (size_t i = 0; i < ca; i++)
+        {
+            TWO_MANTTYPE da = pa[i];
+            if (da == 0)
+            {
+                continue;
+            }
+
+            TWO_MANTTYPE cy = 0;
+            MANTTYPE* pci = pc + i;
+            for (size_t j = 0; j < cb; j++)
+            {
+                cy += pci[j] + da * pb[j];
+                pci[j] = r.low(cy);
+                cy = r.high(cy);
+            }
+            pci[cb] = static_cast<MANTTYPE>(cy);
+        }
+    }
+
+    template <typename R>
+    void mulmant(const MANTTYPE* pa, size_t ca, const MANTTYPE* pb, size_t cb, MANTTYPE* pc, const R& r);
+
+    // Signed magnitude scratch values for the Toom-3 interpolation, digits are
+    // kept without leading zeros.
+    struct SIGNEDMANT
+    {
+        bool neg = false;
+        MANTVECTOR mant;
+    };
+
+    int cmpmant(const MANTVECTOR& a, const MANTVECTOR& b)
+    {
+        if (a.size() != b.size())
+        {
+            return a.size() < b.size() ? -1 : 1;
+        }
+        for (size_t i = a.size(); i-- > 0;)
+        {
+            if (a[i] != b[i])
+            {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    // a + (bneg ? -b : b)
+    template <typename R>
+    SIGNEDMANT addsigned(const SIGNEDMANT& a, const SIGNEDMANT& b, bool bneg, const R& r)
+    {
+        SIGNEDMANT x;
+        bool negb = (b.neg != bneg);
+        if (a.neg == negb)
+        {
+            x.neg = a.neg;
+            x.mant = a.mant.size() >= b.mant.size() ? a.mant : b.mant;
+            x.mant.push_back(0);
+            const MANTVECTOR& other = a.mant.size() >= b.mant.size() ? b.mant : a.mant;
+            addto(x.mant.data(), x.mant.size(), other.data(), other.size(), r);
+        }
+        else if (cmpmant(a.mant, b.mant) >= 0)
+        {
+            x.neg = a.neg;
+            x.mant = a.mant;
+            subfrom(x.mant.data(), x.mant.size(), b.mant.data(), b.mant.size(), r);
+        }
+        else
+        {
+            x.neg = negb;
+            x.mant = b.mant;
+            subfrom(x.mant.data(), x.mant.size(), a.mant.data(), a.mant.size(), r);
+        }
+        x.mant.resize(significant(x.mant.data(), x.mant.size()));
+        if (x.mant.empty())
+        {
+            x.neg = false;
+        }
+        return x;
+    }
+
+    template <typename R>
+    SIGNEDMANT mulsigned(const SIGNEDMANT& a, const SIGNEDMANT& b, const R& r)
+    {
+        SIGNEDMANT x;
+        if (!a.mant.empty() && !b.mant.empty())
+        {
+            x.mant.assign(a.mant.size() + b.mant.size(), 0);
+            mulmant(a.mant.data(), a.mant.size(), b.mant.data(), b.mant.size(), x.mant.data(), r);
+            x.mant.resize(significant(x.mant.data(), x.mant.size()));
+            x.neg = (a.neg != b.neg);
+        }
+        return x;
+    }
+
+    template <typename R>
+    SIGNEDMANT mulsmall(const SIGNEDMANT& a, MANTTYPE m, const R& r)
+    {
+        SIGNEDMANT x;
+        x.neg = a.neg;
+        x.mant.resize(a.mant.size() + 1);
+        TWO_MANTTYPE cy = 0;
+        for (size_t i = 0; i < a.mant.size(); i++)
+        {
+            cy += static_cast<TWO_MANTTYPE>(a.mant[i]) * m;
+            x.mant[i] = r.low(cy);
+            cy = r.high(cy);
+        }
+        x.mant.back() = static_cast<MANTTYPE>(cy);
+        x.mant.resize(significant(x.mant.data(), x.mant.size()));
+        return x;
+    }
+
+    // Division by a small number known to leave no remainder.
+    template <typename R>
+    SIGNEDMANT divexact(const SIGNEDMANT& a, MANTTYPE d, const R& r)
+    {
+        SIGNEDMANT x;
+        x.neg = a.neg;
+        x.mant.resize(a.mant.size());
+        TWO_MANTTYPE rem = 0;
+        for (size_t i = a.mant.size(); i-- > 0;)
+        {
+            rem = rem * r.radix() + a.mant[i];
+            x.mant[i] = static_cast<MANTTYPE>(rem / d);
+            rem %= d;
+        }
+        x.mant.resize(significant(x.mant.data(), x.mant.size()));
+        return x;
+    }
+
+    // Digits [offset, offset + len) of pa[0..ca), empty if they lie beyond ca.
+    SIGNEDMANT piece(const MANTTYPE* pa, size_t ca, size_t offset, size_t len)
+    {
+        SIGNEDMANT x;
+        if (offset < ca)
+        {
+            x.mant.assign(pa + offset, pa + offset + significant(pa + offset, min(len, ca - offset)));
+        }
+        return x;
+    }
+
+    // pc[offset..cc) += x, for a non negative x known to fit.
+    template <typename R>
+    void addat(MANTTYPE* pc, size_t cc, size_t offset, const SIGNEDMANT& x, const R& r)
+    {
+        if (!x.mant.empty())
+        {
+            addto(pc + offset, cc - offset, x.mant.data(), x.mant.size(), r);
+        }
+    }
+
+    // Toom-3, using the evaluation points 0, 1, -1, -2 and infinity and
+    // Bodrato's interpolation sequence.
+    template <typename R>
+    void toom3(const MANTTYPE* pa, size_t ca, const MANTTYPE* pb, size_t cb, MANTTYPE* pc, const R& r)
+    {
+        size_t k = (ca + 2) / 3;
+
+        SIGNEDMANT a0 = piece(pa, ca, 0, k);
+        SIGNEDMANT a1 = piece(pa, ca, k, k);
+        SIGNEDMANT a2 = piece(pa, ca, 2 * k, ca);
+        SIGNEDMANT b0 = piece(pb, cb, 0, k);
+        SIGNEDMANT b1 = piece(pb, cb, k, k);
+        SIGNEDMANT b2 = piece(pb, cb, 2 * k, cb);
+
+        // Evaluation
+        SIGNEDMANT ta = addsigned(a0, a2, false, r);
+        SIGNEDMANT tb = addsigned(b0, b2, false, r);
+        SIGNEDMANT pa1 = addsigned(ta, a1, false, r);
+        SIGNEDMANT pb1 = addsigned(tb, b1, false, r);
+        SIGNEDMANT pam1 = addsigned(ta, a1, true, r);
+        SIGNEDMANT pbm1 = addsigned(tb, b1, true, r);
+        SIGNEDMANT pam2 = addsigned(mulsmall(addsigned(pam1, a2, false, r), 2, r), a0, true, r);
+        SIGNEDMANT pbm2 = addsigned(mulsmall(addsigned(pbm1, b2, false, r), 2, r), b0, true, r);
+
+        // Pointwise products
+        SIGNEDMANT r0 = mulsigned(a0, b0, r);
+        SIGNEDMANT r1 = mulsigned(pa1, pb1, r);
+        SIGNEDMANT rm1 = mulsigned(pam1, pbm1, r);
+        SIGNEDMANT rm2 = mulsigned(pam2, pbm2, r);
+        SIGNEDMANT rinf = mulsigned(a2, b2, r);
+
+        // Interpolation
+        SIGNEDMANT s3 = divexact(addsigned(rm2, r1, true, r), 3, r);
+        SIGNEDMANT s1 = divexact(addsigned(r1, rm1, true, r), 2, r);
+        SIGNEDMANT s2 = addsigned(rm1, r0, true, r);
+        s3 = addsigned(divexact(addsigned(s2, s3, true, r), 2, r), mulsmall(rinf, 2, r), false, r);
+        s2 = addsigned(addsigned(s2, s1, false, r), rinf, true, r);
+        s1 = addsigned(s1, s3, true, r);
+
+        // Recomposition, all coefficients of the product are non negative.
+        size_t cc = ca + cb;
+        addat(pc, cc, 0, r0, r);
+        addat(pc, cc, k, s1, r);
+        addat(pc, cc, 2 * k, s2, r);
+        addat(pc, cc, 3 * k, s3, r);
+        addat(pc, cc, 4 * k, rinf, r);
+    }
+
+    // Karatsuba, ca >= cb > ceil(ca/2) is expected.
+    template <typename R>
+    void karatsuba(const MANTTYPE* pa, size_t ca, const MANTTYPE* pb, size_t cb, MANTTYPE* pc, const R& r)
+    {
+        size_t m = (ca + 1) / 2;
+        size_t ca1 = ca - m;
+        size_t cb1 = cb - m;
+        size_t cc = ca + cb;
+
+        // z0 = a0*b0 goes to the bottom of c, z2 = a1*b1 to the top.
+        mulmant(pa, m, pb, m, pc, r);
+        mulmant(pa + m, ca1, pb + m, cb1, pc + 2 * m, r);
+
+        // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+        MANTVECTOR sa(pa, pa + m);
+        MANTVECTOR sb(pb, pb + m);
+        sa.push_back(0);
+        sb.push_back(0);
+        addto(sa.data(), sa.size(), pa + m, ca1, r);
+        addto(sb.data(), sb.size(), pb + m, cb1, r);
+
+        MANTVECTOR z1(sa.size() + sb.size(), 0);
+        mulmant(sa.data(), sa.size(), sb.data(), sb.size(), z1.data(), r);
+        subfrom(z1.data(), z1.size(), pc, 2 * m, r);
+        subfrom(z1.data(), z1.size(), pc + 2 * m, ca1 + cb1, r);
+
+        addto(pc + m, cc - m, z1.data(), significant(z1.data(), z1.size()), r);
+    }
+
+    // Exact product of pa[0..ca) and pb[0..cb), pc[0..ca+cb) has to be zeroed.
+    template <typename R>
+    void mulmant(const MANTTYPE* pa, size_t ca, const MANTTYPE* pb, size_t cb, MANTTYPE* pc, const R& r)
+    {
+        size_t cctotal = ca + cb;
+        ca = significant(pa, ca);
+        cb = significant(pb, cb);
+        if (ca < cb)
+        {
+            swap(pa, pb);
+            swap(ca, cb);
+        }
+
+        if (cb == 0)
+        {
+            return;
+        }
+
+        if (cb < static_cast<size_t>(s_karatsubathreshold))
+        {
+            schoolbook(pa, ca, pb, cb, pc, r);
+        }
+        else if (ca > 2 * cb || (cb >= static_cast<size_t>(s_toom3threshold) && 3 * cb <= 2 * ca))
+        {
+            // Unbalanced, multiply b by cb sized slices of a.
+            MANTVECTOR slice(2 * cb, 0);
+            for (size_t offset = 0; offset < ca; offset += cb)
+            {
+                size_t cslice = min(cb, ca - offset);
+                fill(slice.begin(), slice.end(), 0);
+                mulmant(pa + offset, cslice, pb, cb, slice.data(), r);
+                addto(pc + offset, cctotal - offset, slice.data(), significant(slice.data(), cslice + cb), r);
+            }
+        }
+        else if (cb >= static_cast<size_t>(s_toom3threshold))
+        {
+            toom3(pa, ca, pb, cb, pc, r);
+        }
+        else
+        {
+            karatsuba(pa, ca, pb, cb, pc, r);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+//
+//    FUNCTION: mulnumlarge
+//
+//    ARGUMENTS: pointer to a number, a second number and the radix.
+//
+//    RETURN: true if *pa has been replaced by *pa * b, false if the numbers
+//    are too small for this to pay off and the caller should multiply them
+//    itself.
+//
+//    DESCRIPTION: Picks Karatsuba or Toom-3 depending on the size of the
+//    smaller operand. The result is normalized the same way _mulnum and
+//    _mulnumx normalize theirs.
+//
+//----------------------------------------------------------------------------
+
+bool mulnumlarge(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix)
+{
+    PNUMBER a = *pa;
+    if (min(a->cdigit, b->cdigit) < s_karatsubathreshold)
+    {
+        return false;
+    }
+
+    PNUMBER c = nullptr;
+    createnum(c, a->cdigit + b->cdigit);
+    c->cdigit = a->cdigit + b->cdigit;
+    c->sign = a->sign * b->sign;
+    c->exp = a->exp + b->exp;
+
+    if (radix == BASEX)
+    {
+        mulmant(a->mant, a->cdigit, b->mant, b->cdigit, c->mant, BinaryRadix{});
+    }
+    else
+    {
+        mulmant(a->mant, a->cdigit, b->mant, b->cdigit, c->mant, AnyRadix{ radix });
+    }
+
+    // prevent different kinds of zeros, by stripping leading duplicate zeros.
+    while (c->cdigit > 1 && c->mant[c->cdigit - 1] == 0)
+    {
+        c->cdigit--;
+    }
+
+    destroynum(*pa);
+    *pa = c;
+    return true;
+}
+
+void SetMulThresholds(int32_t karatsuba, int32_t toom3)
+{
+    // Karatsuba needs at least two digits to split, Toom-3 three.
+    s_karatsubathreshold = max(karatsuba, 2);
+    s_toom3threshold = max(toom3, 3);
+}
+
+void GetMulThresholds(_Out_ int32_t* karatsuba, _Out_ int32_t* toom3)
+{
+    *karatsuba = s_karatsubathreshold;
+    *toom3 = s_toom3threshold;
+}
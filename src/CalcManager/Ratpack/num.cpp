@@ -23,6 +23,22 @@
 
 using namespace std;
 
+namespace
+{
+    // Split a digit sum into the digit to keep and the carry. BASEX needs no
+    // divide at all, and the sums in any external radix fit in a MANTTYPE so
+    // a 32 bit divide will do for those.
+    MANTTYPE digitof(TWO_MANTTYPE cy, uint64_t radix)
+    {
+        return (radix == BASEX) ? (MANTTYPE)cy : (MANTTYPE)cy % (MANTTYPE)radix;
+    }
+
+    TWO_MANTTYPE carryof(TWO_MANTTYPE cy, uint64_t radix)
+    {
+        return (radix == BASEX) ? (cy >> BASEXPWR) : (MANTTYPE)cy / (MANTTYPE)radix;
+    }
+}
+
 //----------------------------------------------------------------------------
 //
 //    FUNCTION: addnum
@@ -41,9 +57,9 @@ using namespace std;
 //
 //----------------------------------------------------------------------------
 
-void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix);
+void _addnum(PNUMBER* pa, PNUMBER b, uint64_t radix);
 
-void addnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix)
+void addnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix)
 
 {
     if (b->cdigit > 1 || b->mant[0] != 0)
@@ -59,7 +75,7 @@ void addnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix)
     }
 }
 
-void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
+void _addnum(PNUMBER* pa, PNUMBER b, uint64_t radix)
 
 {
     PNUMBER c = nullptr; // c will contain the result.
@@ -71,7 +87,7 @@ void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
     int32_t mexp;        // mexp is the exponent of the result.
     MANTTYPE da;         // da is a single 'digit' after possible padding.
     MANTTYPE db;         // db is a single 'digit' after possible padding.
-    MANTTYPE cy = 0;     // cy is the value of a carry after adding two 'digits'
+    TWO_MANTTYPE cy = 0; // cy is the value of a carry after adding two 'digits'
     int32_t fcompla = 0; // fcompla is a flag to signal a is negative.
     int32_t fcomplb = 0; // fcomplb is a flag to signal b is negative.
 
@@ -110,23 +126,24 @@ void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
         // haven't found it yet.
         if (fcompla)
         {
-            da = (MANTTYPE)(radix)-1 - da;
+            da = (MANTTYPE)(radix - 1 - da);
         }
         if (fcomplb)
         {
-            db = (MANTTYPE)(radix)-1 - db;
+            db = (MANTTYPE)(radix - 1 - db);
         }
 
-        // Update carry as necessary
-        cy = da + db + cy;
-        *pchc++ = (MANTTYPE)(cy % (MANTTYPE)radix);
-        cy /= (MANTTYPE)radix;
+        // Update carry as necessary, two full BASEX digits and a carry need
+        // all of TWO_MANTTYPE.
+        cy = (TWO_MANTTYPE)da + db + cy;
+        *pchc++ = digitof(cy, radix);
+        cy = carryof(cy, radix);
     }
 
     // Handle carry from last sum as extra digit
     if (cy && !(fcompla || fcomplb))
     {
-        *pchc++ = cy;
+        *pchc++ = (MANTTYPE)cy;
         c->cdigit++;
     }
 
@@ -151,9 +168,9 @@ void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
             cy = 1;
             for ((cdigits = c->cdigit), (pchc = c->mant); cdigits > 0; cdigits--)
             {
-                cy = (MANTTYPE)radix - (MANTTYPE)1 - *pchc + cy;
-                *pchc++ = (MANTTYPE)(cy % (MANTTYPE)radix);
-                cy /= (MANTTYPE)radix;
+                cy = radix - 1 - *pchc + cy;
+                *pchc++ = digitof(cy, radix);
+                cy = carryof(cy, radix);
             }
         }
     }
@@ -183,9 +200,9 @@ void _addnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
 //
 //----------------------------------------------------------------------------
 
-void _mulnum(PNUMBER* pa, PNUMBER b, uint32_t radix);
+void _mulnum(PNUMBER* pa, PNUMBER b, uint64_t radix);
 
-void mulnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix)
+void mulnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix)
 
 {
     if (b->cdigit > 1 || b->mant[0] != 1 || b->exp != 0)
@@ -207,7 +224,7 @@ void mulnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix)
     }
 }
 
-void _mulnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
+void _mulnum(PNUMBER* pa, PNUMBER b, uint64_t radix)
 
 {
     PNUMBER c = nullptr;  // c will contain the result.
@@ -226,6 +243,12 @@ void _mulnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
                           // multiply, AND the carry of that multiply.
     int32_t icdigit = 0;  // Index of digit being calculated in final result.
 
+    if (mulnumlarge(pa, b, radix))
+    {
+        // Large enough for Karatsuba or Toom-3 to beat the loops below.
+        return;
+    }
+
     a = *pa;
     ibdigit = a->cdigit + b->cdigit - 1;
     createnum(c, ibdigit + 1);
@@ -301,7 +324,7 @@ void _mulnum(PNUMBER* pa, PNUMBER b, uint32_t radix)
 //
 //----------------------------------------------------------------------------
 
-void remnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix)
+void remnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix)
 
 {
     PNUMBER tmp = nullptr;     // tmp is the working remainder.
@@ -392,6 +415,12 @@ void _divnum(PNUMBER* pa, PNUMBER b, uint32_t radix, int32_t precision)
         thismax = b->cdigit;
     }
 
+    if (divnumlarge(pa, b, radix, thismax))
+    {
+        // Large enough for Newton's iteration to beat the loops below.
+        return;
+    }
+
     PNUMBER c = nullptr;
     createnum(c, thismax + 1);
     c->exp = (a->cdigit + a->exp) - (b->cdigit + b->exp) + 1;
@@ -577,10 +606,10 @@ bool lessnum(_In_ PNUMBER a, _In_ PNUMBER b)
     {
         MANTTYPE da = ((cdigits > (ccdigits - a->cdigit)) ? *pa-- : 0);
         MANTTYPE db = ((cdigits > (ccdigits - b->cdigit)) ? *pb-- : 0);
-        diff = da - db;
-        if (diff)
+        if (da != db)
         {
-            return (diff < 0);
+            // Full BASEX digits don't fit a signed difference.
+            return (da < db);
         }
     }
     // In this case, they are equal.
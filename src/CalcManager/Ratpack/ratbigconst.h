@@ -0,0 +1,90 @@
+﻿// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+// The constants whose value depends on the precision, to BIGCONSTBITS bits
+// past the binary point. Each one is its NUMBER over init_big_denominator,
+// 2^BIGCONSTBITS, and is good for the last bit. ChangeConstants trims them to
+// the precision asked for as long as that is well under BIGCONSTBITS, which
+// covers a bit over 500 decimal digits.
+//
+// The mantissas are the integer parts of c*2^BIGCONSTBITS, worked out with
+// exact integer arithmetic from
+//     pi = 16*atan(1/5) - 4*atan(1/239)
+//     e = sum(1/k!)
+//     ln(2) = 2*atanh(1/3)
+//     ln(10) = 3*ln(2) + 2*atanh(1/9)
+
+inline constexpr int32_t BIGCONSTBITS = 1792;
+
+inline const NUMBER init_big_denominator = { 1, 1, BIGCONSTBITS / BASEXPWR, { 1 } };
+
+inline const NUMBER init_big_pi = { 1,
+                                    57,
+                                    0,
+                                    {
+                                        0xAA55AB94, 0xE65525F3, 0x55605C60, 0x78AF2FDA, 0xBD314B27, 0xD71577C1, 0xB01E8A3E, 0x6C9E0E8B,
+                                        0x603A180E, 0x8E79DCB0, 0xB8DB38EF, 0xCA417918, 0x286085F0, 0xC5D1B023, 0x2AF26013, 0x9C30D539,
+                                        0xC25A59B5, 0x7B54A41D, 0x82154AEE, 0x718BCD58, 0x728EB658, 0x0D95748F, 0xF4933D7E, 0xA458FEA3,
+                                        0x71574E69, 0x636920D8, 0x858EFC16, 0x0801F2E2, 0xB3916CF7, 0x24A19947, 0xF12C7F99, 0xBA7C9045,
+                                        0x6A267E96, 0xB8E1AFED, 0xD01ADFB7, 0x2FFD72DB, 0x98DFB5AC, 0xD1310BA6, 0x8979FB1B, 0x9216D5D9,
+                                        0xB5470917, 0x3F84D5B5, 0xC97C50DD, 0xC0AC29B7, 0x34E90C6C, 0xBE5466CF, 0x38D01377, 0x452821E6,
+                                        0xEC4E6C89, 0x082EFA98, 0x299F31D0, 0xA4093822, 0x03707344, 0x13198A2E, 0x85A308D3, 0x243F6A88,
+                                        0x00000003,
+                                    } };
+
+inline const NUMBER init_big_rat_exp = { 1,
+                                         57,
+                                         0,
+                                         {
+                                             0xF45A0ECB, 0x163BC60D, 0xBB088017, 0xEED7F2F0, 0x31BEB5CC, 0x0FF8EC6D, 0xBBCA060F, 0x393C48CB,
+                                             0xA6160FFE, 0x45CBFA73, 0xA0D0BD86, 0x00D01334, 0x37DF8BB3, 0x780BF387, 0xB829B5C2, 0x2C1E9F23,
+                                             0x8DCAEC64, 0xB95BB79D, 0x78E537D2, 0x753D0A8F, 0x835FD1A0, 0xE5AB6ADD, 0xCB238FEE, 0x4422A52E,
+                                             0xCC93ED87, 0xF02AC60A, 0x20E9E5EA, 0xC2B3293D, 0xDAB79CD4, 0x77C56284, 0xCFBFA1C8, 0x8A9A276B,
+                                             0x839A2DDF, 0x613C31C3, 0xFD5F24D6, 0xD55C4D79, 0xF7B46BCE, 0x158D9554, 0x7C19BB42, 0x90CFD47D,
+                                             0x57F59584, 0x4F7C7B57, 0xBB1185EB, 0xDA06C80A, 0x8C31D763, 0xF4BF8D8D, 0x926CFBE5, 0x324E7738,
+                                             0x5190CFEF, 0xA784D904, 0x38B4DA56, 0x62E7160F, 0x9CF4F3C7, 0xBF715880, 0x8AED2A6A, 0xB7E15162,
+                                             0x00000002,
+                                         } };
+
+inline const NUMBER init_big_e_to_one_half = { 1,
+                                               57,
+                                               0,
+                                               {
+                                                   0x5A8A2063, 0xCAD1D053, 0x817DAB5C, 0x74160C5F, 0x0EA0B216, 0x82AA1D57, 0x84EA8A16, 0x80C365A1,
+                                                   0xCC13BDFC, 0x8685B874, 0x542B2368, 0x824AA7D0, 0x4F193D0C, 0x78D57B65, 0xF58D0E86, 0x404110FE,
+                                                   0x7C3E72A3, 0x276E5C5D, 0xCA0DE9F9, 0xFCC575C6, 0x68A133F8, 0x37F7969F, 0x938221F1, 0x90F3EE22,
+                                                   0x51ECE743, 0x487F6B7D, 0x425FBE4F, 0x7093702B, 0xE0E7D2E6, 0x89D4A081, 0x110AFFD9, 0xA9564D60,
+                                                   0x44FC7F4D, 0xD289D11D, 0x33F2185B, 0x0DB4F799, 0x301D26F0, 0x7CF93343, 0xFDE3DB38, 0xF40073AE,
+                                                   0x2B625E93, 0x5C337500, 0xF661F23B, 0x49ED598C, 0x97159917, 0x3E6EDBF7, 0xA9122E21, 0x2EF57279,
+                                                   0x6367F2CC, 0xC44BFC90, 0x130B4759, 0xF651F16C, 0xDF33F9B1, 0x2DFEFAB6, 0xE069BC97, 0xA61298E1,
+                                                   0x00000001,
+                                               } };
+
+inline const NUMBER init_big_ln_two = { 1,
+                                        56,
+                                        0,
+                                        {
+                                            0x17350D2C, 0x0C480A54, 0x5CFE7AA3, 0x074DB601, 0x5E148E82, 0x6A9C7F8A, 0x3564A337, 0x25669B33,
+                                            0xD1D6095D, 0x4C1A1E0B, 0x9393514C, 0xCCCC4E65, 0xB479CD33, 0xC943E732, 0xDB8990E5, 0x17460775,
+                                            0x1400B396, 0x7D2E23DE, 0xFC1EFA15, 0xEE569D6D, 0x8FE551A2, 0x610D30F8, 0xFB5BFB90, 0x07F4CA11,
+                                            0x0F3FD5C6, 0xDA2D97C5, 0x2F20E3A2, 0x655FA187, 0x38303248, 0xF5DFA6BD, 0x9D6548CA, 0x72CE87B1,
+                                            0x7657F74B, 0x256FA0EC, 0xB136603B, 0xB9EA9BC3, 0x317C387E, 0x1ACBDA11, 0x224AE8C5, 0x3E96CA16,
+                                            0x1169B825, 0x27573B29, 0xC1382144, 0xED2EAE35, 0x4AFA1B10, 0x559552FB, 0x6DEBAC98, 0xE7B87620,
+                                            0x8BAAFA2B, 0x8A0D175B, 0x7298B62D, 0x40F34326, 0x03F2F6AF, 0xC9E3B398, 0xD1CF79AB, 0xB17217F7,
+                                        } };
+
+inline const NUMBER init_big_ln_ten = { 1,
+                                        57,
+                                        0,
+                                        {
+                                            0x7DA7A297, 0xA527AAAB, 0xEC366D42, 0xA2011FC5, 0x7EBC6F2B, 0xE1232349, 0xD239B5B8, 0xF7F4F145,
+                                            0xA6DD0078, 0xBE2121BA, 0xAC9C4182, 0xD1FEA5B7, 0x9A0CE76F, 0x15D97378, 0x785049A9, 0x902FCF30,
+                                            0x5F53F703, 0x6C74A3A9, 0x5E31753F, 0x91FB2C9A, 0xA89C5866, 0x7356D0B9, 0xB4EBBA62, 0x891E3F2A,
+                                            0x4C17A607, 0x1A7A963A, 0x57B7883D, 0x6C22C15F, 0x11E2713D, 0x3A4CDA35, 0x8D814216, 0x299ECD6C,
+                                            0x48671EEF, 0x4586ED27, 0x2ACF1BE9, 0xBD9B3AC1, 0xC360C7EF, 0xD96A9B0E, 0x2A324479, 0xE0B3E28A,
+                                            0x0B945B59, 0xEE3DE210, 0x042F8B6B, 0xB1889061, 0xB17C35A0, 0x31C32F00, 0xC6A04173, 0x58BC0B5E,
+                                            0x07C0B5CA, 0x0F187A08, 0x6977E43A, 0x8A3FB3E7, 0x0B4C28A3, 0xA95B58AE, 0xAAA2B05B, 0x4D763776,
+                                            0x00000002,
+                                        } };
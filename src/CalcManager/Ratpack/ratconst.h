@@ -50,9 +50,9 @@ inline const NUMBER init_q_rat_smallest = { 1,
                                             0,
                                             {
                                                 0,
-                                                190439170,
-                                                901055854,
-                                                10097,
+                                                2242703233,
+                                                762134875,
+                                                1262,
                                             } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rat_negsmallest = { -1,
@@ -66,9 +66,9 @@ inline const NUMBER init_q_rat_negsmallest = { 1,
                                                0,
                                                {
                                                    0,
-                                                   190439170,
-                                                   901055854,
-                                                   10097,
+                                                   2242703233,
+                                                   762134875,
+                                                   1262,
                                                } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_pt_eight_five = { 1,
@@ -176,118 +176,109 @@ inline const NUMBER init_q_rat_ten = { 1,
                                        } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_pi = { 1,
-                                  6,
+                                  5,
                                   0,
                                   {
                                       125527896,
-                                      283898350,
-                                      1960493936,
-                                      1672850762,
-                                      1288168272,
-                                      8,
+                                      141949175,
+                                      1563865308,
+                                      209106345,
+                                      1154252341,
                                   } };
 inline const NUMBER init_q_pi = { 1,
-                                  6,
+                                  5,
                                   0,
                                   {
-                                      1288380402,
-                                      1120116153,
-                                      1860424692,
-                                      1944118326,
-                                      1583591604,
-                                      2,
+                                      3435864050,
+                                      560058076,
+                                      3686331645,
+                                      1316756614,
+                                      367409931,
                                   } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_two_pi = { 1,
-                                      6,
+                                      5,
                                       0,
                                       {
                                           251055792,
-                                          567796700,
-                                          1773504224,
-                                          1198217877,
-                                          428852897,
-                                          17,
+                                          283898350,
+                                          3127730616,
+                                          418212690,
+                                          2308504682,
                                       } };
 inline const NUMBER init_q_two_pi = { 1,
-                                      6,
+                                      5,
                                       0,
                                       {
-                                          1288380402,
-                                          1120116153,
-                                          1860424692,
-                                          1944118326,
-                                          1583591604,
-                                          2,
+                                          3435864050,
+                                          560058076,
+                                          3686331645,
+                                          1316756614,
+                                          367409931,
                                       } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_pi_over_two = { 1,
-                                           6,
+                                           5,
                                            0,
                                            {
                                                125527896,
-                                               283898350,
-                                               1960493936,
-                                               1672850762,
-                                               1288168272,
-                                               8,
+                                               141949175,
+                                               1563865308,
+                                               209106345,
+                                               1154252341,
                                            } };
 inline const NUMBER init_q_pi_over_two = { 1,
-                                           6,
+                                           5,
                                            0,
                                            {
-                                               429277156,
-                                               92748659,
-                                               1573365737,
-                                               1740753005,
-                                               1019699561,
-                                               5,
+                                               2576760804,
+                                               1120116153,
+                                               3077695994,
+                                               2633513229,
+                                               734819862,
                                            } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_one_pt_five_pi = { 1,
                                               6,
                                               0,
                                               {
-                                                  1241201312,
-                                                  270061909,
-                                                  1051574664,
-                                                  1924965045,
-                                                  1340320627,
-                                                  70,
+                                                  3388684960,
+                                                  135030954,
+                                                  2947248226,
+                                                  1045926998,
+                                                  889076407,
+                                                  2,
                                               } };
 inline const NUMBER init_q_one_pt_five_pi = { 1,
-                                              6,
+                                              5,
                                               0,
                                               {
-                                                  1579671539,
-                                                  1837970263,
-                                                  1067644340,
-                                                  523549916,
-                                                  2119366659,
-                                                  14,
+                                                  3727155187,
+                                                  918985131,
+                                                  2414394733,
+                                                  870750107,
+                                                  2011508608,
                                               } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_e_to_one_half = { 1,
-                                             6,
+                                             5,
                                              0,
                                              {
-                                                 256945612,
-                                                 216219427,
-                                                 223516738,
-                                                 477442596,
-                                                 581063757,
-                                                 23,
+                                                 2404429260,
+                                                 2255593361,
+                                                 2203362832,
+                                                 3549341252,
+                                                 3123324228,
                                              } };
 inline const NUMBER init_q_e_to_one_half = { 1,
-                                             6,
+                                             5,
                                              0,
                                              {
                                                  1536828363,
-                                                 698484484,
-                                                 1127331835,
-                                                 224219346,
-                                                 245499408,
-                                                 14,
+                                                 3570467714,
+                                                 1355574782,
+                                                 28027418,
+                                                 1894391905,
                                              } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rat_exp = { 1,
@@ -295,22 +286,22 @@ inline const NUMBER init_p_rat_exp = { 1,
                                        0,
                                        {
                                            943665199,
-                                           1606559160,
-                                           1094967530,
-                                           1759391384,
-                                           1671799163,
-                                           1123581,
+                                           2950763228,
+                                           273741882,
+                                           3172713939,
+                                           3996801559,
+                                           35111,
                                        } };
 inline const NUMBER init_q_rat_exp = { 1,
                                        6,
                                        0,
                                        {
                                            879242208,
-                                           2022880100,
-                                           617392930,
-                                           1374929092,
-                                           1367479163,
-                                           413342,
+                                           3158923698,
+                                           2301831880,
+                                           3124656152,
+                                           4111999287,
+                                           12916,
                                        } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_ln_ten = { 1,
@@ -318,100 +309,95 @@ inline const NUMBER init_p_ln_ten = { 1,
                                       0,
                                       {
                                           2086268922,
-                                          165794492,
-                                          1416063951,
-                                          1851428830,
-                                          1893239400,
-                                          65366841,
+                                          3304122718,
+                                          3575241459,
+                                          2378912251,
+                                          3473770662,
+                                          2042713,
                                       } };
 inline const NUMBER init_q_ln_ten = { 1,
                                       6,
                                       0,
                                       {
-                                          26790652,
-                                          564532679,
-                                          783998273,
-                                          216030448,
-                                          1564709968,
-                                          28388458,
+                                          2174274300,
+                                          1356008163,
+                                          195999568,
+                                          27003806,
+                                          1439971653,
+                                          887139,
                                       } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_ln_two = { 1,
-                                      6,
+                                      5,
                                       0,
                                       {
                                           1789230241,
-                                          1057927868,
-                                          715399197,
-                                          908801241,
-                                          1411265331,
-                                          3,
+                                          1602705758,
+                                          715720711,
+                                          918906523,
+                                          490857267,
                                       } };
 inline const NUMBER init_q_ln_two = { 1,
-                                      6,
+                                      5,
                                       0,
                                       {
                                           1559869847,
-                                          1930657510,
-                                          1228561531,
-                                          219003871,
-                                          593099283,
-                                          5,
+                                          4186554227,
+                                          4065236766,
+                                          832681851,
+                                          708157345,
                                       } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rad_to_deg = { 1,
                                           6,
                                           0,
                                           {
-                                              2127722024,
-                                              1904928383,
-                                              2016479213,
-                                              2048947859,
-                                              1578647346,
-                                              492,
+                                              4275205672,
+                                              2026206015,
+                                              2114732539,
+                                              792989394,
+                                              1709278195,
+                                              15,
                                           } };
 inline const NUMBER init_q_rad_to_deg = { 1,
-                                          6,
+                                          5,
                                           0,
                                           {
                                               125527896,
-                                              283898350,
-                                              1960493936,
-                                              1672850762,
-                                              1288168272,
-                                              8,
+                                              141949175,
+                                              1563865308,
+                                              209106345,
+                                              1154252341,
                                           } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rad_to_grad = { 1,
                                            6,
                                            0,
                                            {
-                                               2125526288,
-                                               684931327,
-                                               570267400,
-                                               129125085,
-                                               1038224725,
-                                               547,
+                                               4273009936,
+                                               342465663,
+                                               2826921410,
+                                               1358317915,
+                                               467542229,
+                                               17,
                                            } };
 inline const NUMBER init_q_rad_to_grad = { 1,
-                                           6,
+                                           5,
                                            0,
                                            {
                                                125527896,
-                                               283898350,
-                                               1960493936,
-                                               1672850762,
-                                               1288168272,
-                                               8,
+                                               141949175,
+                                               1563865308,
+                                               209106345,
+                                               1154252341,
                                            } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rat_qword = { 1,
-                                         3,
+                                         2,
                                          0,
                                          {
-                                             2147483647,
-                                             2147483647,
-                                             3,
+                                             4294967295,
+                                             4294967295,
                                          } };
 inline const NUMBER init_q_rat_qword = { 1,
                                          1,
@@ -421,11 +407,10 @@ inline const NUMBER init_q_rat_qword = { 1,
                                          } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rat_dword = { 1,
-                                         2,
+                                         1,
                                          0,
                                          {
-                                             2147483647,
-                                             1,
+                                             4294967295,
                                          } };
 inline const NUMBER init_q_rat_dword = { 1,
                                          1,
@@ -448,11 +433,10 @@ inline const NUMBER init_q_rat_max_i32 = { 1,
                                            } };
 // Autogenerated by _dumprawrat in support.cpp
 inline const NUMBER init_p_rat_min_i32 = { -1,
-                                           2,
+                                           1,
                                            0,
                                            {
-                                               0,
-                                               1,
+                                               2147483648,
                                            } };
 inline const NUMBER init_q_rat_min_i32 = { 1,
                                            1,
@@ -23,10 +23,10 @@
 #include <cstring>              // for memmove
 #include "sal_cross_platform.h" // for SAL
 
-static constexpr uint32_t BASEXPWR = 31L;     // Internal log2(BASEX)
-static constexpr uint32_t BASEX = 0x80000000; // Internal radix used in calculations, hope to raise
-                                              // this to 2^32 after solving scaling problems with
-                                              // overflow detection esp. in mul
+static constexpr uint32_t BASEXPWR = 32L;      // Internal log2(BASEX)
+static constexpr uint64_t BASEX = 0x100000000; // Internal radix used in calculations, a full MANTTYPE
+                                               // digit. It doesn't fit in 32 bits, so functions which
+                                               // can be handed BASEX take their radix as uint64_t.
 
 typedef uint32_t MANTTYPE;
 typedef uint64_t TWO_MANTTYPE;
@@ -81,54 +81,96 @@ typedef struct _rat
 
 static constexpr uint32_t MAX_LONG_SIZE = 33; // Base 2 requires 32 'digits'
 
+//-----------------------------------------------------------------------------
+//
+//  Allocation of NUMBER and RAT nodes, see alloc.cpp
+//
+//-----------------------------------------------------------------------------
+
+enum class AllocatorMode
+{
+    Pooled, // size classed free lists, and arenas while a ScratchArena is open
+    Calloc  // every node is a separate calloc/free, as ratpak originally did
+};
+
+typedef struct _allocstats
+{
+    uint64_t cnodealloc;   // Nodes handed out in total
+    uint64_t cnodefree;    // Nodes destroyed individually
+    uint64_t cpoolhit;     // Allocations satisfied from a free list
+    uint64_t carenaalloc;  // Allocations satisfied from a ScratchArena
+    uint64_t csystemalloc; // Allocations that had to go to the system heap
+    uint64_t cbulkfree;    // Nodes released by closing a ScratchArena
+    uint64_t cinuse;       // Nodes currently alive
+    uint64_t cpeakinuse;   // High water mark of cinuse
+} ALLOCSTATS;
+
+// While alive, every NUMBER and RAT created is taken from a scratch region that
+// is released as a whole when the arena is destroyed, including anything left
+// behind by an exception. Use detachnum/detachrat on values that must outlive it.
+class ScratchArena
+{
+public:
+    ScratchArena();
+    ~ScratchArena();
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+};
+
 //-----------------------------------------------------------------------------
 //
 // List of useful constants for evaluation, note this list needs to be
 // initialized.
 //
+// Like everything else ratpak keeps between calls, the constants, the
+// precision and radix they were made for, the thresholds and the allocator
+// free lists are per thread. Every thread has to call ChangeConstants before
+// doing any arithmetic, after that it can compute independently of all the
+// others, with a radix and precision of its own.
+//
 //-----------------------------------------------------------------------------
 
-extern PNUMBER num_one;
-extern PNUMBER num_two;
-extern PNUMBER num_five;
-extern PNUMBER num_six;
-extern PNUMBER num_ten;
-
-extern PRAT ln_ten;
-extern PRAT ln_two;
-extern PRAT rat_zero;
-extern PRAT rat_neg_one;
-extern PRAT rat_one;
-extern PRAT rat_two;
-extern PRAT rat_six;
-extern PRAT rat_half;
-extern PRAT rat_ten;
-extern PRAT pt_eight_five;
-extern PRAT pi;
-extern PRAT pi_over_two;
-extern PRAT two_pi;
-extern PRAT one_pt_five_pi;
-extern PRAT e_to_one_half;
-extern PRAT rat_exp;
-extern PRAT rad_to_deg;
-extern PRAT rad_to_grad;
-extern PRAT rat_qword;
-extern PRAT rat_dword;
-extern PRAT rat_word;
-extern PRAT rat_byte;
-extern PRAT rat_360;
-extern PRAT rat_400;
-extern PRAT rat_180;
-extern PRAT rat_200;
-extern PRAT rat_nRadix;
-extern PRAT rat_smallest;
-extern PRAT rat_negsmallest;
-extern PRAT rat_max_exp;
-extern PRAT rat_min_exp;
-extern PRAT rat_max_fact;
-extern PRAT rat_min_fact;
-extern PRAT rat_max_i32;
-extern PRAT rat_min_i32;
+extern thread_local PNUMBER num_one;
+extern thread_local PNUMBER num_two;
+extern thread_local PNUMBER num_five;
+extern thread_local PNUMBER num_six;
+extern thread_local PNUMBER num_ten;
+
+extern thread_local PRAT ln_ten;
+extern thread_local PRAT ln_two;
+extern thread_local PRAT rat_zero;
+extern thread_local PRAT rat_neg_one;
+extern thread_local PRAT rat_one;
+extern thread_local PRAT rat_two;
+extern thread_local PRAT rat_six;
+extern thread_local PRAT rat_half;
+extern thread_local PRAT rat_ten;
+extern thread_local PRAT pt_eight_five;
+extern thread_local PRAT pi;
+extern thread_local PRAT pi_over_two;
+extern thread_local PRAT two_pi;
+extern thread_local PRAT one_pt_five_pi;
+extern thread_local PRAT e_to_one_half;
+extern thread_local PRAT rat_exp;
+extern thread_local PRAT rad_to_deg;
+extern thread_local PRAT rad_to_grad;
+extern thread_local PRAT rat_qword;
+extern thread_local PRAT rat_dword;
+extern thread_local PRAT rat_word;
+extern thread_local PRAT rat_byte;
+extern thread_local PRAT rat_360;
+extern thread_local PRAT rat_400;
+extern thread_local PRAT rat_180;
+extern thread_local PRAT rat_200;
+extern thread_local PRAT rat_nRadix;
+extern thread_local PRAT rat_smallest;
+extern thread_local PRAT rat_negsmallest;
+extern thread_local PRAT rat_max_exp;
+extern thread_local PRAT rat_min_exp;
+extern thread_local PRAT rat_max_fact;
+extern thread_local PRAT rat_min_fact;
+extern thread_local PRAT rat_max_i32;
+extern thread_local PRAT rat_min_i32;
 
 // DUPNUM Duplicates a number taking care of allocation and internals
 #define DUPNUM(a, b)                                                                                                                                           \
@@ -262,6 +304,7 @@ extern PRAT rat_min_i32;
 //-----------------------------------------------------------------------------
 
 #define CREATETAYLOR()                                                                                                                                         \
+    ScratchArena taylorarena;                                                                                                                                  \
     PRAT xx = nullptr;                                                                                                                                         \
     PNUMBER n2 = nullptr;                                                                                                                                      \
     PRAT pret = nullptr;                                                                                                                                       \
@@ -278,6 +321,7 @@ extern PRAT rat_min_i32;
     destroyrat(thisterm);                                                                                                                                      \
     destroyrat(*px);                                                                                                                                           \
     trimit(&pret, precision);                                                                                                                                  \
+    detachrat(&pret);                                                                                                                                          \
     *px = pret;
 
 // INC(a) is the rational equivalent of a++
@@ -317,11 +361,16 @@ extern PRAT rat_min_i32;
 //
 //-----------------------------------------------------------------------------
 
-extern bool g_ftrueinfinite; // set to true to allow infinite precision
-                             // don't use unless you know what you are doing
-                             // used to help decide when to stop calculating.
+extern thread_local bool g_ftrueinfinite; // set to true to allow infinite precision
+                                          // don't use unless you know what you are doing
+                                          // used to help decide when to stop calculating.
 
-extern int32_t g_ratio; // Internally calculated ratio of internal radix
+extern thread_local int32_t g_ratio; // Internally calculated ratio of internal radix
+
+extern thread_local uint32_t g_constantsradix;     // The radix and precision ChangeConstants was last called with
+extern thread_local int32_t g_constantsprecision;
+extern thread_local uint32_t g_constantsgeneration; // Changes whenever ChangeConstants sets another radix or precision, or the
+                                                    // constants for one could come out different from the last time
 
 //-----------------------------------------------------------------------------
 //
@@ -348,7 +397,7 @@ extern PNUMBER RatToNumber(_In_ PRAT prat, uint32_t radix, int32_t precision);
 // flattens a PRAT by converting it to a PNUMBER and back to a PRAT
 extern void flatrat(_Inout_ PRAT& prat, uint32_t radix, int32_t precision);
 
-extern int32_t numtoi32(_In_ PNUMBER pnum, uint32_t radix);
+extern int32_t numtoi32(_In_ PNUMBER pnum, uint64_t radix);
 extern int32_t rattoi32(_In_ PRAT prat, uint32_t radix, int32_t precision);
 uint64_t rattoUi64(_In_ PRAT prat, uint32_t radix, int32_t precision);
 extern PNUMBER _createnum(_In_ uint32_t size); // returns an empty number structure with size digits
@@ -365,10 +414,14 @@ StringToRat(bool mantissaIsNegative, std::wstring_view mantissa, bool exponentIs
 
 extern PNUMBER i32factnum(int32_t ini32, uint32_t radix);
 extern PNUMBER i32prodnum(int32_t start, int32_t stop, uint32_t radix);
-extern PNUMBER i32tonum(int32_t ini32, uint32_t radix);
-extern PNUMBER Ui32tonum(uint32_t ini32, uint32_t radix);
+extern PNUMBER i32tonum(int32_t ini32, uint64_t radix);
+extern PNUMBER Ui32tonum(uint32_t ini32, uint64_t radix);
 extern PNUMBER numtonRadixx(_In_ PNUMBER a, uint32_t radix);
 
+// threshold is in internal digits of the number converted, used to tune the crossover point
+extern void SetConvThreshold(int32_t split);
+extern void GetConvThreshold(_Out_ int32_t* split);
+
 // creates a empty/undefined rational representation (p/q)
 extern PRAT _createrat(void);
 
@@ -425,6 +478,18 @@ extern void log10rat(_Inout_ PRAT* px, int32_t precision);
 extern void lograt(_Inout_ PRAT* px, int32_t precision);
 extern void _lograt(_Inout_ PRAT* px, int32_t precision);
 
+// binary splitting versions of the series in _exprat, __lograt, _sinrat, _cosrat, _atanrat
+// and _asinrat, they return false when the precision is below the threshold
+extern bool splitexprat(_Inout_ PRAT* px, int32_t precision);
+extern bool splitlograt(_Inout_ PRAT* px, int32_t precision);
+extern bool splitsinrat(_Inout_ PRAT* px, int32_t precision);
+extern bool splitcosrat(_Inout_ PRAT* px, int32_t precision);
+extern bool splitatanrat(_Inout_ PRAT* px, int32_t precision);
+extern bool splitasinrat(_Inout_ PRAT* px, int32_t precision);
+// threshold is in internal digits of precision, used to tune the crossover point
+extern void SetSeriesThreshold(int32_t split);
+extern void GetSeriesThreshold(_Out_ int32_t* split);
+
 extern PRAT i32torat(int32_t ini32);
 extern PRAT Ui32torat(uint32_t inui32);
 extern PRAT numtorat(_In_ PNUMBER pin, uint32_t radix);
@@ -447,12 +512,31 @@ extern void _dupnum(_In_ PNUMBER dest, _In_ const NUMBER* const src);
 
 extern void _destroynum(_Frees_ptr_opt_ PNUMBER pnum);
 extern void _destroyrat(_Frees_ptr_opt_ PRAT prat);
-extern void addnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix);
+
+// allocates zeroed out memory for a NUMBER or RAT node, release it with zfree
+extern void* zmalloc(size_t cb);
+extern void zfree(_Frees_ptr_opt_ void* p);
+// moves a number or rational out of the enclosing ScratchArena
+extern void detachnum(_Inout_ PNUMBER* pnum);
+extern void detachrat(_Inout_ PRAT* prat);
+// Calloc mode bypasses the free lists and arenas, useful for measuring and for leak tools
+extern void SetAllocatorMode(AllocatorMode mode);
+extern AllocatorMode GetAllocatorMode();
+extern ALLOCSTATS GetAllocatorStats();
+extern void ResetAllocatorStats();
+// returns all cached free nodes and arena chunks to the system heap
+extern void TrimAllocator();
+extern void addnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix);
 extern void addrat(_Inout_ PRAT* pa, _In_ PRAT b, int32_t precision);
 extern void _addrat(_Inout_ PRAT* pa, _In_ PRAT b, int32_t precision);
 extern void andrat(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void divnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix, int32_t precision);
 extern void divnumx(_Inout_ PNUMBER* pa, _In_ PNUMBER b, int32_t precision);
+// Newton iteration divide, returns false when the divisor is below the threshold for its radix
+extern bool divnumlarge(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix, int32_t cdigits);
+// thresholds are in digits of the divisor, for BASEX and for any other radix
+extern void SetDivThresholds(int32_t basex, int32_t radix);
+extern void GetDivThresholds(_Out_ int32_t* basex, _Out_ int32_t* radix);
 extern void divrat(_Inout_ PRAT* pa, _In_ PRAT b, int32_t precision);
 extern void fracrat(_Inout_ PRAT* pa, uint32_t radix, int32_t precision);
 extern void factrat(_Inout_ PRAT* pa, uint32_t radix, int32_t precision);
@@ -460,17 +544,22 @@ extern void remrat(_Inout_ PRAT* pa, _In_ PRAT b);
 extern void modrat(_Inout_ PRAT* pa, _In_ PRAT b);
 extern void gcdrat(_Inout_ PRAT* pa, int32_t precision);
 extern void intrat(_Inout_ PRAT* px, uint32_t radix, int32_t precision);
-extern void mulnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix);
+extern void mulnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix);
 extern void mulnumx(_Inout_ PNUMBER* pa, _In_ PNUMBER b);
+// Karatsuba/Toom-3 multiply, returns false when the numbers are below the thresholds
+extern bool mulnumlarge(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix);
+// thresholds are in digits of the smaller operand, used to tune the crossover points
+extern void SetMulThresholds(int32_t karatsuba, int32_t toom3);
+extern void GetMulThresholds(_Out_ int32_t* karatsuba, _Out_ int32_t* toom3);
 extern void mulrat(_Inout_ PRAT* pa, _In_ PRAT b, int32_t precision);
-extern void numpowi32(_Inout_ PNUMBER* proot, int32_t power, uint32_t radix, int32_t precision);
+extern void numpowi32(_Inout_ PNUMBER* proot, int32_t power, uint64_t radix, int32_t precision);
 extern void numpowi32x(_Inout_ PNUMBER* proot, int32_t power);
 extern void orrat(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void powrat(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void powratNumeratorDenominator(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void powratcomp(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void ratpowi32(_Inout_ PRAT* proot, int32_t power, int32_t precision);
-extern void remnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint32_t radix);
+extern void remnum(_Inout_ PNUMBER* pa, _In_ PNUMBER b, uint64_t radix);
 extern void rootrat(_Inout_ PRAT* pa, _In_ PRAT b, uint32_t radix, int32_t precision);
 extern void scale2pi(_Inout_ PRAT* px, uint32_t radix, int32_t precision);
 extern void scale(_Inout_ PRAT* px, _In_ PRAT scalefact, uint32_t radix, int32_t precision);
@@ -0,0 +1,780 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+//-----------------------------------------------------------------------------
+//  Package Title  ratpak
+//  File           series.cpp
+//
+//
+//  Description
+//
+//     Contains the binary splitting evaluation of the Taylor series behind
+//  exp, log, sin, cos, atan and asin, used instead of the term by term
+//  loops once the precision is high enough.
+//
+//     For an argument r/d with a small numerator and denominator, N terms of
+//  a series whose terms have a ratio of p(j)/q(j) are summed exactly as one
+//  fraction by splitting the terms in halves, working out the partial sums
+//  of each half and combining them with a couple of multiplies. The numbers
+//  only grow to full size near the top of the tree, where Karatsuba and
+//  Toom-3 take care of them.
+//
+//     A full precision argument is cut into chunks of bits, 8 bits to start
+//  with and twice as many each time after that. Every chunk has a small
+//  numerator relative to its size, and the chunk results are put back
+//  together with exp(a+b) = exp(a)exp(b), the sin and cos addition
+//  formulas, or atan(x) = atan(c) + atan((x-c)/(1+xc)) for the inverse
+//  functions.
+//
+//-----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cmath>
+#include "ratpak.h"
+
+using namespace std;
+
+namespace
+{
+    // Threshold is in BASEX digits of precision, see SetSeriesThreshold. sin
+    // and cos sum two series per chunk, and only catch up at twice that.
+    thread_local int32_t s_splitthreshold = 9;
+
+    // Bits of the argument in the first chunk, the chunks double after that.
+    constexpr int32_t FIRSTCHUNKBITS = 8;
+
+    // Extra bits carried on top of the precision asked for.
+    constexpr int32_t GUARDBITS = 8;
+
+    enum class Series
+    {
+        Exp,   // x^j / j!
+        Sin,   // (-1)^j x^(2j+1) / (2j+1)!
+        Cos,   // (-1)^j x^2j / (2j)!
+        Atan,  // (-1)^j x^(2j+1) / (2j+1)
+        Atanh, // x^(2j+1) / (2j+1)
+        Asin   // (2j)! x^(2j+1) / (4^j (j!)^2 (2j+1))
+    };
+
+    // The terms of the series are x times a power of x for the odd ones.
+    bool isodd(Series series)
+    {
+        return series != Series::Exp && series != Series::Cos;
+    }
+
+    // Term j is term j-1 times sign * x^power * p / q.
+    int32_t powerof(Series series)
+    {
+        return series == Series::Exp ? 1 : 2;
+    }
+
+    int32_t signof(Series series)
+    {
+        return (series == Series::Sin || series == Series::Cos || series == Series::Atan) ? -1 : 1;
+    }
+
+    void termfactors(Series series, uint64_t j, _Out_ uint64_t* p, _Out_ uint64_t* q)
+    {
+        switch (series)
+        {
+        case Series::Exp:
+            *p = 1;
+            *q = j;
+            break;
+        case Series::Sin:
+            *p = 1;
+            *q = (2 * j) * (2 * j + 1);
+            break;
+        case Series::Cos:
+            *p = 1;
+            *q = (2 * j - 1) * (2 * j);
+            break;
+        case Series::Atan:
+        case Series::Atanh:
+            *p = 2 * j - 1;
+            *q = 2 * j + 1;
+            break;
+        case Series::Asin:
+            *p = (2 * j - 1) * (2 * j - 1);
+            *q = (2 * j) * (2 * j + 1);
+            break;
+        }
+    }
+
+    PNUMBER ui64tonum(uint64_t n)
+    {
+        PNUMBER pnum = nullptr;
+        createnum(pnum, 2);
+        pnum->sign = 1;
+        pnum->exp = 0;
+        pnum->mant[0] = static_cast<MANTTYPE>(n);
+        pnum->mant[1] = static_cast<MANTTYPE>(n >> BASEXPWR);
+        pnum->cdigit = (pnum->mant[1] != 0) ? 2 : 1;
+        return pnum;
+    }
+
+    // 2^bits as a number.
+    PNUMBER pow2num(int32_t bits)
+    {
+        PNUMBER pnum = nullptr;
+        createnum(pnum, 1);
+        pnum->sign = 1;
+        pnum->cdigit = 1;
+        pnum->exp = bits / BASEXPWR;
+        pnum->mant[0] = static_cast<MANTTYPE>(1) << (bits % BASEXPWR);
+        return pnum;
+    }
+
+    // log2 of the magnitude of a non zero number, good to double precision.
+    double log2num(PNUMBER pnum)
+    {
+        double top = pnum->mant[pnum->cdigit - 1];
+        int32_t cdigits = pnum->cdigit - 1 + pnum->exp;
+        if (pnum->cdigit > 1)
+        {
+            top = top * static_cast<double>(BASEX) + pnum->mant[pnum->cdigit - 2];
+            cdigits--;
+        }
+        return log2(top) + static_cast<double>(cdigits) * BASEXPWR;
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: termcount
+    //
+    //    ARGUMENTS: the series, log2 of the magnitude of x and the number of
+    //    bits wanted.
+    //
+    //    RETURN: how many terms after the first are needed, the terms left
+    //    over add up to less than 2^-cbits relative to the first one.
+    //
+    //-------------------------------------------------------------------------
+
+    uint32_t termcount(Series series, double log2x, int32_t cbits)
+    {
+        double logterm = 0;
+        for (uint64_t j = 1;; j++)
+        {
+            uint64_t p;
+            uint64_t q;
+            termfactors(series, j, &p, &q);
+            double logratio = powerof(series) * log2x + log2(static_cast<double>(p)) - log2(static_cast<double>(q));
+            logterm += logratio;
+
+            // Once the terms shrink, the rest is a geometric series at worst.
+            if (logratio < 0 && logterm - log2(1 - exp2(logratio)) < -cbits)
+            {
+                return static_cast<uint32_t>(j);
+            }
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: splitterms
+    //
+    //    ARGUMENTS: the series, x^power as the two numbers xp/xq with the
+    //    sign of the series applied, the range of terms a up to but not
+    //    including b, and where to put P, Q and T. pp can be null when the
+    //    caller has no use for P.
+    //
+    //    RETURN: None, P, Q and T are created.
+    //
+    //    DESCRIPTION: With term j being term j-1 times p(j)/q(j), term j
+    //    relative to term a-1 is p(a)...p(j) / q(a)...q(j). Over the range
+    //
+    //        P = p(a)...p(b-1), Q = q(a)...q(b-1) and the sum of the terms
+    //        relative to term a-1 is T/Q
+    //
+    //    and two neighboring ranges combine as
+    //
+    //        P = P1*P2, Q = Q1*Q2, T = T1*Q2 + P1*T2
+    //
+    //-------------------------------------------------------------------------
+
+    void splitterms(Series series, PNUMBER xp, PNUMBER xq, uint32_t a, uint32_t b, _Out_opt_ PNUMBER* pp, _Out_ PNUMBER* pq, _Out_ PNUMBER* pt)
+    {
+        if (b - a == 1)
+        {
+            uint64_t p;
+            uint64_t q;
+            termfactors(series, a, &p, &q);
+            PNUMBER pnum = ui64tonum(p);
+            mulnumx(&pnum, xp);
+            *pq = ui64tonum(q);
+            mulnumx(pq, xq);
+            *pt = pnum;
+            if (pp != nullptr)
+            {
+                DUPNUM(*pp, pnum);
+            }
+            return;
+        }
+
+        uint32_t m = a + (b - a) / 2;
+        PNUMBER p1 = nullptr;
+        PNUMBER q1 = nullptr;
+        PNUMBER t1 = nullptr;
+        PNUMBER p2 = nullptr;
+        PNUMBER q2 = nullptr;
+        PNUMBER t2 = nullptr;
+        splitterms(series, xp, xq, a, m, &p1, &q1, &t1);
+        splitterms(series, xp, xq, m, b, (pp != nullptr) ? &p2 : nullptr, &q2, &t2);
+
+        mulnumx(&t1, q2);
+        mulnumx(&t2, p1);
+        addnum(&t1, t2, BASEX);
+        mulnumx(&q1, q2);
+        if (pp != nullptr)
+        {
+            mulnumx(&p1, p2);
+            *pp = p1;
+        }
+        else
+        {
+            destroynum(p1);
+        }
+        *pq = q1;
+        *pt = t1;
+
+        destroynum(p2);
+        destroynum(q2);
+        destroynum(t2);
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: splitseries
+    //
+    //    ARGUMENTS: the series, x as the two numbers r/d, and the number of
+    //    terms after the first to add up.
+    //
+    //    RETURN: the sum of the series as a rational, exactly, it has not
+    //    been trimmed.
+    //
+    //-------------------------------------------------------------------------
+
+    PRAT splitseries(Series series, PNUMBER r, PNUMBER d, uint32_t nterms)
+    {
+        PRAT pret = nullptr;
+        createrat(pret);
+        if (nterms == 0)
+        {
+            pret->pp = i32tonum(1L, BASEX);
+            pret->pq = i32tonum(1L, BASEX);
+        }
+        else
+        {
+            PNUMBER xp = nullptr;
+            PNUMBER xq = nullptr;
+            DUPNUM(xp, r);
+            DUPNUM(xq, d);
+            if (powerof(series) == 2)
+            {
+                mulnumx(&xp, r);
+                mulnumx(&xq, d);
+            }
+            xp->sign *= signof(series);
+
+            PNUMBER pt = nullptr;
+            splitterms(series, xp, xq, 1, nterms + 1, nullptr, &(pret->pq), &pt);
+            // The first term is one.
+            DUPNUM(pret->pp, pret->pq);
+            addnum(&(pret->pp), pt, BASEX);
+
+            destroynum(pt);
+            destroynum(xp);
+            destroynum(xq);
+        }
+
+        if (isodd(series))
+        {
+            mulnumx(&(pret->pp), r);
+            mulnumx(&(pret->pq), d);
+        }
+        return pret;
+    }
+
+    // Sums the series for x = r/d, to cbits relative to its first term.
+    PRAT sumseries(Series series, PNUMBER r, PNUMBER d, int32_t cbits)
+    {
+        uint32_t nterms = 0;
+        if (!zernum(r))
+        {
+            nterms = termcount(series, log2num(r) - log2num(d), cbits);
+        }
+        return splitseries(series, r, d, nterms);
+    }
+
+    // An argument with a one digit numerator and denominator is summed
+    // directly, without cutting it into chunks.
+    bool issmallrat(PRAT x)
+    {
+        return x->pp->cdigit == 1 && x->pq->cdigit == 1;
+    }
+
+    // The magnitude of x in units of 2^-(cdigits*BASEXPWR), the digits
+    // below the units are left in place and never looked at.
+    PNUMBER fixednum(PRAT x, int32_t cdigits)
+    {
+        PNUMBER pnum = nullptr;
+        PNUMBER pden = nullptr;
+        DUPNUM(pnum, x->pp);
+        DUPNUM(pden, x->pq);
+        pnum->exp += cdigits;
+        int32_t cquot = (pnum->cdigit + pnum->exp) - (pden->cdigit + pden->exp) + 1;
+        divnumx(&pnum, pden, max(cquot, 1));
+        pnum->sign = SIGN(x);
+        destroynum(pden);
+        return pnum;
+    }
+
+    // Bit position just past the top bit of the integer part of pnum.
+    int32_t topbit(PNUMBER pnum)
+    {
+        if (zernum(pnum))
+        {
+            return 0;
+        }
+        return (pnum->cdigit + pnum->exp) * BASEXPWR;
+    }
+
+    MANTTYPE digitof(PNUMBER pnum, int32_t idigit)
+    {
+        idigit -= pnum->exp;
+        return (idigit >= 0 && idigit < pnum->cdigit) ? pnum->mant[idigit] : 0;
+    }
+
+    // Bits lo up to but not including hi of the integer part of pnum, with
+    // its sign.
+    PNUMBER bitsofnum(PNUMBER pnum, int32_t lo, int32_t hi)
+    {
+        int32_t cdigits = (hi - lo + BASEXPWR - 1) / BASEXPWR;
+        PNUMBER pret = nullptr;
+        createnum(pret, cdigits);
+        pret->sign = pnum->sign;
+        pret->exp = 0;
+        pret->cdigit = cdigits;
+        for (int32_t i = 0; i < cdigits; i++)
+        {
+            int32_t bit = lo + i * BASEXPWR;
+            TWO_MANTTYPE word = digitof(pnum, bit / BASEXPWR) | (static_cast<TWO_MANTTYPE>(digitof(pnum, bit / BASEXPWR + 1)) << BASEXPWR);
+            pret->mant[i] = static_cast<MANTTYPE>(word >> (bit % BASEXPWR));
+        }
+        int32_t ctopbits = (hi - lo) - (cdigits - 1) * BASEXPWR;
+        if (ctopbits < static_cast<int32_t>(BASEXPWR))
+        {
+            pret->mant[cdigits - 1] &= (static_cast<MANTTYPE>(1) << ctopbits) - 1;
+        }
+        while (pret->cdigit > 1 && pret->mant[pret->cdigit - 1] == 0)
+        {
+            pret->cdigit--;
+        }
+        return pret;
+    }
+
+    // BASEX digits to work to for precision, and the same in bits.
+    int32_t workdigits(int32_t precision)
+    {
+        return precision / g_ratio + 2;
+    }
+
+    int32_t workbits(int32_t precision)
+    {
+        return workdigits(precision) * BASEXPWR + GUARDBITS;
+    }
+
+    // Takes over *px with a result created inside an arena that is about to close.
+    void replacerat(_Inout_ PRAT* px, PRAT pret, int32_t precision)
+    {
+        trimit(&pret, precision);
+        detachrat(&pret);
+        destroyrat(*px);
+        *px = pret;
+    }
+
+    // Bits lo up to hi of a fixed point argument with its binary point
+    // fixedbits up, as a rational, or null if they are all zero.
+    PRAT chunkrat(PNUMBER fixed, int32_t lo, int32_t hi, int32_t fixedbits)
+    {
+        if (hi <= lo)
+        {
+            return nullptr;
+        }
+
+        PRAT chunk = nullptr;
+        createrat(chunk);
+        chunk->pp = bitsofnum(fixed, lo, hi);
+        chunk->pq = pow2num(fixedbits - lo);
+        if (zernum(chunk->pp))
+        {
+            destroyrat(chunk);
+        }
+        return chunk;
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: sincossplit
+    //
+    //    ARGUMENTS: x, and where to put sin(x) and cos(x), either can be null
+    //    for a small x.
+    //
+    //    DESCRIPTION: sums sin and cos chunk by chunk, with
+    //
+    //        sin(a+b) = sin(a)cos(b) + cos(a)sin(b)
+    //        cos(a+b) = cos(a)cos(b) - sin(a)sin(b)
+    //
+    //-------------------------------------------------------------------------
+
+    void sincossplit(PRAT x, _Out_opt_ PRAT* psin, _Out_opt_ PRAT* pcos, int32_t precision)
+    {
+        int32_t cdigits = workdigits(precision);
+        int32_t cbits = workbits(precision);
+
+        ScratchArena splitarena;
+        PRAT sinx = nullptr;
+        PRAT cosx = nullptr;
+
+        if (issmallrat(x))
+        {
+            if (psin != nullptr)
+            {
+                sinx = sumseries(Series::Sin, x->pp, x->pq, cbits);
+            }
+            if (pcos != nullptr)
+            {
+                cosx = sumseries(Series::Cos, x->pp, x->pq, cbits);
+            }
+        }
+        else
+        {
+            DUPRAT(sinx, rat_zero);
+            DUPRAT(cosx, rat_one);
+            PNUMBER fixed = fixednum(x, cdigits);
+            int32_t fixedbits = cdigits * BASEXPWR;
+            int32_t hi = topbit(fixed);
+            for (int32_t cchunkbits = FIRSTCHUNKBITS; hi > 0; cchunkbits *= 2)
+            {
+                int32_t lo = max(fixedbits - cchunkbits, 0);
+                PRAT chunk = chunkrat(fixed, lo, hi, fixedbits);
+                hi = min(hi, lo);
+                if (chunk != nullptr)
+                {
+                    PRAT sinc = sumseries(Series::Sin, chunk->pp, chunk->pq, cbits);
+                    PRAT cosc = sumseries(Series::Cos, chunk->pp, chunk->pq, cbits);
+
+                    PRAT sincos = nullptr;
+                    PRAT cossin = nullptr;
+                    DUPRAT(sincos, sinx);
+                    mulrat(&sincos, cosc, precision);
+                    DUPRAT(cossin, cosx);
+                    mulrat(&cossin, sinc, precision);
+                    mulrat(&cosx, cosc, precision);
+                    mulrat(&sinx, sinc, precision);
+                    _subrat(&cosx, sinx, precision);
+                    destroyrat(sinx);
+                    sinx = sincos;
+                    _addrat(&sinx, cossin, precision);
+
+                    destroyrat(cossin);
+                    destroyrat(sinc);
+                    destroyrat(cosc);
+                    destroyrat(chunk);
+                }
+            }
+            destroynum(fixed);
+        }
+
+        if (psin != nullptr)
+        {
+            replacerat(psin, sinx, precision);
+        }
+        if (pcos != nullptr)
+        {
+            replacerat(pcos, cosx, precision);
+        }
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: atansplit
+    //
+    //    ARGUMENTS: x with abs(x) < 1, and whether it is atan or atanh.
+    //
+    //    RETURN: atan(x) or atanh(x) as a rational.
+    //
+    //    DESCRIPTION: takes the leading chunk c off of x each time with
+    //
+    //        atan(x) = atan(c) + atan((x-c)/(1+xc))
+    //        atanh(x) = atanh(c) + atanh((x-c)/(1-xc))
+    //
+    //    the second argument being no bigger than what was left of x after
+    //    the chunk, so the next time round the next chunk is taken.
+    //
+    //-------------------------------------------------------------------------
+
+    PRAT atansplit(PRAT x, Series series, int32_t precision)
+    {
+        int32_t cdigits = workdigits(precision);
+        int32_t cbits = workbits(precision);
+
+        if (issmallrat(x))
+        {
+            return sumseries(series, x->pp, x->pq, cbits);
+        }
+
+        PRAT pret = nullptr;
+        PRAT rest = nullptr;
+        DUPRAT(pret, rat_zero);
+        DUPRAT(rest, x);
+        int32_t fixedbits = cdigits * BASEXPWR;
+        int32_t lo = fixedbits;
+        for (int32_t cchunkbits = FIRSTCHUNKBITS; lo > 0 && !zerrat(rest); cchunkbits *= 2)
+        {
+            PNUMBER fixed = fixednum(rest, cdigits);
+            lo = max(fixedbits - cchunkbits, 0);
+            PRAT chunk = chunkrat(fixed, lo, topbit(fixed), fixedbits);
+            destroynum(fixed);
+            if (chunk != nullptr)
+            {
+                PRAT atanc = sumseries(series, chunk->pp, chunk->pq, cbits);
+                _addrat(&pret, atanc, precision);
+
+                PRAT den = nullptr;
+                DUPRAT(den, rest);
+                mulrat(&den, chunk, precision);
+                if (series == Series::Atanh)
+                {
+                    den->pp->sign *= -1;
+                }
+                _addrat(&den, rat_one, precision);
+                _subrat(&rest, chunk, precision);
+                divrat(&rest, den, precision);
+
+                destroyrat(den);
+                destroyrat(atanc);
+                destroyrat(chunk);
+            }
+        }
+
+        // Whatever is left is below the precision, and so is the difference
+        // between it and its atan.
+        _addrat(&pret, rest, precision);
+        destroyrat(rest);
+        return pret;
+    }
+
+    //-------------------------------------------------------------------------
+    //
+    //    FUNCTION: sqrtsplit
+    //
+    //    ARGUMENTS: pointer to a positive x
+    //
+    //    RETURN: None, *px is replaced by its square root.
+    //
+    //    DESCRIPTION: Newton's iteration y = (y + x/y)/2 from a double
+    //    precision start, the good bits doubling each time.
+    //
+    //-------------------------------------------------------------------------
+
+    void sqrtsplit(_Inout_ PRAT* px, int32_t precision)
+    {
+        int32_t cbits = workbits(precision);
+        double log2root = (log2num((*px)->pp) - log2num((*px)->pq)) / 2;
+
+        // The start is 2^52 * root over 2^52.
+        PRAT root = nullptr;
+        createrat(root);
+        int32_t cscale = 52 - static_cast<int32_t>(floor(log2root));
+        root->pp = ui64tonum(static_cast<uint64_t>(exp2(log2root + cscale)));
+        root->pq = pow2num(max(cscale, 0));
+        if (cscale < 0)
+        {
+            PNUMBER pscale = pow2num(-cscale);
+            mulnumx(&(root->pp), pscale);
+            destroynum(pscale);
+        }
+
+        for (int32_t cgood = 48; cgood < cbits; cgood *= 2)
+        {
+            PRAT quot = nullptr;
+            DUPRAT(quot, *px);
+            divrat(&quot, root, precision);
+            _addrat(&root, quot, precision);
+            mulnumx(&(root->pq), num_two);
+            trimit(&root, precision);
+            destroyrat(quot);
+        }
+
+        destroyrat(*px);
+        *px = root;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//
+//    FUNCTION: splitexprat, splitlograt, splitsinrat, splitcosrat,
+//              splitatanrat, splitasinrat
+//
+//    ARGUMENTS: pointer to x, the same as _exprat, __lograt, _sinrat,
+//    _cosrat, _atanrat and _asinrat get, and the precision.
+//
+//    RETURN: true if *px has been replaced by the function of x, false if
+//    the precision is below the threshold and the caller should sum the
+//    series itself.
+//
+//-----------------------------------------------------------------------------
+
+bool splitexprat(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < s_splitthreshold)
+    {
+        return false;
+    }
+
+    int32_t cdigits = workdigits(precision);
+    int32_t cbits = workbits(precision);
+
+    ScratchArena splitarena;
+    PRAT pret = nullptr;
+    if (issmallrat(*px))
+    {
+        pret = sumseries(Series::Exp, (*px)->pp, (*px)->pq, cbits);
+    }
+    else
+    {
+        DUPRAT(pret, rat_one);
+        PNUMBER fixed = fixednum(*px, cdigits);
+        int32_t fixedbits = cdigits * BASEXPWR;
+        int32_t hi = topbit(fixed);
+        for (int32_t cchunkbits = FIRSTCHUNKBITS; hi > 0; cchunkbits *= 2)
+        {
+            int32_t lo = max(fixedbits - cchunkbits, 0);
+            PRAT chunk = chunkrat(fixed, lo, hi, fixedbits);
+            hi = min(hi, lo);
+            if (chunk != nullptr)
+            {
+                PRAT expc = sumseries(Series::Exp, chunk->pp, chunk->pq, cbits);
+                mulrat(&pret, expc, precision);
+                destroyrat(expc);
+                destroyrat(chunk);
+            }
+        }
+        destroynum(fixed);
+    }
+
+    replacerat(px, pret, precision);
+    return true;
+}
+
+// x is between 1 and e^0.5 here, log(x) = 2 atanh((x-1)/(x+1)).
+bool splitlograt(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < s_splitthreshold)
+    {
+        return false;
+    }
+
+    ScratchArena splitarena;
+    PRAT y = nullptr;
+    createrat(y);
+    DUPNUM(y->pp, (*px)->pp);
+    DUPNUM(y->pq, (*px)->pp);
+    addnum(&(y->pq), (*px)->pq, BASEX);
+    (*px)->pq->sign *= -1;
+    addnum(&(y->pp), (*px)->pq, BASEX);
+    (*px)->pq->sign *= -1;
+
+    PRAT pret = atansplit(y, Series::Atanh, precision);
+    mulnumx(&(pret->pp), num_two);
+    destroyrat(y);
+
+    replacerat(px, pret, precision);
+    return true;
+}
+
+bool splitsinrat(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < 2 * s_splitthreshold)
+    {
+        return false;
+    }
+
+    sincossplit(*px, px, nullptr, precision);
+    return true;
+}
+
+bool splitcosrat(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < 2 * s_splitthreshold)
+    {
+        return false;
+    }
+
+    sincossplit(*px, nullptr, px, precision);
+    return true;
+}
+
+// abs(x) is at most 0.85 here, or 0.5 after atanrat has inverted it.
+bool splitatanrat(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < s_splitthreshold || !rat_lt(*px, rat_one, precision) || !rat_gt(*px, rat_neg_one, precision))
+    {
+        return false;
+    }
+
+    ScratchArena splitarena;
+    PRAT pret = atansplit(*px, Series::Atan, precision);
+    replacerat(px, pret, precision);
+    return true;
+}
+
+// abs(x) is at most 0.85 here, asin(x) = 2 atan(x/(1+sqrt(1-x^2))) for a
+// full precision x, the argument of atan is then below 0.56.
+bool splitasinrat(_Inout_ PRAT* px, int32_t precision)
+{
+    if (workdigits(precision) < s_splitthreshold || !rat_lt(*px, rat_one, precision) || !rat_gt(*px, rat_neg_one, precision))
+    {
+        return false;
+    }
+
+    ScratchArena splitarena;
+    PRAT pret = nullptr;
+    if (issmallrat(*px))
+    {
+        pret = sumseries(Series::Asin, (*px)->pp, (*px)->pq, workbits(precision));
+    }
+    else
+    {
+        PRAT root = nullptr;
+        DUPRAT(root, *px);
+        mulrat(&root, *px, precision);
+        root->pp->sign *= -1;
+        _addrat(&root, rat_one, precision);
+        sqrtsplit(&root, precision);
+        _addrat(&root, rat_one, precision);
+
+        PRAT t = nullptr;
+        DUPRAT(t, *px);
+        divrat(&t, root, precision);
+        pret = atansplit(t, Series::Atan, precision);
+        mulnumx(&(pret->pp), num_two);
+
+        destroyrat(t);
+        destroyrat(root);
+    }
+
+    replacerat(px, pret, precision);
+    return true;
+}
+
+void SetSeriesThreshold(int32_t split)
+{
+    s_splitthreshold = max(split, 1);
+}
+
+void GetSeriesThreshold(_Out_ int32_t* split)
+{
+    *split = s_splitthreshold;
+}
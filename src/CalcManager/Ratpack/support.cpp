@@ -18,17 +18,19 @@
 //
 //----------------------------------------------------------------------------
 
+#include <cmath>
 #include <string>
 #include <cstring>  // for memmove
 #include <iostream> // for wostream
 #include "ratpak.h"
+#include "ratbigconst.h"
 
 using namespace std;
 
 void _readconstants();
 
 #if defined(GEN_CONST)
-static int cbitsofprecision = 0;
+static constexpr int cbitsofprecision = 0;
 #define READRAWRAT(v)
 #define READRAWNUM(v)
 #define DUMPRAWRAT(v) _dumprawrat(#v, v, wcout)
@@ -43,6 +45,7 @@ static int cbitsofprecision = 0;
 #define DUMPRAWRAT(v)
 #define DUMPRAWNUM(v)
 #define READRAWRAT(v)                                                                                                                                          \
+    destroyrat(v);                                                                                                                                             \
     createrat(v);                                                                                                                                              \
     DUPNUM((v)->pp, (&(init_p_##v)));                                                                                                                          \
     DUPNUM((v)->pq, (&(init_q_##v)));
@@ -65,57 +68,173 @@ static constexpr int RATIO_FOR_DECIMAL = 9;
 static constexpr int DECIMAL = 10;
 static constexpr int CALC_DECIMAL_DIGITS_DEFAULT = 32;
 
-static int cbitsofprecision = RATIO_FOR_DECIMAL * DECIMAL * CALC_DECIMAL_DIGITS_DEFAULT;
+static constexpr int cbitsofprecision = RATIO_FOR_DECIMAL * DECIMAL * CALC_DECIMAL_DIGITS_DEFAULT;
 
 #include "ratconst.h"
 
 #endif
 
-bool g_ftrueinfinite = false; // Set to true if you don't want
-                              // chopping internally
-                              // precision used internally
-
-PNUMBER num_one = nullptr;
-PNUMBER num_two = nullptr;
-PNUMBER num_five = nullptr;
-PNUMBER num_six = nullptr;
-PNUMBER num_ten = nullptr;
-
-PRAT ln_ten = nullptr;
-PRAT ln_two = nullptr;
-PRAT rat_zero = nullptr;
-PRAT rat_one = nullptr;
-PRAT rat_neg_one = nullptr;
-PRAT rat_two = nullptr;
-PRAT rat_six = nullptr;
-PRAT rat_half = nullptr;
-PRAT rat_ten = nullptr;
-PRAT pt_eight_five = nullptr;
-PRAT pi = nullptr;
-PRAT pi_over_two = nullptr;
-PRAT two_pi = nullptr;
-PRAT one_pt_five_pi = nullptr;
-PRAT e_to_one_half = nullptr;
-PRAT rat_exp = nullptr;
-PRAT rad_to_deg = nullptr;
-PRAT rad_to_grad = nullptr;
-PRAT rat_qword = nullptr;
-PRAT rat_dword = nullptr; // unsigned max ui32
-PRAT rat_word = nullptr;
-PRAT rat_byte = nullptr;
-PRAT rat_360 = nullptr;
-PRAT rat_400 = nullptr;
-PRAT rat_180 = nullptr;
-PRAT rat_200 = nullptr;
-PRAT rat_nRadix = nullptr;
-PRAT rat_smallest = nullptr;
-PRAT rat_negsmallest = nullptr;
-PRAT rat_max_exp = nullptr;
-PRAT rat_min_exp = nullptr;
-PRAT rat_max_fact = nullptr;
-PRAT rat_min_fact = nullptr;
-PRAT rat_min_i32 = nullptr; // min signed i32
-PRAT rat_max_i32 = nullptr; // max signed i32
+thread_local bool g_ftrueinfinite = false; // Set to true if you don't want
+                                           // chopping internally
+                                           // precision used internally
+
+thread_local PNUMBER num_one = nullptr;
+thread_local PNUMBER num_two = nullptr;
+thread_local PNUMBER num_five = nullptr;
+thread_local PNUMBER num_six = nullptr;
+thread_local PNUMBER num_ten = nullptr;
+
+thread_local PRAT ln_ten = nullptr;
+thread_local PRAT ln_two = nullptr;
+thread_local PRAT rat_zero = nullptr;
+thread_local PRAT rat_one = nullptr;
+thread_local PRAT rat_neg_one = nullptr;
+thread_local PRAT rat_two = nullptr;
+thread_local PRAT rat_six = nullptr;
+thread_local PRAT rat_half = nullptr;
+thread_local PRAT rat_ten = nullptr;
+thread_local PRAT pt_eight_five = nullptr;
+thread_local PRAT pi = nullptr;
+thread_local PRAT pi_over_two = nullptr;
+thread_local PRAT two_pi = nullptr;
+thread_local PRAT one_pt_five_pi = nullptr;
+thread_local PRAT e_to_one_half = nullptr;
+thread_local PRAT rat_exp = nullptr;
+thread_local PRAT rad_to_deg = nullptr;
+thread_local PRAT rad_to_grad = nullptr;
+thread_local PRAT rat_qword = nullptr;
+thread_local PRAT rat_dword = nullptr; // unsigned max ui32
+thread_local PRAT rat_word = nullptr;
+thread_local PRAT rat_byte = nullptr;
+thread_local PRAT rat_360 = nullptr;
+thread_local PRAT rat_400 = nullptr;
+thread_local PRAT rat_180 = nullptr;
+thread_local PRAT rat_200 = nullptr;
+thread_local PRAT rat_nRadix = nullptr;
+thread_local PRAT rat_smallest = nullptr;
+thread_local PRAT rat_negsmallest = nullptr;
+thread_local PRAT rat_max_exp = nullptr;
+thread_local PRAT rat_min_exp = nullptr;
+thread_local PRAT rat_max_fact = nullptr;
+thread_local PRAT rat_min_fact = nullptr;
+thread_local PRAT rat_min_i32 = nullptr; // min signed i32
+thread_local PRAT rat_max_i32 = nullptr; // max signed i32
+
+thread_local uint32_t g_constantsradix = 0;
+thread_local int32_t g_constantsprecision = 0;
+thread_local uint32_t g_constantsgeneration = 0;
+
+namespace
+{
+    // The constants that are only good to the precision they were worked out
+    // to, the rest are exact.
+    constexpr size_t CPRECISIONCONSTANTS = 10;
+    thread_local PRAT* const s_precisionconstants[CPRECISIONCONSTANTS] = { &pi,      &two_pi, &pi_over_two, &one_pt_five_pi, &e_to_one_half,
+                                                                           &rat_exp, &ln_ten, &ln_two,      &rad_to_deg,     &rad_to_grad };
+
+    // The most precise set of them so far, anything less precise is had by
+    // trimming a copy.
+    thread_local uint32_t s_cachedradix = 0;
+    thread_local int32_t s_cachedprecision = 0;
+    thread_local double s_cachedbits = 0;
+    thread_local PRAT s_cachedconstants[CPRECISIONCONSTANTS] = {};
+
+    double bitsofprecision(uint32_t radix, int32_t precision)
+    {
+        return precision * log2(radix);
+    }
+
+    bool readcachedconstants(uint32_t radix, int32_t precision)
+    {
+        if (bitsofprecision(radix, precision) > s_cachedbits)
+        {
+            return false;
+        }
+
+        bool exact = (radix == s_cachedradix && precision == s_cachedprecision);
+        for (size_t i = 0; i < CPRECISIONCONSTANTS; i++)
+        {
+            DUPRAT(*s_precisionconstants[i], s_cachedconstants[i]);
+            if (!exact)
+            {
+                trimit(s_precisionconstants[i], precision);
+            }
+        }
+        return true;
+    }
+
+    void cacheconstants(uint32_t radix, int32_t precision)
+    {
+        double cbits = bitsofprecision(radix, precision);
+        if (cbits > s_cachedbits)
+        {
+            for (size_t i = 0; i < CPRECISIONCONSTANTS; i++)
+            {
+                DUPRAT(s_cachedconstants[i], *s_precisionconstants[i]);
+            }
+            s_cachedradix = radix;
+            s_cachedprecision = precision;
+            s_cachedbits = cbits;
+
+            // Less precise constants are trimmed from these from now on,
+            // which can leave their last digits different.
+            g_constantsgeneration++;
+        }
+    }
+
+    void readbigconst(_Inout_ PRAT* pc, _In_ const NUMBER* pnum, int32_t precision)
+    {
+        destroyrat(*pc);
+        createrat(*pc);
+        DUPNUM((*pc)->pp, pnum);
+        DUPNUM((*pc)->pq, &init_big_denominator);
+        trimit(pc, precision);
+    }
+
+    // Reads the constants ratbigconst.h has, if it has enough bits of them
+    // to leave trimit something to cut.
+    bool readbigconstants(uint32_t radix, int32_t precision)
+    {
+        if (bitsofprecision(radix, precision) > BIGCONSTBITS - 2 * BASEXPWR)
+        {
+            return false;
+        }
+
+        readbigconst(&pi, &init_big_pi, precision);
+        readbigconst(&e_to_one_half, &init_big_e_to_one_half, precision);
+        readbigconst(&rat_exp, &init_big_rat_exp, precision);
+        readbigconst(&ln_ten, &init_big_ln_ten, precision);
+        readbigconst(&ln_two, &init_big_ln_two, precision);
+        return true;
+    }
+
+    // Gives the constants of a thread back when it exits.
+    struct CONSTANTSOWNER
+    {
+        ~CONSTANTSOWNER()
+        {
+            PNUMBER* const numconstants[] = { &num_one, &num_two, &num_five, &num_six, &num_ten };
+            PRAT* const ratconstants[] = { &ln_ten, &ln_two, &rat_zero, &rat_one, &rat_neg_one, &rat_two, &rat_six, &rat_half, &rat_ten, &pt_eight_five, &pi,
+                                           &pi_over_two, &two_pi, &one_pt_five_pi, &e_to_one_half, &rat_exp, &rad_to_deg, &rad_to_grad, &rat_qword, &rat_dword,
+                                           &rat_word, &rat_byte, &rat_360, &rat_400, &rat_180, &rat_200, &rat_nRadix, &rat_smallest, &rat_negsmallest,
+                                           &rat_max_exp, &rat_min_exp, &rat_max_fact, &rat_min_fact, &rat_min_i32, &rat_max_i32 };
+
+            for (PNUMBER* pnum : numconstants)
+            {
+                destroynum(*pnum);
+            }
+            for (PRAT* prat : ratconstants)
+            {
+                destroyrat(*prat);
+            }
+            for (PRAT& prat : s_cachedconstants)
+            {
+                destroyrat(prat);
+            }
+            s_cachedbits = 0;
+        }
+    };
+}
 
 //----------------------------------------------------------------------------
 //
@@ -138,10 +257,20 @@ void ChangeConstants(uint32_t radix, int32_t precision)
 
     g_ratio = static_cast<int32_t>(ceil(BASEXPWR / log2(radix))) - 1;
 
+    // Nothing worked out with the constants for one radix and precision should
+    // outlive them, even if they are set again later.
+    if (radix != g_constantsradix || precision != g_constantsprecision)
+    {
+        g_constantsgeneration++;
+    }
+    g_constantsradix = radix;
+    g_constantsprecision = precision;
+
     destroyrat(rat_nRadix);
     rat_nRadix = i32torat(radix);
 
-    // Check to see what we have to recalculate and what we don't
+    // Check to see what we have to recalculate and what we don't, ratconst.h
+    // only holds the constants to the default precision.
     if (cbitsofprecision < (g_ratio * static_cast<int32_t>(radix) * precision))
     {
         g_ftrueinfinite = false;
@@ -218,54 +347,63 @@ void ChangeConstants(uint32_t radix, int32_t precision)
         rat_min_exp->pp->sign *= -1;
         DUMPRAWRAT(rat_min_exp);
 
-        cbitsofprecision = g_ratio * radix * precision;
-
         // Apparently when dividing 180 by pi, another (internal) digit of
         // precision is needed.
         int32_t extraPrecision = precision + g_ratio;
-        DUPRAT(pi, rat_half);
-        asinrat(&pi, radix, extraPrecision);
-        mulrat(&pi, rat_six, extraPrecision);
-        DUMPRAWRAT(pi);
+        if (!readcachedconstants(radix, extraPrecision))
+        {
+            if (!readbigconstants(radix, extraPrecision))
+            {
+                DUPRAT(pi, rat_half);
+                asinrat(&pi, radix, extraPrecision);
+                mulrat(&pi, rat_six, extraPrecision);
 
-        DUPRAT(two_pi, pi);
-        DUPRAT(pi_over_two, pi);
-        DUPRAT(one_pt_five_pi, pi);
-        _addrat(&two_pi, pi, extraPrecision);
-        DUMPRAWRAT(two_pi);
+                DUPRAT(e_to_one_half, rat_half);
+                _exprat(&e_to_one_half, extraPrecision);
 
-        divrat(&pi_over_two, rat_two, extraPrecision);
-        DUMPRAWRAT(pi_over_two);
+                DUPRAT(rat_exp, rat_one);
+                _exprat(&rat_exp, extraPrecision);
 
-        _addrat(&one_pt_five_pi, pi_over_two, extraPrecision);
-        DUMPRAWRAT(one_pt_five_pi);
+                // WARNING: remember _lograt uses exponent constants calculated above...
 
-        DUPRAT(e_to_one_half, rat_half);
-        _exprat(&e_to_one_half, extraPrecision);
-        DUMPRAWRAT(e_to_one_half);
+                DUPRAT(ln_ten, rat_ten);
+                _lograt(&ln_ten, extraPrecision);
 
-        DUPRAT(rat_exp, rat_one);
-        _exprat(&rat_exp, extraPrecision);
-        DUMPRAWRAT(rat_exp);
+                DUPRAT(ln_two, rat_two);
+                _lograt(&ln_two, extraPrecision);
+            }
 
-        // WARNING: remember _lograt uses exponent constants calculated above...
+            DUPRAT(two_pi, pi);
+            DUPRAT(pi_over_two, pi);
+            DUPRAT(one_pt_five_pi, pi);
+            _addrat(&two_pi, pi, extraPrecision);
 
-        DUPRAT(ln_ten, rat_ten);
-        _lograt(&ln_ten, extraPrecision);
-        DUMPRAWRAT(ln_ten);
+            divrat(&pi_over_two, rat_two, extraPrecision);
 
-        DUPRAT(ln_two, rat_two);
-        _lograt(&ln_two, extraPrecision);
-        DUMPRAWRAT(ln_two);
+            _addrat(&one_pt_five_pi, pi_over_two, extraPrecision);
 
-        destroyrat(rad_to_deg);
-        rad_to_deg = i32torat(180L);
-        divrat(&rad_to_deg, pi, extraPrecision);
-        DUMPRAWRAT(rad_to_deg);
+            destroyrat(rad_to_deg);
+            rad_to_deg = i32torat(180L);
+            divrat(&rad_to_deg, pi, extraPrecision);
+
+            destroyrat(rad_to_grad);
+            rad_to_grad = i32torat(200L);
+            divrat(&rad_to_grad, pi, extraPrecision);
 
-        destroyrat(rad_to_grad);
-        rad_to_grad = i32torat(200L);
-        divrat(&rad_to_grad, pi, extraPrecision);
+            // Switching back to this precision, or any below it, is then
+            // just a copy.
+            cacheconstants(radix, extraPrecision);
+        }
+
+        DUMPRAWRAT(pi);
+        DUMPRAWRAT(two_pi);
+        DUMPRAWRAT(pi_over_two);
+        DUMPRAWRAT(one_pt_five_pi);
+        DUMPRAWRAT(e_to_one_half);
+        DUMPRAWRAT(rat_exp);
+        DUMPRAWRAT(ln_ten);
+        DUMPRAWRAT(ln_two);
+        DUMPRAWRAT(rad_to_deg);
         DUMPRAWRAT(rad_to_grad);
     }
     else
@@ -277,6 +415,10 @@ void ChangeConstants(uint32_t radix, int32_t precision)
         DUPRAT(rat_negsmallest, rat_smallest);
         rat_negsmallest->pp->sign = -1;
     }
+
+    // The allocator has set up its own clean up by now, the constants get
+    // released first when the thread exits.
+    thread_local CONSTANTSOWNER owner;
 }
 
 //----------------------------------------------------------------------------
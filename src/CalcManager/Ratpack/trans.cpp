@@ -66,20 +66,24 @@ void scalerat(_Inout_ PRAT* pa, AngleType angletype, uint32_t radix, int32_t pre
 void _sinrat(PRAT* px, int32_t precision)
 
 {
-    CREATETAYLOR();
+    // Binary splitting beats the series below once there are enough digits.
+    if (!splitsinrat(px, precision))
+    {
+        CREATETAYLOR();
 
-    DUPRAT(pret, *px);
-    DUPRAT(thisterm, *px);
+        DUPRAT(pret, *px);
+        DUPRAT(thisterm, *px);
 
-    DUPNUM(n2, num_one);
-    xx->pp->sign *= -1;
+        DUPNUM(n2, num_one);
+        xx->pp->sign *= -1;
 
-    do
-    {
-        NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
-    } while (!SMALL_ENOUGH_RAT(thisterm, precision));
+        do
+        {
+            NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
+        } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
-    DESTROYTAYLOR();
+        DESTROYTAYLOR();
+    }
 
     // Since *px might be epsilon above 1 or below -1, due to TRIMIT we need
     // this trick here.
@@ -158,25 +162,29 @@ void sinanglerat(_Inout_ PRAT* pa, AngleType angletype, uint32_t radix, int32_t
 void _cosrat(PRAT* px, uint32_t radix, int32_t precision)
 
 {
-    CREATETAYLOR();
+    // Binary splitting beats the series below once there are enough digits.
+    if (!splitcosrat(px, precision))
+    {
+        CREATETAYLOR();
 
-    destroynum(pret->pp);
-    destroynum(pret->pq);
+        destroynum(pret->pp);
+        destroynum(pret->pq);
 
-    pret->pp = i32tonum(1L, radix);
-    pret->pq = i32tonum(1L, radix);
+        pret->pp = i32tonum(1L, radix);
+        pret->pq = i32tonum(1L, radix);
 
-    DUPRAT(thisterm, pret)
+        DUPRAT(thisterm, pret)
 
-    n2 = i32tonum(0L, radix);
-    xx->pp->sign *= -1;
+        n2 = i32tonum(0L, radix);
+        xx->pp->sign *= -1;
 
-    do
-    {
-        NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
-    } while (!SMALL_ENOUGH_RAT(thisterm, precision));
+        do
+        {
+            NEXTTERM(xx, INC(n2) DIVNUM(n2) INC(n2) DIVNUM(n2), precision);
+        } while (!SMALL_ENOUGH_RAT(thisterm, precision));
 
-    DESTROYTAYLOR();
+        DESTROYTAYLOR();
+    }
     // Since *px might be epsilon above 1 or below -1, due to TRIMIT we need
     // this trick here.
     inbetween(px, rat_one, precision);
@@ -4,7 +4,7 @@
 #include <cassert>
 #include <cmath>
 #include <sstream>
-#include <algorithm> // for std::sort
+#include <algorithm> // for std::sort, std::min_element
 #include "Command.h"
 #include "UnitConverter.h"
 #include "NumberFormattingUtils.h"
@@ -28,6 +28,57 @@ static constexpr wchar_t RIGHTESCAPECHAR = L'}';
 static const double OPTIMALDECIMALALLOWED = 1e-6;  // pow(10, -1 * (OPTIMALDIGITSALLOWED - 1));
 static const double MINIMUMDECIMALALLOWED = 1e-14; // pow(10, -1 * (MAXIMUMDIGITSALLOWED - 1));
 
+namespace
+{
+    // Suggestions show fewer decimals the bigger they are. The value is rounded into the buffer.
+    wstring_view RoundSuggestedValue(double value, wchar_t (&buffer)[MAX_FORMATTED_LENGTH])
+    {
+        unsigned int precision;
+        if (abs(value) < 100)
+        {
+            precision = 2U;
+        }
+        else if (abs(value) < 1000)
+        {
+            precision = 1U;
+        }
+        else
+        {
+            precision = 0U;
+        }
+        return { buffer, FormatFixed(value, precision, buffer, size(buffer)) };
+    }
+
+    // The key of the exact conversion between two units in m_exactConversions.
+    uint64_t ExactConversionKey(const Unit& fromType, const Unit& toType)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(fromType.id)) << 32) | static_cast<uint32_t>(toType.id);
+    }
+
+    // Whether a value rounded to nothing but zeros, with or without a sign, without parsing it back.
+    bool IsRoundedToZero(wstring_view roundedString)
+    {
+        return roundedString.find_first_not_of(L"-0.") == wstring_view::npos;
+    }
+
+    // Rounds a value into the display's own storage, without its trailing zeros, so that once the display has grown
+    // converting doesn't allocate.
+    void AssignRounded(wstring& display, double value, unsigned int precision)
+    {
+        wchar_t buffer[MAX_FORMATTED_LENGTH];
+        const size_t length = FormatFixed(value, precision, buffer, size(buffer));
+        if (length <= size(buffer))
+        {
+            display.assign(WithoutTrailingZeros({ buffer, length }));
+        }
+        else
+        {
+            display = RoundSignificantDigits(value, precision);
+            TrimTrailingZeros(display);
+        }
+    }
+}
+
 unordered_map<wchar_t, wstring> quoteConversions;
 unordered_map<wstring, wchar_t> unquoteConversions;
 
@@ -66,6 +117,7 @@ UnitConverter::UnitConverter(_In_ const shared_ptr<IConverterDataLoader>& dataLo
     unquoteConversions[L"{sc}"] = L';';
     unquoteConversions[L"{lb}"] = LEFTESCAPECHAR;
     unquoteConversions[L"{rb}"] = RIGHTESCAPECHAR;
+    m_isExactConversion = false;
     ClearValues();
     ResetCategoriesAndRatios();
 }
@@ -202,6 +254,20 @@ bool UnitConversionManager::UnitConverter::IsSwitchedActive() const
     return m_switchedActive;
 }
 
+/// <summary>
+/// Chooses whether conversions are worked out in rationals, from the ratios the loaders give exactly, rather than in doubles.
+/// Conversions without exact ratios, such as currencies, are always done in doubles. Takes effect from the next calculation.
+/// </summary>
+void UnitConverter::SetExactConversion(bool isExact)
+{
+    m_isExactConversion = isExact;
+}
+
+bool UnitConverter::IsExactConversion() const
+{
+    return m_isExactConversion;
+}
+
 wstring UnitConverter::CategoryToString(const Category& c, wstring_view delimiter)
 {
     return Quote(std::to_wstring(c.id))
@@ -602,6 +668,53 @@ double UnitConverter::Convert(double value, const ConversionData& conversionData
     }
 }
 
+/// <summary>
+/// Converts the current display value in rationals, reading the exact ratio between the units the first time it is needed.
+/// Falls back to Convert when the loader gave no exact ratio.
+/// </summary>
+double UnitConverter::ConvertExactly(const Unit& fromType, const Unit& toType, const ConversionData& conversion)
+{
+    auto [exactConversion, isNew] = m_exactConversions.try_emplace(ExactConversionKey(fromType, toType));
+    if (isNew)
+    {
+        exactConversion->second = LoadExactConversion(fromType, toType);
+    }
+
+    optional<double> returnValue = exactConversion->second.has_value() ? exactConversion->second->TryConvert(m_currentDisplay) : nullopt;
+    return returnValue.has_value() ? *returnValue : Convert(stod(m_currentDisplay), conversion);
+}
+
+/// <summary>
+/// Reads the exact conversion between two units that have a conversion, from their exact factors or the exact ratio
+/// and offset the loader gave for the pair
+/// </summary>
+optional<ExactConversion> UnitConverter::LoadExactConversion(const Unit& fromType, const Unit& toType) const
+{
+    const ConversionTableSlot* fromSlot = FindConversionTableSlot(fromType);
+    const ConversionTableSlot* toSlot = FindConversionTableSlot(toType);
+    const ConversionBlock& block = m_conversionBlocks[fromSlot->block];
+    if (block.conversions.empty())
+    {
+        const vector<wstring>& exactFactors = block.factors.exactFactors;
+        if (exactFactors.empty())
+        {
+            return nullopt;
+        }
+
+        const wstring& fromFactor = exactFactors[fromSlot->index];
+        const wstring& toFactor = exactFactors[toSlot->index];
+        return block.factors.factorsAreRates ? ExactConversion::TryCreateQuotient(toFactor, fromFactor)
+                                             : ExactConversion::TryCreateQuotient(fromFactor, toFactor);
+    }
+
+    const ConversionData& conversion = *block.conversions[fromSlot->index * block.unitCount + toSlot->index];
+    if (conversion.offset != 0.0 && conversion.exactOffset.empty())
+    {
+        return nullopt;
+    }
+    return ExactConversion::TryCreate(conversion.exactRatio, conversion.exactOffset, conversion.offsetFirst);
+}
+
 /// <summary>
 /// Calculates the suggested values for the current display value and returns them as a vector
 /// </summary>
@@ -613,107 +726,114 @@ vector<tuple<wstring, Unit>> UnitConverter::CalculateSuggested()
     }
 
     vector<tuple<wstring, Unit>> returnVector;
-    vector<SuggestedValueIntermediate> intermediateVector;
-    vector<SuggestedValueIntermediate> intermediateWhimsicalVector;
-    unordered_map<Unit, ConversionData, UnitHash> ratios = m_ratioMap[m_fromType];
-    // Calculate converted values for every other unit type in this category, along with their magnitude
-    for (const auto& cur : ratios)
+    const double currentValue = stod(m_currentDisplay);
+    LoadSuggestedValues();
+
+    // Calculate converted values for every other unit type in this category, along with their magnitude. Neither loop
+    // branches, so both can be vectorized.
+    SuggestedValues& suggested = m_suggested;
+    const size_t count = suggested.units.size();
+    suggested.values.resize(count);
+    suggested.magnitudes.resize(count);
+    for (size_t i = 0; i < count; i++)
     {
-        if (cur.first != m_fromType && cur.first != m_toType)
-        {
-            double convertedValue = Convert(stod(m_currentDisplay), cur.second);
-            SuggestedValueIntermediate newEntry;
-            newEntry.magnitude = log10(convertedValue);
-            newEntry.value = convertedValue;
-            newEntry.type = cur.first;
-            if (newEntry.type.isWhimsical)
-                intermediateWhimsicalVector.push_back(newEntry);
-            else
-                intermediateVector.push_back(newEntry);
-        }
+        suggested.values[i] = (currentValue + suggested.offsetsBefore[i]) * suggested.ratios[i] + suggested.offsetsAfter[i];
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        suggested.magnitudes[i] = log10(suggested.values[i]);
     }
-
-    // Sort the resulting list by absolute magnitude, breaking ties by choosing the positive value
-    sort(intermediateVector.begin(), intermediateVector.end(), [](SuggestedValueIntermediate first, SuggestedValueIntermediate second) {
-        if (abs(first.magnitude) == abs(second.magnitude))
-        {
-            return first.magnitude > second.magnitude;
-        }
-        else
-        {
-            return abs(first.magnitude) < abs(second.magnitude);
-        }
-    });
 
     // Now that the list is sorted, iterate over it and populate the return vector with properly rounded and formatted return strings
-    for (const auto& entry : intermediateVector)
+    SortSuggestedValues(suggested.order);
+    returnVector.reserve(suggested.order.size() + 1);
+    wchar_t buffer[MAX_FORMATTED_LENGTH];
+    for (size_t i : suggested.order)
     {
-        wstring roundedString;
-        if (abs(entry.value) < 100)
+        const wstring_view roundedString = RoundSuggestedValue(suggested.values[i], buffer);
+        if (!IsRoundedToZero(roundedString) || m_currentCategory.supportsNegative)
         {
-            roundedString = RoundSignificantDigits(entry.value, 2U);
-        }
-        else if (abs(entry.value) < 1000)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 1U);
-        }
-        else
-        {
-            roundedString = RoundSignificantDigits(entry.value, 0U);
-        }
-        if (stod(roundedString) != 0.0 || m_currentCategory.supportsNegative)
-        {
-            TrimTrailingZeros(roundedString);
-            returnVector.emplace_back(roundedString, entry.type);
+            returnVector.emplace_back(WithoutTrailingZeros(roundedString), *suggested.units[i]);
         }
     }
 
     // The Whimsicals are determined differently
-    // Sort the resulting list by absolute magnitude, breaking ties by choosing the positive value
-    sort(intermediateWhimsicalVector.begin(), intermediateWhimsicalVector.end(), [](SuggestedValueIntermediate first, SuggestedValueIntermediate second) {
-        if (abs(first.magnitude) == abs(second.magnitude))
-        {
-            return first.magnitude > second.magnitude;
-        }
-        else
+    // Pickup the 'best' whimsical value - currently the first one in sorted order that doesn't round to zero. Only that one
+    // is shown, so rather than sorting them all the best left is scanned for, and dropped if it does round to zero.
+    vector<size_t>& whimsicals = suggested.whimsicalOrder;
+    while (!whimsicals.empty())
+    {
+        auto best = min_element(whimsicals.begin(), whimsicals.end(), [this](size_t first, size_t second) {
+            return IsSuggestedValueBefore(first, second);
+        });
+        const wstring_view roundedString = RoundSuggestedValue(suggested.values[*best], buffer);
+        if (!IsRoundedToZero(roundedString))
         {
-            return abs(first.magnitude) < abs(second.magnitude);
+            returnVector.emplace_back(WithoutTrailingZeros(roundedString), *suggested.units[*best]);
+            break;
         }
-    });
+        *best = whimsicals.back();
+        whimsicals.pop_back();
+    }
 
-    // Now that the list is sorted, iterate over it and populate the return vector with properly rounded and formatted return strings
-    vector<tuple<wstring, Unit>> whimsicalReturnVector;
+    return returnVector;
+}
 
-    for (const auto& entry : intermediateWhimsicalVector)
+/// <summary>
+/// Gathers the units to suggest values in, and the conversions to them from the current unit, into m_suggested
+/// </summary>
+void UnitConverter::LoadSuggestedValues()
+{
+    SuggestedValues& suggested = m_suggested;
+    suggested.units.clear();
+    suggested.offsetsBefore.clear();
+    suggested.ratios.clear();
+    suggested.offsetsAfter.clear();
+    suggested.order.clear();
+    suggested.whimsicalOrder.clear();
+
+    auto categoryUnits = m_categoryToUnits.find(m_currentCategory.id);
+    if (categoryUnits == m_categoryToUnits.end())
     {
-        wstring roundedString;
-        if (abs(entry.value) < 100)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 2U);
-        }
-        else if (abs(entry.value) < 1000)
-        {
-            roundedString = RoundSignificantDigits(entry.value, 1U);
-        }
-        else
-        {
-            roundedString = RoundSignificantDigits(entry.value, 0U);
-        }
+        return;
+    }
 
-        // How to work out which is the best whimsical value to add to the vector?
-        if (stod(roundedString) != 0.0)
+    for (const Unit& unit : categoryUnits->second)
+    {
+        optional<ConversionData> conversion = FindConversion(m_fromType, unit);
+        if (conversion.has_value() && unit != m_fromType && unit != m_toType)
         {
-            TrimTrailingZeros(roundedString);
-            whimsicalReturnVector.emplace_back(roundedString, entry.type);
+            (unit.isWhimsical ? suggested.whimsicalOrder : suggested.order).push_back(suggested.units.size());
+            suggested.units.push_back(&unit);
+            suggested.offsetsBefore.push_back(conversion->offsetFirst ? conversion->offset : 0.0);
+            suggested.ratios.push_back(conversion->ratio);
+            suggested.offsetsAfter.push_back(conversion->offsetFirst ? 0.0 : conversion->offset);
         }
     }
-    // Pickup the 'best' whimsical value - currently the first one
-    if (!whimsicalReturnVector.empty())
+}
+
+/// <summary>
+/// Sorts indices into m_suggested by the absolute magnitude of their values, breaking ties by choosing the positive value
+/// </summary>
+void UnitConverter::SortSuggestedValues(vector<size_t>& order) const
+{
+    sort(order.begin(), order.end(), [this](size_t first, size_t second) { return IsSuggestedValueBefore(first, second); });
+}
+
+/// <summary>
+/// Whether the value at index first into m_suggested is suggested ahead of the one at index second
+/// </summary>
+bool UnitConverter::IsSuggestedValueBefore(size_t first, size_t second) const
+{
+    const vector<double>& magnitudes = m_suggested.magnitudes;
+    if (abs(magnitudes[first]) == abs(magnitudes[second]))
     {
-        returnVector.push_back(whimsicalReturnVector.front());
+        return magnitudes[first] > magnitudes[second];
+    }
+    else
+    {
+        return abs(magnitudes[first]) < abs(magnitudes[second]);
     }
-
-    return returnVector;
 }
 
 /// <summary>
@@ -731,7 +851,9 @@ void UnitConverter::ResetCategoriesAndRatios()
     m_currentCategory = m_categories[0];
 
     m_categoryToUnits.clear();
-    m_ratioMap.clear();
+    m_conversionTableSlots.clear();
+    m_conversionBlocks.clear();
+    m_exactConversions.clear();
     bool readyCategoryFound = false;
     for (const Category& category : m_categories)
     {
@@ -751,10 +873,7 @@ void UnitConverter::ResetCategoriesAndRatios()
         // we just want to make sure we don't let an unready category be the default.
         if (!units.empty())
         {
-            for (const Unit& u : units)
-            {
-                m_ratioMap[u] = activeDataLoader->LoadOrderedRatios(u);
-            }
+            LoadConversionTable(units, activeDataLoader);
 
             if (!readyCategoryFound)
             {
@@ -767,6 +886,90 @@ void UnitConverter::ResetCategoriesAndRatios()
     InitializeSelectedUnits();
 }
 
+/// <summary>
+/// Adds a block for one category to the conversion table, with the factors of its units when the loader has them and a
+/// row for each of its units otherwise
+/// </summary>
+/// <param name="units">the units of the category, in the order their factors or columns will have</param>
+/// <param name="dataLoader">the loader the ratios of these units come from</param>
+void UnitConverter::LoadConversionTable(const vector<Unit>& units, const shared_ptr<IConverterDataLoader>& dataLoader)
+{
+    const size_t block = m_conversionBlocks.size();
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        assert(units[i].id >= 0);
+        const auto id = static_cast<size_t>(units[i].id);
+        if (id >= m_conversionTableSlots.size())
+        {
+            m_conversionTableSlots.resize(id + 1);
+        }
+        m_conversionTableSlots[id] = ConversionTableSlot{ block, i };
+    }
+
+    ConversionBlock& conversions = m_conversionBlocks.emplace_back();
+    conversions.unitCount = units.size();
+    if (dataLoader->TryLoadUnitFactors(units, conversions.factors))
+    {
+        assert(conversions.factors.factors.size() == units.size());
+        assert(conversions.factors.exactFactors.empty() || conversions.factors.exactFactors.size() == units.size());
+        return;
+    }
+
+    conversions.factors = {};
+    conversions.conversions.resize(units.size() * units.size());
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        for (const auto& [toType, conversion] : dataLoader->LoadOrderedRatios(units[i]))
+        {
+            // The loaders only give ratios within a category, and the block has no room for any other.
+            const ConversionTableSlot* toSlot = FindConversionTableSlot(toType);
+            if (toSlot != nullptr && toSlot->block == block)
+            {
+                conversions.conversions[i * units.size() + toSlot->index] = conversion;
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Finds how to convert between two units, without their exact ratio and offset, which only ConvertExactly reads
+/// </summary>
+/// <returns>nullopt when there is no ratio between the units, e.g. when either is the EMPTY_UNIT</returns>
+optional<ConversionData> UnitConverter::FindConversion(const Unit& fromType, const Unit& toType) const
+{
+    const ConversionTableSlot* fromSlot = FindConversionTableSlot(fromType);
+    const ConversionTableSlot* toSlot = FindConversionTableSlot(toType);
+    if (fromSlot == nullptr || toSlot == nullptr || fromSlot->block != toSlot->block)
+    {
+        return nullopt;
+    }
+
+    const ConversionBlock& block = m_conversionBlocks[fromSlot->block];
+    if (block.conversions.empty())
+    {
+        const double fromFactor = block.factors.factors[fromSlot->index];
+        const double toFactor = block.factors.factors[toSlot->index];
+        return ConversionData{ block.factors.factorsAreRates ? toFactor / fromFactor : fromFactor / toFactor, 0.0, false };
+    }
+
+    const optional<ConversionData>& conversion = block.conversions[fromSlot->index * block.unitCount + toSlot->index];
+    if (!conversion.has_value())
+    {
+        return nullopt;
+    }
+    return ConversionData{ conversion->ratio, conversion->offset, conversion->offsetFirst };
+}
+
+const UnitConverter::ConversionTableSlot* UnitConverter::FindConversionTableSlot(const Unit& unit) const
+{
+    if (unit.id < 0 || static_cast<size_t>(unit.id) >= m_conversionTableSlots.size() || !m_conversionTableSlots[unit.id].has_value())
+    {
+        return nullptr;
+    }
+
+    return &*m_conversionTableSlots[unit.id];
+}
+
 /// <summary>
 /// Sets the active data loader based on the input category.
 /// </summary>
@@ -873,8 +1076,8 @@ void UnitConverter::Calculate()
         return;
     }
 
-    unordered_map<Unit, ConversionData, UnitHash> conversionTable = m_ratioMap[m_fromType];
-    if (AnyUnitIsEmpty() || (conversionTable[m_toType].ratio == 1.0 && conversionTable[m_toType].offset == 0.0))
+    optional<ConversionData> conversion = FindConversion(m_fromType, m_toType);
+    if (!conversion.has_value() || (conversion->ratio == 1.0 && conversion->offset == 0.0))
     {
         m_returnDisplay = m_currentDisplay;
         m_returnHasDecimal = m_currentHasDecimal;
@@ -882,22 +1085,21 @@ void UnitConverter::Calculate()
     }
     else
     {
-        double currentValue = stod(m_currentDisplay);
-        const double returnValue = Convert(currentValue, conversionTable[m_toType]);
+        const double returnValue = m_isExactConversion ? ConvertExactly(m_fromType, m_toType, *conversion) : Convert(stod(m_currentDisplay), *conversion);
 
         const auto isCurrencyConverter = m_currencyDataLoader != nullptr && m_currencyDataLoader->SupportsCategory(this->m_currentCategory);
         if (isCurrencyConverter)
         {
             // We don't need to trim the value when it's a currency.
-            m_returnDisplay = RoundSignificantDigits(returnValue, MAXIMUMDIGITSALLOWED);
-            TrimTrailingZeros(m_returnDisplay);
+            AssignRounded(m_returnDisplay, returnValue, MAXIMUMDIGITSALLOWED);
         }
         else
         {
             const unsigned int numPreDecimal = GetNumberDigitsWholeNumberPart(returnValue);
             if (numPreDecimal > MAXIMUMDIGITSALLOWED || (returnValue != 0 && abs(returnValue) < MINIMUMDECIMALALLOWED))
             {
-                m_returnDisplay = ToScientificNumber(returnValue);
+                wchar_t buffer[MAX_FORMATTED_LENGTH];
+                m_returnDisplay.assign(buffer, FormatScientific(returnValue, buffer, size(buffer)));
             }
             else
             {
@@ -915,8 +1117,7 @@ void UnitConverter::Calculate()
                     precision = numberDigits > numPreDecimal ? numberDigits - numPreDecimal : 0;
                 }
 
-                m_returnDisplay = RoundSignificantDigits(returnValue, precision);
-                TrimTrailingZeros(m_returnDisplay);
+                AssignRounded(m_returnDisplay, returnValue, precision);
             }
             m_returnHasDecimal = (m_returnDisplay.find(L'.') != wstring::npos);
         }
@@ -5,9 +5,11 @@
 
 #include <vector>
 #include <unordered_map>
+#include <optional>
 #include <ppltasks.h>
 #include "sal_cross_platform.h" // for SAL
 #include <memory>               // for std::shared_ptr
+#include "ExactConversion.h"
 
 namespace UnitConversionManager
 {
@@ -116,13 +118,6 @@ namespace UnitConversionManager
         }
     };
 
-    struct SuggestedValueIntermediate
-    {
-        double magnitude;
-        double value;
-        Unit type;
-    };
-
     struct ConversionData
     {
         ConversionData()
@@ -138,6 +133,23 @@ namespace UnitConversionManager
         double ratio;
         double offset;
         bool offsetFirst;
+
+        // The same ratio and offset written out exactly, as ExactConversion reads them, when the loader knows them.
+        // The offset may be left empty when it is zero.
+        std::wstring exactRatio;
+        std::wstring exactOffset;
+    };
+
+    // The factors of the units of a category, for categories where converting between two units only multiplies by
+    // the quotient of their factors. The converter keeps a factor per unit then, rather than a ratio per pair of units.
+    struct UnitFactors
+    {
+        std::vector<double> factors;
+        // The same factors written out exactly, as ExactConversion reads them, or empty when the loader doesn't know them.
+        std::vector<std::wstring> exactFactors;
+        // Whether a factor is how many of the unit one base unit is, as currency rates are, rather than how many base
+        // units one of the unit is. Converting multiplies by the factor of the target over that of the source then.
+        bool factorsAreRates = false;
     };
 
     struct CurrencyStaticData
@@ -183,6 +195,13 @@ namespace UnitConversionManager
         virtual std::vector<Unit> GetOrderedUnits(const Category& c) = 0;
         virtual std::unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& u) = 0;
         virtual bool SupportsCategory(const Category& target) = 0;
+
+        // Fills in the factors of the given units of a category, in their order, when every conversion between them is a
+        // quotient of factors. Otherwise the converter reads a ratio for every pair of them through LoadOrderedRatios.
+        virtual bool TryLoadUnitFactors(const std::vector<Unit>& /*units*/, UnitFactors& /*factors*/)
+        {
+            return false;
+        }
     };
 
     class ICurrencyConverterDataLoader
@@ -230,6 +249,8 @@ namespace UnitConversionManager
         virtual concurrency::task<std::pair<bool, std::wstring>> RefreshCurrencyRatios() = 0;
         virtual void Calculate() = 0;
         virtual void ResetCategoriesAndRatios() = 0;
+        virtual void SetExactConversion(bool isExact) = 0;
+        virtual bool IsExactConversion() const = 0;
     };
 
     class UnitConverter : public IUnitConverter, public std::enable_shared_from_this<UnitConverter>
@@ -254,6 +275,8 @@ namespace UnitConversionManager
         concurrency::task<std::pair<bool, std::wstring>> RefreshCurrencyRatios() override;
         void Calculate() override;
         void ResetCategoriesAndRatios() override;
+        void SetExactConversion(bool isExact) override;
+        bool IsExactConversion() const override;
         // IUnitConverter
 
         static std::vector<std::wstring> StringToVector(std::wstring_view w, std::wstring_view delimiter, bool addRemainder = false);
@@ -275,6 +298,44 @@ namespace UnitConversionManager
         bool AnyUnitIsEmpty();
         std::shared_ptr<IConverterDataLoader> GetDataLoaderForCategory(const Category& category);
         std::shared_ptr<ICurrencyConverterDataLoader> GetCurrencyConverterDataLoader();
+        double ConvertExactly(const Unit& fromType, const Unit& toType, const ConversionData& conversion);
+        std::optional<ExactConversion> LoadExactConversion(const Unit& fromType, const Unit& toType) const;
+        void LoadConversionTable(const std::vector<Unit>& units, const std::shared_ptr<IConverterDataLoader>& dataLoader);
+        std::optional<ConversionData> FindConversion(const Unit& fromType, const Unit& toType) const;
+
+        // The conversions within one category: a factor per unit when the loader has them, otherwise a square block
+        // with a ratio per pair of units, from unit by row, as temperatures need for their offsets.
+        struct ConversionBlock
+        {
+            size_t unitCount;
+            UnitFactors factors;
+            std::vector<std::optional<ConversionData>> conversions; // empty when there are factors
+        };
+
+        // Which block a unit's category has in m_conversionBlocks, and which of its units the unit is.
+        struct ConversionTableSlot
+        {
+            size_t block;
+            size_t index;
+        };
+        const ConversionTableSlot* FindConversionTableSlot(const Unit& unit) const;
+
+        // The suggestions for a category, as arrays that are converted in one pass rather than a unit at a time. Kept
+        // between calls, so that typing doesn't allocate once they have grown to the size of the category.
+        struct SuggestedValues
+        {
+            std::vector<const Unit*> units;
+            std::vector<double> offsetsBefore; // added before the ratio is applied, zero unless the conversion has offsetFirst
+            std::vector<double> ratios;
+            std::vector<double> offsetsAfter;
+            std::vector<double> values;
+            std::vector<double> magnitudes;
+            std::vector<size_t> order;
+            std::vector<size_t> whimsicalOrder;
+        };
+        void LoadSuggestedValues();
+        void SortSuggestedValues(std::vector<size_t>& order) const;
+        bool IsSuggestedValueBefore(size_t first, size_t second) const;
 
     private:
         std::shared_ptr<IConverterDataLoader> m_dataLoader;
@@ -283,7 +344,10 @@ namespace UnitConversionManager
         std::shared_ptr<IViewModelCurrencyCallback> m_vmCurrencyCallback;
         std::vector<Category> m_categories;
         CategoryToUnitVectorMap m_categoryToUnits;
-        UnitToUnitToConversionDataMap m_ratioMap;
+        std::vector<std::optional<ConversionTableSlot>> m_conversionTableSlots; // indexed by unit id
+        std::vector<ConversionBlock> m_conversionBlocks; // one per category
+        std::unordered_map<uint64_t, std::optional<ExactConversion>> m_exactConversions; // by from and to unit id, read when first used
+        SuggestedValues m_suggested;
         Category m_currentCategory;
         Unit m_fromType;
         Unit m_toType;
@@ -292,5 +356,6 @@ namespace UnitConversionManager
         bool m_currentHasDecimal;
         bool m_returnHasDecimal;
         bool m_switchedActive;
+        bool m_isExactConversion;
     };
 }
@@ -11,16 +11,20 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
-#include <intsafe.h>
+#include <charconv>
 #include <list>
-#include <ppltasks.h>
 #include <regex>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
-#include <winerror.h>
 #include <iostream>
 #include <cmath>
 #include <random>
 #include <iomanip>
+
+#if defined(_WIN32) && defined(_MSC_VER)
+#include <intsafe.h>
+#include <ppltasks.h>
+#include <winerror.h>
+#endif
@@ -87,6 +87,20 @@ namespace CalculatorApp::ViewModel::Common
         }
     }
 
+    void CalculatorDisplay::UpdateExpressionDisplay(
+        _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
+        _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands,
+        size_t firstChangedToken)
+    {
+        if (m_callbackReference != nullptr)
+        {
+            if (auto calcVM = m_callbackReference.Resolve<ViewModel::StandardCalculatorViewModel>())
+            {
+                calcVM->UpdateExpressionDisplay(tokens, commands, firstChangedToken);
+            }
+        }
+    }
+
     void CalculatorDisplay::SetMemorizedNumbers(_In_ const vector<std::wstring>& newMemorizedNumbers)
     {
         if (m_callbackReference != nullptr)
@@ -154,6 +154,46 @@ namespace CalculatorApp
     }
 }
 
+CurrencyRates::CurrencyRates()
+    : m_firstUnitId(0)
+{
+}
+
+CurrencyRates::CurrencyRates(int firstUnitId, vector<double> rates)
+    : m_firstUnitId(firstUnitId)
+    , m_rates(move(rates))
+{
+}
+
+bool CurrencyRates::Contains(const UCM::Unit& unit) const
+{
+    return unit.id >= m_firstUnitId && static_cast<size_t>(unit.id - m_firstUnitId) < m_rates.size();
+}
+
+bool CurrencyRates::TryGetRatio(const UCM::Unit& from, const UCM::Unit& to, _Out_ double* ratio) const
+{
+    if (!Contains(from) || !Contains(to))
+    {
+        return false;
+    }
+
+    double fromRate = m_rates[from.id - m_firstUnitId];
+    assert(fromRate > 0); // divide by zero assert
+    *ratio = m_rates[to.id - m_firstUnitId] / fromRate;
+    return true;
+}
+
+bool CurrencyRates::TryGetRate(const UCM::Unit& unit, _Out_ double* rate) const
+{
+    if (!Contains(unit))
+    {
+        return false;
+    }
+
+    *rate = m_rates[unit.id - m_firstUnitId];
+    return true;
+}
+
 CurrencyDataLoader::CurrencyDataLoader(const wchar_t* forcedResponseLanguage)
     : m_loadStatus(CurrencyLoadStatus::NotLoaded)
     , m_responseLanguage(L"en-US")
@@ -294,7 +334,39 @@ vector<UCM::Unit> CurrencyDataLoader::GetOrderedUnits(const UCM::Category& /*cat
 unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> CurrencyDataLoader::LoadOrderedRatios(const UCM::Unit& unit)
 {
     lock_guard<mutex> lock(m_currencyUnitsMutex);
-    return m_currencyRatioMap.at(unit);
+    if (!m_currencyRates.Contains(unit))
+    {
+        throw out_of_range("unknown currency unit");
+    }
+
+    unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> conversions;
+    conversions.reserve(m_currencyUnits.size());
+    for (const UCM::Unit& targetUnit : m_currencyUnits)
+    {
+        UCM::ConversionData parsedData = { 1.0, 0.0, false };
+        m_currencyRates.TryGetRatio(unit, targetUnit, &parsedData.ratio);
+        conversions.emplace(targetUnit, parsedData);
+    }
+
+    return conversions;
+}
+
+// The rates of the currencies, so that the converter keeps one per currency rather than a ratio per pair of them.
+bool CurrencyDataLoader::TryLoadUnitFactors(const vector<UCM::Unit>& units, UCM::UnitFactors& factors)
+{
+    lock_guard<mutex> lock(m_currencyUnitsMutex);
+    factors.factors.resize(units.size());
+    factors.factorsAreRates = true;
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        if (!m_currencyRates.TryGetRate(units[i], &factors.factors[i]))
+        {
+            return false;
+        }
+        assert(factors.factors[i] > 0); // divide by zero assert
+    }
+
+    return true;
 }
 
 bool CurrencyDataLoader::SupportsCategory(const UCM::Category& target)
@@ -346,28 +418,22 @@ pair<wstring, wstring> CurrencyDataLoader::GetCurrencyRatioEquality(_In_ const U
 {
     try
     {
-        auto iter = m_currencyRatioMap.find(unit1);
-        if (iter != m_currencyRatioMap.end())
+        double ratio;
+        if (m_currencyRates.TryGetRatio(unit1, unit2, &ratio))
         {
-            unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> ratioMap = iter->second;
-            auto iter2 = ratioMap.find(unit2);
-            if (iter2 != ratioMap.end())
-            {
-                double ratio = (iter2->second).ratio;
-                double rounded = RoundCurrencyRatio(ratio);
+            double rounded = RoundCurrencyRatio(ratio);
 
-                auto digit = LocalizationSettings::GetInstance()->GetDigitSymbolFromEnUsDigit(L'1');
-                auto digitSymbol = ref new String(&digit, 1);
-                auto roundedFormat = m_ratioFormatter->Format(rounded);
+            auto digit = LocalizationSettings::GetInstance()->GetDigitSymbolFromEnUsDigit(L'1');
+            auto digitSymbol = ref new String(&digit, 1);
+            auto roundedFormat = m_ratioFormatter->Format(rounded);
 
-                auto ratioString = LocalizationStringUtil::GetLocalizedString(
-                    m_ratioFormat, digitSymbol, StringReference(unit1.abbreviation.c_str()), roundedFormat, StringReference(unit2.abbreviation.c_str()));
+            auto ratioString = LocalizationStringUtil::GetLocalizedString(
+                m_ratioFormat, digitSymbol, StringReference(unit1.abbreviation.c_str()), roundedFormat, StringReference(unit2.abbreviation.c_str()));
 
-                auto accessibleRatioString = LocalizationStringUtil::GetLocalizedString(
-                    m_ratioFormat, digitSymbol, StringReference(unit1.accessibleName.c_str()), roundedFormat, StringReference(unit2.accessibleName.c_str()));
+            auto accessibleRatioString = LocalizationStringUtil::GetLocalizedString(
+                m_ratioFormat, digitSymbol, StringReference(unit1.accessibleName.c_str()), roundedFormat, StringReference(unit2.accessibleName.c_str()));
 
-                return make_pair(ratioString->Data(), accessibleRatioString->Data());
-            }
+            return make_pair(ratioString->Data(), accessibleRatioString->Data());
         }
     }
     catch (...)
@@ -648,7 +714,7 @@ bool CurrencyDataLoader::TryParseAllRatiosData(_In_ String ^ rawJson, _Inout_ Cu
 #pragma optimize("", off) // Turn off optimizations to work around DevDiv 393321
 task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStaticData>& staticData, _In_ const CurrencyRatioMap& ratioMap)
 {
-    unordered_map<int, pair<UCM::Unit, double>> idToUnit{};
+    vector<double> rates;
 
     SelectedUnits defaultCurrencies = co_await GetDefaultFromToCurrency();
     wstring fromCurrency = defaultCurrencies.first;
@@ -687,7 +753,7 @@ task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStat
 
                 m_currencyUnits.push_back(unit);
                 m_currencyMetadata.emplace(unit, CurrencyUnitMetadata{ currencyUnit.currencySymbol });
-                idToUnit.insert(pair<int, pair<UCM::Unit, double>>(unit.id, pair<UCM::Unit, double>(unit, (itr->second).ratio)));
+                rates.push_back((itr->second).ratio);
                 i++;
             }
         }
@@ -698,23 +764,8 @@ task<void> CurrencyDataLoader::FinalizeUnits(_In_ const vector<UCM::CurrencyStat
             defaultCurrencies = { DEFAULT_FROM_CURRENCY, DEFAULT_TO_CURRENCY };
         }
 
-        m_currencyRatioMap.clear();
-        for (const auto& unit : m_currencyUnits)
-        {
-            unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> conversions;
-            double unitFactor = idToUnit[unit.id].second;
-            for (auto itr = idToUnit.begin(); itr != idToUnit.end(); itr++)
-            {
-                UCM::Unit targetUnit = (itr->second).first;
-                double conversionRatio = (itr->second).second;
-                UCM::ConversionData parsedData = { 1.0, 0.0, false };
-                assert(unitFactor > 0); // divide by zero assert
-                parsedData.ratio = conversionRatio / unitFactor;
-                conversions.insert(make_pair(targetUnit, parsedData));
-            }
-
-            m_currencyRatioMap.insert(make_pair(unit, conversions));
-        }
+        // The units were given consecutive ids, in the order of their rates.
+        m_currencyRates = CurrencyRates{ static_cast<int>(UnitConverterUnits::UnitEnd + 1), move(rates) };
     } // unlocked m_currencyUnitsMutex
 
     SaveSelectedUnitsToLocalSettings(defaultCurrencies);
@@ -51,6 +51,24 @@ namespace CalculatorApp
             const std::wstring symbol;
         };
 
+        // The rate of each currency against the one the ratios were downloaded for, by unit id. The ratio between two
+        // currencies is worked out from their rates when it is asked for, so the store grows with the number of
+        // currencies rather than with its square.
+        class CurrencyRates
+        {
+        public:
+            CurrencyRates();
+            CurrencyRates(int firstUnitId, std::vector<double> rates);
+
+            bool Contains(const UCM::Unit& unit) const;
+            bool TryGetRatio(const UCM::Unit& from, const UCM::Unit& to, _Out_ double* ratio) const;
+            bool TryGetRate(const UCM::Unit& unit, _Out_ double* rate) const;
+
+        private:
+            int m_firstUnitId;
+            std::vector<double> m_rates; // the rate of the currency whose unit id is m_firstUnitId + i at i
+        };
+
         class CurrencyDataLoader : public UCM::IConverterDataLoader, public UCM::ICurrencyConverterDataLoader
         {
         public:
@@ -67,6 +85,7 @@ namespace CalculatorApp
             std::vector<UCM::Unit> GetOrderedUnits(const UCM::Category& category) override;
             std::unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> LoadOrderedRatios(const UCM::Unit& unit) override;
             bool SupportsCategory(const UnitConversionManager::Category& target) override;
+            bool TryLoadUnitFactors(const std::vector<UCM::Unit>& units, UCM::UnitFactors& factors) override;
             // IConverterDataLoader
 
             // ICurrencyConverterDataLoader
@@ -118,7 +137,7 @@ namespace CalculatorApp
 
             std::mutex m_currencyUnitsMutex;
             std::vector<UCM::Unit> m_currencyUnits;
-            UCM::UnitToUnitToConversionDataMap m_currencyRatioMap;
+            CurrencyRates m_currencyRates;
             std::unordered_map<UCM::Unit, CurrencyUnitMetadata, UCM::UnitHash> m_currencyMetadata;
 
             std::shared_ptr<UCM::IViewModelCurrencyCallback> m_vmCallback;
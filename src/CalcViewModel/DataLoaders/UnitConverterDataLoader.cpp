@@ -18,6 +18,70 @@ using namespace Windows::Globalization;
 
 static constexpr bool CONVERT_WITH_OFFSET_FIRST = true;
 
+namespace
+{
+    // The numerator and denominator of a factor from the tables, the denominator is empty when the factor is a decimal.
+    pair<wstring_view, wstring_view> SplitFraction(wstring_view factor)
+    {
+        size_t slash = factor.find(L'/');
+        if (slash == wstring_view::npos)
+        {
+            return { factor, {} };
+        }
+        return { factor.substr(0, slash), factor.substr(slash + 1) };
+    }
+
+    double FactorToDouble(wstring_view factor)
+    {
+        auto [numerator, denominator] = SplitFraction(factor);
+        double value = stod(wstring{ numerator });
+        return denominator.empty() ? value : value / stod(wstring{ denominator });
+    }
+
+    // The quotient of two factors, written out exactly as UCM::ExactConversion reads it.
+    wstring ExactQuotient(wstring_view dividend, wstring_view divisor)
+    {
+        auto [dividendNumerator, dividendDenominator] = SplitFraction(dividend);
+        auto [divisorNumerator, divisorDenominator] = SplitFraction(divisor);
+
+        wstring quotient{ dividendNumerator };
+        if (!divisorDenominator.empty())
+        {
+            quotient.append(L"*").append(divisorDenominator);
+        }
+        quotient.append(L"/").append(divisorNumerator);
+        if (!dividendDenominator.empty())
+        {
+            quotient.append(L"*").append(dividendDenominator);
+        }
+        return quotient;
+    }
+}
+
+UnitData::UnitData(ViewMode categoryId, int unitId, wstring_view factor)
+    : categoryId(categoryId)
+    , unitId(unitId)
+    , factor(FactorToDouble(factor))
+    , exactFactor(factor)
+{
+}
+
+ExplicitUnitConversionData::ExplicitUnitConversionData(
+    ViewMode categoryId,
+    int parentUnitId,
+    int unitId,
+    wstring_view ratio,
+    wstring_view offset,
+    bool offsetFirst)
+    : UCM::ConversionData(FactorToDouble(ratio), FactorToDouble(offset), offsetFirst)
+    , categoryId(categoryId)
+    , parentUnitId(parentUnitId)
+    , unitId(unitId)
+{
+    exactRatio = ratio;
+    exactOffset = offset;
+}
+
 UnitConverterDataLoader::UnitConverterDataLoader(GeographicRegion ^ region)
     : m_currentRegionCode(region->CodeTwoLetter)
 {
@@ -41,6 +105,28 @@ unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> UnitConverterDataLo
     return m_ratioMap->at(unit);
 }
 
+// The factors of the units from the tables, unless one of them converts with an offset, as temperatures do.
+bool UnitConverterDataLoader::TryLoadUnitFactors(const vector<UCM::Unit>& units, UCM::UnitFactors& factors)
+{
+    factors.factors.resize(units.size());
+    factors.exactFactors.resize(units.size());
+    factors.factorsAreRates = false;
+    for (size_t i = 0; i < units.size(); i++)
+    {
+        auto unitData = m_unitData.find(units[i].id);
+        if (unitData == m_unitData.end())
+        {
+            return false;
+        }
+
+        assert(unitData->second.factor > 0); // divide by zero assert
+        factors.factors[i] = unitData->second.factor;
+        factors.exactFactors[i] = unitData->second.exactFactor;
+    }
+
+    return true;
+}
+
 bool UnitConverterDataLoader::SupportsCategory(const UCM::Category& target)
 {
     shared_ptr<vector<UCM::Category>> supportedCategories = nullptr;
@@ -66,7 +152,7 @@ void UnitConverterDataLoader::LoadData()
     unordered_map<int, OrderedUnit> idToUnit;
 
     unordered_map<ViewMode, vector<OrderedUnit>> orderedUnitMap{};
-    unordered_map<ViewMode, unordered_map<int, double>> categoryToUnitConversionDataMap{};
+    unordered_map<ViewMode, unordered_map<int, UnitData>> categoryToUnitConversionDataMap{};
     unordered_map<int, unordered_map<int, UCM::ConversionData>> explicitConversionData{};
 
     // Load categories, units and conversion data into data structures. This will be then used to populate hashmaps used by CalcEngine and UI layer
@@ -77,6 +163,7 @@ void UnitConverterDataLoader::LoadData()
 
     this->m_categoryIDToUnitsMap->clear();
     this->m_ratioMap->clear();
+    m_unitData.clear();
     for (UCM::Category objectCategory : *m_categoryList)
     {
         ViewMode categoryViewMode = NavCategoryStates::Deserialize(objectCategory.id);
@@ -113,10 +200,11 @@ void UnitConverterDataLoader::LoadData()
             if (explicitConversionData.find(unit.id) == explicitConversionData.end())
             {
                 // Get the associated units for a category id
-                unordered_map<int, double> unitConversions = categoryToUnitConversionDataMap.at(categoryViewMode);
-                double unitFactor = unitConversions[unit.id];
+                unordered_map<int, UnitData> unitConversions = categoryToUnitConversionDataMap.at(categoryViewMode);
+                const UnitData& unitData = unitConversions[unit.id];
+                m_unitData[unit.id] = unitData;
 
-                for (const auto& [id, conversionFactor] : unitConversions)
+                for (const auto& [id, conversionData] : unitConversions)
                 {
                     if (idToUnit.find(id) == idToUnit.end())
                     {
@@ -126,8 +214,9 @@ void UnitConverterDataLoader::LoadData()
                     }
 
                     UCM::ConversionData parsedData = { 1.0, 0.0, false };
-                    assert(conversionFactor > 0); // divide by zero assert
-                    parsedData.ratio = unitFactor / conversionFactor;
+                    assert(conversionData.factor > 0); // divide by zero assert
+                    parsedData.ratio = unitData.factor / conversionData.factor;
+                    parsedData.exactRatio = ExactQuotient(unitData.exactFactor, conversionData.exactFactor);
                     conversions.insert(pair<UCM::Unit, UCM::ConversionData>(idToUnit.at(id), parsedData));
                 }
             }
@@ -780,187 +869,188 @@ void UnitConverterDataLoader::GetUnits(_In_ unordered_map<ViewMode, vector<Order
     unitMap.emplace(ViewMode::Angle, angleUnits);
 }
 
-void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, unordered_map<int, double>>& categoryToUnitConversionMap)
+void UnitConverterDataLoader::GetConversionData(_In_ unordered_map<ViewMode, unordered_map<int, UnitData>>& categoryToUnitConversionMap)
 {
+    // Each factor is written out exactly, so the converter can work in rationals as well as in doubles
     /*categoryId, UnitId, factor*/
-    static const vector<UnitData> unitDataList = { { ViewMode::Area, UnitConverterUnits::Area_Acre, 4046.8564224 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMeter, 1 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareFoot, 0.09290304 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareYard, 0.83612736 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMillimeter, 0.000001 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareCentimeter, 0.0001 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareInch, 0.00064516 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMile, 2589988.110336 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareKilometer, 1000000 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Hectare, 10000 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Hand, 0.012516104 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Paper, 0.06032246 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_SoccerField, 10869.66 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Castle, 100000 },
-                                                   { ViewMode::Area, UnitConverterUnits::Area_Pyeong, 400.0 / 121.0 },
-
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Bit, 0.000000125 },
-												   { ViewMode::Data, UnitConverterUnits::Data_Nibble, 0.0000005 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Byte, 0.000001 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Kilobyte, 0.001 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Megabyte, 1 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Gigabyte, 1000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Terabyte, 1000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Petabyte, 1000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Exabytes, 1000000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Zetabytes, 1000000000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Yottabyte, 1000000000000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Kilobit, 0.000125 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Megabit, 0.125 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Gigabit, 125 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Terabit, 125000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Petabit, 125000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Exabits, 125000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Zetabits, 125000000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Yottabit, 125000000000000000 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Gibibits, 134.217728 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Gibibytes, 1073.741824 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Kibibits, 0.000128 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Kibibytes, 0.001024 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Mebibits, 0.131072 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Mebibytes, 1.048576 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Pebibits, 140737488.355328 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Pebibytes, 1125899906.842624 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Tebibits, 137438.953472 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Tebibytes, 1099511.627776 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Exbibits, 144115188075.855872 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Exbibytes, 1152921504606.846976 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Zebibits, 147573952589676.412928 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Zebibytes, 1180591620717411.303424 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Yobibits, 151115727451828646.838272 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_Yobibytes, 1208925819614629174.706176 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_FloppyDisk, 1.474560 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_CD, 700 },
-                                                   { ViewMode::Data, UnitConverterUnits::Data_DVD, 4700 },
-
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Calorie, 4.184 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilocalorie, 4184 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_BritishThermalUnit, 1055.056 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilojoule, 1000 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilowatthour, 3600000 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_ElectronVolt, 0.0000000000000000001602176565 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Joule, 1 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_FootPound, 1.3558179483314 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Battery, 9000 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Banana, 439614 },
-                                                   { ViewMode::Energy, UnitConverterUnits::Energy_SliceOfCake, 1046700 },
-
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Inch, 0.0254 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Foot, 0.3048 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Yard, 0.9144 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Mile, 1609.344 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Micron, 0.000001 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Millimeter, 0.001 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Nanometer, 0.000000001 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Angstrom, 0.0000000001 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Centimeter, 0.01 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Meter, 1 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Kilometer, 1000 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_NauticalMile, 1852 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Paperclip, 0.035052 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_Hand, 0.18669 },
-                                                   { ViewMode::Length, UnitConverterUnits::Length_JumboJet, 76 },
-
-                                                   { ViewMode::Power, UnitConverterUnits::Power_BritishThermalUnitPerMinute, 17.58426666666667 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_FootPoundPerMinute, 0.0225969658055233 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_Watt, 1 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_Kilowatt, 1000 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_Horsepower, 745.69987158227022 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_LightBulb, 60 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_Horse, 745.7 },
-                                                   { ViewMode::Power, UnitConverterUnits::Power_TrainEngine, 2982799.486329081 },
-
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Day, 86400 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Second, 1 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Week, 604800 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Year, 31557600 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Millisecond, 0.001 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Microsecond, 0.000001 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Minute, 60 },
-                                                   { ViewMode::Time, UnitConverterUnits::Time_Hour, 3600 },
-
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CupUS, 236.588237 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_PintUS, 473.176473 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_PintUK, 568.26125 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_QuartUS, 946.352946 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_QuartUK, 1136.5225 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_GallonUS, 3785.411784 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_GallonUK, 4546.09 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Liter, 1000 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TeaspoonUS, 4.92892159375 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TablespoonUS, 14.78676478125 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicCentimeter, 1 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicYard, 764554.857984 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicMeter, 1000000 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Milliliter, 1 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicInch, 16.387064 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicFoot, 28316.846592 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_FluidOunceUS, 29.5735295625 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_FluidOunceUK, 28.4130625 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TeaspoonUK, 5.91938802083333333333 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TablespoonUK, 17.7581640625 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CoffeeCup, 236.5882 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Bathtub, 378541.2 },
-                                                   { ViewMode::Volume, UnitConverterUnits::Volume_SwimmingPool, 3750000000 },
-
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Kilogram, 1 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Hectogram, 0.1 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Decagram, 0.01 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Gram, 0.001 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Pound, 0.45359237 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Ounce, 0.028349523125 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Milligram, 0.000001 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Centigram, 0.00001 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Decigram, 0.0001 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_LongTon, 1016.0469088 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Tonne, 1000 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Stone, 6.35029318 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Carat, 0.0002 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_ShortTon, 907.18474 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Snowflake, 0.000002 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_SoccerBall, 0.4325 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Elephant, 4000 },
-                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Whale, 90000 },
-
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_CentimetersPerSecond, 1 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_FeetPerSecond, 30.48 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_KilometersPerHour, 27.777777777777777777778 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Knot, 51.44 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Mach, 34030 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_MetersPerSecond, 100 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_MilesPerHour, 44.7 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Turtle, 8.94 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Horse, 2011.5 },
-                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Jet, 24585 },
-
-                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Degree, 1 },
-                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Radian, 57.29577951308233 },
-                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Gradian, 0.9 },
-
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Atmosphere, 1 },
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Bar, 0.9869232667160128 },
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_KiloPascal, 0.0098692326671601 },
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_MillimeterOfMercury, 0.0013155687145324 },
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Pascal, 9.869232667160128e-6 },
-                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_PSI, 0.068045961016531 } };
+    static const vector<UnitData> unitDataList = { { ViewMode::Area, UnitConverterUnits::Area_Acre, L"4046.8564224" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMeter, L"1" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareFoot, L"0.09290304" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareYard, L"0.83612736" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMillimeter, L"0.000001" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareCentimeter, L"0.0001" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareInch, L"0.00064516" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareMile, L"2589988.110336" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SquareKilometer, L"1000000" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Hectare, L"10000" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Hand, L"0.012516104" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Paper, L"0.06032246" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_SoccerField, L"10869.66" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Castle, L"100000" },
+                                                   { ViewMode::Area, UnitConverterUnits::Area_Pyeong, L"400/121" },
+
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Bit, L"0.000000125" },
+												   { ViewMode::Data, UnitConverterUnits::Data_Nibble, L"0.0000005" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Byte, L"0.000001" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Kilobyte, L"0.001" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Megabyte, L"1" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Gigabyte, L"1000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Terabyte, L"1000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Petabyte, L"1000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Exabytes, L"1000000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Zetabytes, L"1000000000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Yottabyte, L"1000000000000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Kilobit, L"0.000125" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Megabit, L"0.125" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Gigabit, L"125" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Terabit, L"125000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Petabit, L"125000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Exabits, L"125000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Zetabits, L"125000000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Yottabit, L"125000000000000000" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Gibibits, L"134.217728" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Gibibytes, L"1073.741824" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Kibibits, L"0.000128" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Kibibytes, L"0.001024" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Mebibits, L"0.131072" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Mebibytes, L"1.048576" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Pebibits, L"140737488.355328" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Pebibytes, L"1125899906.842624" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Tebibits, L"137438.953472" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Tebibytes, L"1099511.627776" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Exbibits, L"144115188075.855872" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Exbibytes, L"1152921504606.846976" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Zebibits, L"147573952589676.412928" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Zebibytes, L"1180591620717411.303424" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Yobibits, L"151115727451828646.838272" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_Yobibytes, L"1208925819614629174.706176" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_FloppyDisk, L"1.474560" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_CD, L"700" },
+                                                   { ViewMode::Data, UnitConverterUnits::Data_DVD, L"4700" },
+
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Calorie, L"4.184" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilocalorie, L"4184" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_BritishThermalUnit, L"1055.056" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilojoule, L"1000" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Kilowatthour, L"3600000" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_ElectronVolt, L"0.0000000000000000001602176565" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Joule, L"1" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_FootPound, L"1.3558179483314" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Battery, L"9000" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_Banana, L"439614" },
+                                                   { ViewMode::Energy, UnitConverterUnits::Energy_SliceOfCake, L"1046700" },
+
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Inch, L"0.0254" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Foot, L"0.3048" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Yard, L"0.9144" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Mile, L"1609.344" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Micron, L"0.000001" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Millimeter, L"0.001" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Nanometer, L"0.000000001" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Angstrom, L"0.0000000001" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Centimeter, L"0.01" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Meter, L"1" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Kilometer, L"1000" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_NauticalMile, L"1852" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Paperclip, L"0.035052" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_Hand, L"0.18669" },
+                                                   { ViewMode::Length, UnitConverterUnits::Length_JumboJet, L"76" },
+
+                                                   { ViewMode::Power, UnitConverterUnits::Power_BritishThermalUnitPerMinute, L"17.58426666666667" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_FootPoundPerMinute, L"0.0225969658055233" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_Watt, L"1" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_Kilowatt, L"1000" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_Horsepower, L"745.69987158227022" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_LightBulb, L"60" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_Horse, L"745.7" },
+                                                   { ViewMode::Power, UnitConverterUnits::Power_TrainEngine, L"2982799.486329081" },
+
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Day, L"86400" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Second, L"1" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Week, L"604800" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Year, L"31557600" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Millisecond, L"0.001" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Microsecond, L"0.000001" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Minute, L"60" },
+                                                   { ViewMode::Time, UnitConverterUnits::Time_Hour, L"3600" },
+
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CupUS, L"236.588237" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_PintUS, L"473.176473" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_PintUK, L"568.26125" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_QuartUS, L"946.352946" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_QuartUK, L"1136.5225" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_GallonUS, L"3785.411784" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_GallonUK, L"4546.09" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Liter, L"1000" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TeaspoonUS, L"4.92892159375" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TablespoonUS, L"14.78676478125" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicCentimeter, L"1" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicYard, L"764554.857984" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicMeter, L"1000000" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Milliliter, L"1" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicInch, L"16.387064" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CubicFoot, L"28316.846592" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_FluidOunceUS, L"29.5735295625" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_FluidOunceUK, L"28.4130625" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TeaspoonUK, L"5.91938802083333333333" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_TablespoonUK, L"17.7581640625" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_CoffeeCup, L"236.5882" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_Bathtub, L"378541.2" },
+                                                   { ViewMode::Volume, UnitConverterUnits::Volume_SwimmingPool, L"3750000000" },
+
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Kilogram, L"1" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Hectogram, L"0.1" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Decagram, L"0.01" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Gram, L"0.001" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Pound, L"0.45359237" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Ounce, L"0.028349523125" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Milligram, L"0.000001" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Centigram, L"0.00001" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Decigram, L"0.0001" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_LongTon, L"1016.0469088" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Tonne, L"1000" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Stone, L"6.35029318" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Carat, L"0.0002" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_ShortTon, L"907.18474" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Snowflake, L"0.000002" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_SoccerBall, L"0.4325" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Elephant, L"4000" },
+                                                   { ViewMode::Weight, UnitConverterUnits::Weight_Whale, L"90000" },
+
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_CentimetersPerSecond, L"1" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_FeetPerSecond, L"30.48" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_KilometersPerHour, L"27.777777777777777777778" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Knot, L"51.44" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Mach, L"34030" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_MetersPerSecond, L"100" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_MilesPerHour, L"44.7" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Turtle, L"8.94" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Horse, L"2011.5" },
+                                                   { ViewMode::Speed, UnitConverterUnits::Speed_Jet, L"24585" },
+
+                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Degree, L"1" },
+                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Radian, L"57.29577951308233" },
+                                                   { ViewMode::Angle, UnitConverterUnits::Angle_Gradian, L"0.9" },
+
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Atmosphere, L"1" },
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Bar, L"0.9869232667160128" },
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_KiloPascal, L"0.0098692326671601" },
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_MillimeterOfMercury, L"0.0013155687145324" },
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_Pascal, L"9.869232667160128e-6" },
+                                                   { ViewMode::Pressure, UnitConverterUnits::Pressure_PSI, L"0.068045961016531" } };
 
     // Populate the hash map and return;
     for (UnitData unitdata : unitDataList)
     {
         if (categoryToUnitConversionMap.find(unitdata.categoryId) == categoryToUnitConversionMap.end())
         {
-            unordered_map<int, double> conversionData;
-            conversionData.insert(pair<int, double>(unitdata.unitId, unitdata.factor));
-            categoryToUnitConversionMap.insert(pair<ViewMode, unordered_map<int, double>>(unitdata.categoryId, conversionData));
+            unordered_map<int, UnitData> conversionData;
+            conversionData.insert(pair<int, UnitData>(unitdata.unitId, unitdata));
+            categoryToUnitConversionMap.insert(pair<ViewMode, unordered_map<int, UnitData>>(unitdata.categoryId, conversionData));
         }
         else
         {
-            categoryToUnitConversionMap.at(unitdata.categoryId).insert(pair<int, double>(unitdata.unitId, unitdata.factor));
+            categoryToUnitConversionMap.at(unitdata.categoryId).insert(pair<int, UnitData>(unitdata.unitId, unitdata));
         }
     }
 }
@@ -974,30 +1064,30 @@ void UnitConverterDataLoader::GetExplicitConversionData(_In_ unordered_map<int,
 {
     /* categoryId, ParentUnitId, UnitId, ratio, offset, offsetfirst*/
     ExplicitUnitConversionData conversionDataList[] = {
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesCelsius, 1, 0 },
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesFahrenheit, 1.8, 32 },
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_Kelvin, 1, 273.15 },
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesCelsius, L"1", L"0" },
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_DegreesFahrenheit, L"1.8", L"32" },
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesCelsius, UnitConverterUnits::Temperature_Kelvin, L"1", L"273.15" },
         { ViewMode::Temperature,
           UnitConverterUnits::Temperature_DegreesFahrenheit,
           UnitConverterUnits::Temperature_DegreesCelsius,
-          0.55555555555555555555555555555556,
-          -32,
+          L"5/9",
+          L"-32",
           CONVERT_WITH_OFFSET_FIRST },
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesFahrenheit, UnitConverterUnits::Temperature_DegreesFahrenheit, 1, 0 },
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_DegreesFahrenheit, UnitConverterUnits::Temperature_DegreesFahrenheit, L"1", L"0" },
         { ViewMode::Temperature,
           UnitConverterUnits::Temperature_DegreesFahrenheit,
           UnitConverterUnits::Temperature_Kelvin,
-          0.55555555555555555555555555555556,
-          459.67,
+          L"5/9",
+          L"459.67",
           CONVERT_WITH_OFFSET_FIRST },
         { ViewMode::Temperature,
           UnitConverterUnits::Temperature_Kelvin,
           UnitConverterUnits::Temperature_DegreesCelsius,
-          1,
-          -273.15,
+          L"1",
+          L"-273.15",
           CONVERT_WITH_OFFSET_FIRST },
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_Kelvin, UnitConverterUnits::Temperature_DegreesFahrenheit, 1.8, -459.67 },
-        { ViewMode::Temperature, UnitConverterUnits::Temperature_Kelvin, UnitConverterUnits::Temperature_Kelvin, 1, 0 }
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_Kelvin, UnitConverterUnits::Temperature_DegreesFahrenheit, L"1.8", L"-459.67" },
+        { ViewMode::Temperature, UnitConverterUnits::Temperature_Kelvin, UnitConverterUnits::Temperature_Kelvin, L"1", L"0" }
     };
 
     // Populate the hash map and return;
@@ -34,9 +34,13 @@ namespace CalculatorApp
 
         struct UnitData
         {
-            CalculatorApp::ViewModel::Common::ViewMode categoryId;
-            int unitId;
-            double factor;
+            UnitData() = default;
+            UnitData(CalculatorApp::ViewModel::Common::ViewMode categoryId, int unitId, std::wstring_view factor);
+
+            CalculatorApp::ViewModel::Common::ViewMode categoryId{};
+            int unitId = 0;
+            double factor = 0;
+            std::wstring_view exactFactor{}; // as the table has it, a decimal or a fraction of two
         };
 
         struct ExplicitUnitConversionData : UnitConversionManager::ConversionData
@@ -48,15 +52,9 @@ namespace CalculatorApp
                 CalculatorApp::ViewModel::Common::ViewMode categoryId,
                 int parentUnitId,
                 int unitId,
-                double ratio,
-                double offset,
-                bool offsetFirst = false)
-                : categoryId(categoryId)
-                , parentUnitId(parentUnitId)
-                , unitId(unitId)
-                , UnitConversionManager::ConversionData(ratio, offset, offsetFirst)
-            {
-            }
+                std::wstring_view ratio,
+                std::wstring_view offset,
+                bool offsetFirst = false);
 
             CalculatorApp::ViewModel::Common::ViewMode categoryId;
             int parentUnitId;
@@ -76,11 +74,14 @@ namespace CalculatorApp
             std::unordered_map<UnitConversionManager::Unit, UnitConversionManager::ConversionData, UnitConversionManager::UnitHash>
             LoadOrderedRatios(const UnitConversionManager::Unit& unit) override;
             bool SupportsCategory(const UnitConversionManager::Category& target) override;
+            bool TryLoadUnitFactors(const std::vector<UnitConversionManager::Unit>& units, UnitConversionManager::UnitFactors& factors) override;
             // IConverterDataLoader
 
             void GetCategories(_In_ std::shared_ptr<std::vector<UnitConversionManager::Category>> categoriesList);
             void GetUnits(_In_ std::unordered_map<CalculatorApp::ViewModel::Common::ViewMode, std::vector<CalculatorApp::ViewModel::Common::OrderedUnit>>& unitMap);
-            void GetConversionData(_In_ std::unordered_map<CalculatorApp::ViewModel::Common::ViewMode, std::unordered_map<int, double>>& categoryToUnitConversionMap);
+            void GetConversionData(
+                _In_ std::unordered_map<CalculatorApp::ViewModel::Common::ViewMode, std::unordered_map<int, CalculatorApp::ViewModel::Common::UnitData>>&
+                    categoryToUnitConversionMap);
             void GetExplicitConversionData(_In_ std::unordered_map<int, std::unordered_map<int, UnitConversionManager::ConversionData>>& unitToUnitConversionList);
 
             std::wstring GetLocalizedStringName(_In_ Platform::String ^ stringId);
@@ -88,6 +89,7 @@ namespace CalculatorApp
             std::shared_ptr<std::vector<UnitConversionManager::Category>> m_categoryList;
             std::shared_ptr<UnitConversionManager::CategoryToUnitVectorMap> m_categoryIDToUnitsMap;
             std::shared_ptr<UnitConversionManager::UnitToUnitToConversionDataMap> m_ratioMap;
+            std::unordered_map<int, CalculatorApp::ViewModel::Common::UnitData> m_unitData; // by unit id, for the units converted without an offset
             Platform::String ^ m_currentRegionCode;
         };
     }
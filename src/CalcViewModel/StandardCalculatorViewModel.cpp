@@ -147,6 +147,7 @@ StandardCalculatorViewModel::StandardCalculatorViewModel()
     , m_localizedNoRightParenthesisAddedFormat(nullptr)
     , m_TokenPosition(-1)
     , m_isLastOperationHistoryLoad(false)
+    , m_areExpressionTokensShown(false)
 {
     WeakReference calculatorViewModel(this);
     auto appResourceProvider = AppResourceProvider::GetInstance();
@@ -347,11 +348,30 @@ void StandardCalculatorViewModel::SetExpressionDisplay(
     _Inout_ shared_ptr<std::vector<pair<wstring, int>>> const& tokens,
     _Inout_ shared_ptr<std::vector<shared_ptr<IExpressionCommand>>> const& commands)
 {
+    UpdateExpressionDisplay(tokens, commands, 0);
+}
+
+void StandardCalculatorViewModel::UpdateExpressionDisplay(
+    _Inout_ shared_ptr<std::vector<pair<wstring, int>>> const& tokens,
+    _Inout_ shared_ptr<std::vector<shared_ptr<IExpressionCommand>>> const& commands,
+    size_t firstChangedToken)
+{
+    // Only the tokens that are shown can be updated from where they changed
+    if (tokens != m_tokens || !m_areExpressionTokensShown)
+    {
+        firstChangedToken = 0;
+    }
+
     m_tokens = tokens;
     m_commands = commands;
     if (!IsEditingEnabled)
     {
-        SetTokens(tokens);
+        SetTokens(tokens, firstChangedToken);
+        m_areExpressionTokensShown = true;
+    }
+    else
+    {
+        m_areExpressionTokensShown = false;
     }
 
     CalculationExpressionAutomationName = GetCalculatorExpressionAutomationName();
@@ -365,6 +385,7 @@ void StandardCalculatorViewModel::SetHistoryExpressionDisplay(
 {
     m_tokens = make_shared<vector<pair<wstring, int>>>(*tokens);
     m_commands = make_shared<vector<shared_ptr<IExpressionCommand>>>(*commands);
+    m_areExpressionTokensShown = false;
     IsEditingEnabled = false;
 
     // Setting the History Item Load Mode so that UI does not get updated with recalculation of every token
@@ -374,7 +395,7 @@ void StandardCalculatorViewModel::SetHistoryExpressionDisplay(
     m_isLastOperationHistoryLoad = true;
 }
 
-void StandardCalculatorViewModel::SetTokens(_Inout_ shared_ptr<vector<pair<wstring, int>>> const& tokens)
+void StandardCalculatorViewModel::SetTokens(_Inout_ shared_ptr<vector<pair<wstring, int>>> const& tokens, size_t firstChangedToken)
 {
     AreTokensUpdated = false;
 
@@ -389,7 +410,7 @@ void StandardCalculatorViewModel::SetTokens(_Inout_ shared_ptr<vector<pair<wstri
     LocalizationSettings ^ localizer = LocalizationSettings::GetInstance();
 
     const wstring separator = L" ";
-    for (unsigned int i = 0; i < nTokens; ++i)
+    for (unsigned int i = static_cast<unsigned int>(min<size_t>(firstChangedToken, m_ExpressionTokens->Size)); i < nTokens; ++i)
     {
         auto currentToken = (*tokens)[i];
 
@@ -633,6 +654,7 @@ void StandardCalculatorViewModel::HandleUpdatedOperandData(Command cmdenum)
     displayExpressionToken->Token = updatedData;
     IsOperandUpdatedUsingViewModel = true;
     displayExpressionToken->CommandIndex = commandIndex;
+    m_areExpressionTokensShown = false;
 }
 
 bool StandardCalculatorViewModel::IsOperator(Command cmdenum)
@@ -1425,6 +1447,7 @@ void StandardCalculatorViewModel::SaveEditedCommand(_In_ unsigned int tokenPosit
 
         DisplayExpressionToken ^ displayExpressionToken = ExpressionTokens->GetAt(tokenPosition);
         displayExpressionToken->Token = ref new Platform::String(updatedToken.c_str());
+        m_areExpressionTokensShown = false;
 
         // Special casing
         if (command == Command::CommandSIGN && tokenCommand->GetCommandType() == CommandType::UnaryCommand)
@@ -1571,10 +1594,18 @@ void StandardCalculatorViewModel::UpdateProgrammerPanelDisplay()
     wstring decimalDisplayString;
     wstring octalDisplayString;
     wstring binaryDisplayString;
+    wstring binaryValue;
+
+    // we want the precision to be set to maximum value so that the autoconversions result as desired
+    auto results = m_standardCalculatorManager.GetResultsForRadixes({ 16, 10, 8, 2 }, precision);
+    if (results.size() == 4)
+    {
+        binaryValue = results[3].ungroupedString;
+    }
+
     if (!IsInError)
     {
-        // we want the precision to be set to maximum value so that the autoconversions result as desired
-        if ((hexDisplayString = m_standardCalculatorManager.GetResultForRadix(16, precision, true)) == L"")
+        if (results.size() != 4 || results[0].groupedString == L"")
         {
             hexDisplayString = DisplayValue->Data();
             decimalDisplayString = DisplayValue->Data();
@@ -1583,9 +1614,10 @@ void StandardCalculatorViewModel::UpdateProgrammerPanelDisplay()
         }
         else
         {
-            decimalDisplayString = m_standardCalculatorManager.GetResultForRadix(10, precision, true);
-            octalDisplayString = m_standardCalculatorManager.GetResultForRadix(8, precision, true);
-            binaryDisplayString = m_standardCalculatorManager.GetResultForRadix(2, precision, true);
+            hexDisplayString = results[0].groupedString;
+            decimalDisplayString = results[1].groupedString;
+            octalDisplayString = results[2].groupedString;
+            binaryDisplayString = results[3].groupedString;
         }
     }
     LocalizationSettings ^ localizer = LocalizationSettings::GetInstance();
@@ -1606,7 +1638,6 @@ void StandardCalculatorViewModel::UpdateProgrammerPanelDisplay()
     BinDisplayValue_AutomationName = GetLocalizedStringFormat(m_localizedBinaryAutomationFormat, GetNarratorStringReadRawNumbers(BinaryDisplayValue));
 
     auto binaryValueArray = ref new Vector<bool>(64, false);
-    auto binaryValue = m_standardCalculatorManager.GetResultForRadix(2, precision, false);
     int i = 0;
 
     // To get bit 0, grab from opposite end of string.
@@ -315,7 +315,11 @@ namespace CalculatorApp
             void SetHistoryExpressionDisplay(
                 _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
                 _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands);
-            void SetTokens(_Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens);
+            void UpdateExpressionDisplay(
+                _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
+                _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands,
+                size_t firstChangedToken);
+            void SetTokens(_Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens, size_t firstChangedToken = 0);
             CalculatorApp::ViewModel::Common::NumbersAndOperatorsEnum ConvertIntegerToNumbersAndOperatorsEnum(unsigned int parameter);
             static RadixType GetRadixTypeFromNumberBase(CalculatorApp::ViewModel::Common::NumberBase base);
             CalculatorApp::ViewModel::Common::NumbersAndOperatorsEnum m_CurrentAngleType;
@@ -369,6 +373,7 @@ namespace CalculatorApp
 
             std::shared_ptr<std::vector<std::pair<std::wstring, int>>> m_tokens;
             std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> m_commands;
+            bool m_areExpressionTokensShown; // whether ExpressionTokens shows m_tokens as the engine last sent them, unedited
 
             // Token types
             bool IsUnaryOp(CalculationManager::Command command);
@@ -10,6 +10,7 @@ using namespace std;
 using namespace CalculatorApp;
 using namespace CalculatorApp::ViewModel::Common;
 using namespace CalculationManager;
+using namespace CalcEngine;
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 static constexpr size_t MAX_HISTORY_SIZE = 20;
@@ -235,6 +236,116 @@ namespace CalculatorEngineTests
                 L"Verify expanded form multigroup non-repeating grouping.");
         }
 
+        TEST_METHOD(TestWordOperationsMatchRationalPath)
+        {
+            auto engine = make_unique<CCalcEngine>(
+                true /* Respect Order of Operations */, true /* Set to Integer Mode */, m_resourceProvider.get(), nullptr, nullptr);
+
+            // The same value as p * 2 / 2, which is not a word, so it goes through ratpak.
+            auto unreduced = [](uint64_t value) {
+                vector<uint32_t> mantissa{ static_cast<uint32_t>(value << 1), static_cast<uint32_t>(value >> 31), static_cast<uint32_t>(value >> 63) };
+                while (mantissa.size() > 1 && mantissa.back() == 0)
+                {
+                    mantissa.pop_back();
+                }
+                return Rational{ Number{ 1, 0, mantissa }, Number{ 1, 0, { 2 } } };
+            };
+
+            vector<uint64_t> values{ 0, 1, 2, 3, 7, 8, 31, 63, 64, 0x7F, 0x80, 0xFF, 0x8000, 0xFFFF, 0x80000000, 0xFFFFFFFF, 0x8000000000000000, 0xFFFFFFFFFFFFFFFF };
+            vector<int> operations{ IDC_AND, IDC_OR, IDC_XOR, IDC_NAND, IDC_NOR, IDC_LSHF, IDC_RSHF, IDC_RSHFL, IDC_ADD, IDC_SUB, IDC_MUL, IDC_DIV, IDC_MOD };
+            for (OpCode width : { IDC_QWORD, IDC_DWORD, IDC_WORD, IDC_BYTE })
+            {
+                engine->ProcessCommand(width);
+                Rational chop = engine->GetChopNumber();
+                for (uint64_t a : values)
+                {
+                    for (uint64_t b : values)
+                    {
+                        if (Rational{ a } > chop || Rational{ b } > chop)
+                        {
+                            continue;
+                        }
+
+                        for (int operation : operations)
+                        {
+                            engine->m_bError = false;
+                            Rational word = engine->DoOperation(operation, Rational{ a }, Rational{ b });
+                            bool wordError = engine->m_bError;
+
+                            engine->m_bError = false;
+                            Rational rational = engine->DoOperation(operation, unreduced(a), unreduced(b));
+
+                            VERIFY_ARE_EQUAL(engine->m_bError, wordError);
+                            VERIFY_IS_TRUE(word == rational);
+                        }
+                    }
+
+                    // ratpak keeps the 2 of 0 / 2 through ^, so zero has nothing to compare with here.
+                    if (a == 0 || Rational{ a } > chop)
+                    {
+                        continue;
+                    }
+
+                    for (uint32_t function : { IDC_COM, IDC_ROL, IDC_ROR, IDC_ROLC, IDC_RORC })
+                    {
+                        uint64_t carry = engine->m_carryBit;
+                        Rational word = engine->SciCalcFunctions(Rational{ a }, function);
+                        uint64_t wordCarry = engine->m_carryBit;
+
+                        engine->m_carryBit = carry;
+                        Rational rational = engine->SciCalcFunctions(unreduced(a), function);
+
+                        VERIFY_ARE_EQUAL(engine->m_carryBit, wordCarry);
+                        VERIFY_IS_TRUE(word == rational);
+                    }
+
+                    // Negative values wrap into the word as two's complement.
+                    VERIFY_IS_TRUE(engine->TruncateNumForIntMath(-Rational{ a }) == engine->TruncateNumForIntMath(-unreduced(a)));
+                }
+            }
+        }
+
+        TEST_METHOD(TestResultsForRadixesMatchResultForRadix)
+        {
+            auto engine = make_unique<CCalcEngine>(
+                true /* Respect Order of Operations */, true /* Set to Integer Mode */, m_resourceProvider.get(), nullptr, nullptr);
+            engine->m_bRecord = false;
+
+            vector<Rational> values{ Rational{ 0 },
+                                     Rational{ 1 },
+                                     Rational{ -1 },
+                                     Rational{ 0x7F },
+                                     Rational{ -0x80 },
+                                     Rational{ 0xFFFF },
+                                     Rational{ uint64_t{ 0x8000000000000000 } },
+                                     Rational{ uint64_t{ 0xFFFFFFFFFFFFFFFF } },
+                                     Rational{ Number{ 1, 0, { 5 } }, Number{ 1, 0, { 2 } } },
+                                     Rational{ Number{ -1, 2, { 1 } }, Number{ 1, 0, { 1 } } } };
+            vector<uint32_t> radixes{ 16, 10, 8, 2 };
+
+            // At a precision of 8 most words are too long to write out directly.
+            for (int32_t precision : { 64, 8 })
+            {
+                engine->ChangePrecision(precision);
+                for (OpCode width : { IDC_QWORD, IDC_DWORD, IDC_WORD, IDC_BYTE })
+                {
+                    engine->ProcessCommand(width);
+                    for (Rational const& value : values)
+                    {
+                        engine->m_currentVal = value;
+                        auto results = engine->GetCurrentResultsForRadixes(radixes, 64);
+                        VERIFY_ARE_EQUAL(radixes.size(), results.size());
+                        for (size_t i = 0; i < radixes.size(); i++)
+                        {
+                            VERIFY_ARE_EQUAL(radixes[i], results[i].radix);
+                            VERIFY_ARE_EQUAL(engine->GetCurrentResultForRadix(radixes[i], 64, false), results[i].ungroupedString);
+                            VERIFY_ARE_EQUAL(engine->GetCurrentResultForRadix(radixes[i], 64, true), results[i].groupedString);
+                        }
+                    }
+                }
+            }
+        }
+
     private:
         unique_ptr<CCalcEngine> m_calcEngine;
         shared_ptr<IResourceProvider> m_resourceProvider;
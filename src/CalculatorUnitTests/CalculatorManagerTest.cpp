@@ -5,7 +5,10 @@
 
 #include <CppUnitTest.h>
 
+#include "CalcManager/BatchEvaluator.h"
+#include "CalcManager/ParallelBatchEvaluator.h"
 #include "CalcManager/CalculatorHistory.h"
+#include "CalcManager/HistorySerializer.h"
 #include "CalcViewModel/Common/EngineResourceProvider.h"
 #include "CalcManager/NumberFormattingUtils.h"
 
@@ -32,6 +35,7 @@ namespace CalculatorManagerTest
             m_isError = false;
             m_maxDigitsCalledCount = 0;
             m_binaryOperatorReceivedCallCount = 0;
+            m_redrawnTokenCount = 0;
         }
 
         void SetPrimaryDisplay(const wstring& text, bool isError) override
@@ -45,13 +49,34 @@ namespace CalculatorManagerTest
         }
         void SetExpressionDisplay(
             _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
-            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& /*commands*/) override
+            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& commands) override
         {
-            m_expression.clear();
+            UpdateExpressionDisplay(tokens, commands, 0);
+        }
+        // Keeps the tokens the way a display that only redraws what changed would, so every test that checks the
+        // expression also checks the changes it was told about.
+        void UpdateExpressionDisplay(
+            _Inout_ std::shared_ptr<std::vector<std::pair<std::wstring, int>>> const& tokens,
+            _Inout_ std::shared_ptr<std::vector<std::shared_ptr<IExpressionCommand>>> const& /*commands*/,
+            size_t firstChangedToken) override
+        {
+            if (tokens != m_shownTokens)
+            {
+                firstChangedToken = 0;
+            }
+            m_shownTokens = tokens;
+
+            m_tokens.resize(min(firstChangedToken, m_tokens.size()));
+            m_redrawnTokenCount = tokens->size() - m_tokens.size();
+            for (size_t i = m_tokens.size(); i < tokens->size(); i++)
+            {
+                m_tokens.push_back((*tokens)[i].first);
+            }
 
-            for (const auto& currentPair : *tokens)
+            m_expression.clear();
+            for (const auto& token : m_tokens)
             {
-                m_expression += currentPair.first;
+                m_expression += token;
             }
         }
         void SetMemorizedNumbers(const vector<wstring>& numbers) override
@@ -118,9 +143,17 @@ namespace CalculatorManagerTest
             return m_binaryOperatorReceivedCallCount;
         }
 
+        size_t GetRedrawnTokenCount() const
+        {
+            return m_redrawnTokenCount;
+        }
+
     private:
         wstring m_primaryDisplay;
         wstring m_expression;
+        shared_ptr<vector<pair<wstring, int>>> m_shownTokens;
+        vector<wstring> m_tokens;
+        size_t m_redrawnTokenCount;
         unsigned int m_parenDisplay;
         bool m_isError;
         vector<wstring> m_memorizedNumberStrings;
@@ -128,6 +161,28 @@ namespace CalculatorManagerTest
         int m_binaryOperatorReceivedCallCount;
     };
 
+    // Gives its own text for one engine string, and the wrapped provider's for the rest.
+    class OverridingResourceProvider final : public IResourceProvider
+    {
+    public:
+        OverridingResourceProvider(shared_ptr<IResourceProvider> resourceProvider, wstring_view id, wstring_view text)
+            : m_resourceProvider(move(resourceProvider))
+            , m_id(id)
+            , m_text(text)
+        {
+        }
+
+        wstring GetCEngineString(wstring_view id) override
+        {
+            return id == m_id ? m_text : m_resourceProvider->GetCEngineString(id);
+        }
+
+    private:
+        shared_ptr<IResourceProvider> m_resourceProvider;
+        wstring m_id;
+        wstring m_text;
+    };
+
     class TestDriver
     {
     private:
@@ -196,6 +251,7 @@ namespace CalculatorManagerTest
         TEST_METHOD(UnitConversionManagerNumberFormattingUtils_GetNumberDigitsWholeNumberPart);
         TEST_METHOD(UnitConversionManagerNumberFormattingUtils_RoundSignificantDigits);
         TEST_METHOD(UnitConversionManagerNumberFormattingUtils_ToScientificNumber);
+        TEST_METHOD(UnitConversionManagerNumberFormattingUtils_FormatIntoBuffer);
 
         TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived);
         TEST_METHOD(CalculatorManagerTestBinaryOperatorReceived_Multiple);
@@ -203,6 +259,16 @@ namespace CalculatorManagerTest
 
         TEST_METHOD(CalculatorManagerTestStandardOrderOfOperations);
 
+        TEST_METHOD(CalculatorManagerTestBatchEvaluator);
+        TEST_METHOD(CalculatorManagerTestParallelBatchEvaluator);
+        TEST_METHOD(CalculatorManagerTestParallelBatchEvaluatorStrings);
+        TEST_METHOD(CalculatorManagerTestParallelBatchEvaluatorException);
+
+        TEST_METHOD(CalculatorManagerTestHistorySerializer);
+        TEST_METHOD(CalculatorManagerTestHistoryRing);
+
+        TEST_METHOD(CalculatorManagerTestExpressionDisplayUpdates);
+
         TEST_METHOD_CLEANUP(Cleanup);
 
     private:
@@ -676,6 +742,11 @@ namespace CalculatorManagerTest
         Command commands10[] = { Command::CommandOPENP, Command::Command8, Command::CommandCLOSEP,
                                  Command::CommandPNT, Command::Command5, Command::CommandEQU, Command::CommandNULL };
         TestDriver::Test(L"4", L"(8) \x00D7 0.5=", commands10, true, true);
+
+        // The digit after the inner ) clears the precedence stack while the outer ( is still open
+        Command commands11[] = { Command::CommandOPENP, Command::CommandOPENP, Command::Command8, Command::CommandCLOSEP, Command::Command2,
+                                 Command::CommandCLOSEP, Command::CommandEQU,   Command::CommandNULL };
+        TestDriver::Test(L"16", L"((8) \x00D7 2)=", commands11, true, true);
     }
 
     void CalculatorManagerTest::CalculatorManagerTestScientificError()
@@ -1075,6 +1146,33 @@ namespace CalculatorManagerTest
         VERIFY_ARE_EQUAL(result, L"-3.432432e-09");
     }
 
+    void CalculatorManagerTest::UnitConversionManagerNumberFormattingUtils_FormatIntoBuffer()
+    {
+        wchar_t buffer[MAX_FORMATTED_LENGTH];
+        size_t length = FormatFixed(12.342500001, 3, buffer, size(buffer));
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"12.343");
+        length = FormatFixed(-0.0001, 2, buffer, size(buffer));
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"-0.00");
+        VERIFY_ARE_EQUAL(WithoutTrailingZeros(wstring_view(buffer, length)), L"-0");
+        length = FormatFixed(1e300, 15, buffer, size(buffer));
+        VERIFY_ARE_EQUAL((size_t)317, length);
+        length = FormatScientific(-3432474247332942, buffer, size(buffer));
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"-3.432474e+15");
+        length = FormatShortest(0.1, buffer, size(buffer));
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"0.1");
+        length = FormatShortest(1e-7, buffer, size(buffer));
+        VERIFY_ARE_EQUAL(wstring(buffer, length), L"1e-07");
+
+        // Only the start of the number is written when it doesn't fit, but the length is all of it.
+        buffer[3] = L'x';
+        length = FormatFixed(1234.5, 1, buffer, 3);
+        VERIFY_ARE_EQUAL((size_t)6, length);
+        VERIFY_ARE_EQUAL(wstring(buffer, 4), L"123x");
+
+        // More decimals than fit in the buffer are still rounded as RoundSignificantDigits does.
+        VERIFY_ARE_EQUAL(RoundSignificantDigits(1.0 / 3, 40), L"0.3333333333333333148296162562473909929395");
+    }
+
     void CalculatorManagerTest::CalculatorManagerTestBinaryOperatorReceived()
     {
         CalculatorManagerDisplayTester* pCalculatorDisplay = (CalculatorManagerDisplayTester*)m_calculatorDisplayTester.get();
@@ -1209,4 +1307,346 @@ namespace CalculatorManagerTest
                                  Command::Command4, Command::CommandMUL, Command::Command5, Command::CommandMUL, Command::CommandNULL };
         TestDriver::Test(L"120", L"120 \x00D7 ", commands24);
     }
+
+    void CalculatorManagerTest::CalculatorManagerTestBatchEvaluator()
+    {
+        vector<vector<Command>> sequences = {
+            // 1 + 2 * 3 =, Standard mode works left to right
+            { Command::Command1, Command::CommandADD, Command::Command2, Command::CommandMUL, Command::Command3, Command::CommandEQU },
+            // 1 + 2 * 3 =, and here with precedence
+            { Command::ModeScientific, Command::Command1, Command::CommandADD, Command::Command2, Command::CommandMUL, Command::Command3, Command::CommandEQU },
+            // 1 / 0 =
+            { Command::Command1, Command::CommandDIV, Command::Command0, Command::CommandEQU },
+            // 0.5 asin in radians, then F-E
+            { Command::ModeScientific, Command::CommandRAD, Command::Command0, Command::CommandPNT, Command::Command5, Command::CommandASIN, Command::CommandFE },
+            // 2 MS, then MR + MR =
+            { Command::Command2, Command::CommandSTORE, Command::CommandCLEAR, Command::CommandRECALL, Command::CommandADD, Command::CommandRECALL, Command::CommandEQU },
+            // Nothing in memory this time, MR + 1 =
+            { Command::CommandRECALL, Command::CommandADD, Command::Command1, Command::CommandEQU },
+            // 12 sin, still in degrees
+            { Command::ModeScientific, Command::Command1, Command::Command2, Command::CommandSIN },
+            // FF AND F0 = in hex
+            { Command::ModeProgrammer, Command::CommandHex, Command::CommandF, Command::CommandF, Command::CommandAnd, Command::CommandF, Command::Command0,
+              Command::CommandEQU },
+            // A mode change in the middle, 7 ^ 2 =
+            { Command::Command9, Command::ModeScientific, Command::Command7, Command::CommandPWR, Command::Command2, Command::CommandEQU },
+            // Typed in but not finished
+            { Command::Command4, Command::CommandPNT },
+        };
+
+        BatchEvaluator evaluator(m_resourceProvider.get());
+        vector<BatchResult> results = evaluator.Evaluate(sequences);
+        VERIFY_ARE_EQUAL(sequences.size(), results.size());
+
+        for (size_t i = 0; i < sequences.size(); i++)
+        {
+            m_calculatorManager->Reset();
+            ExecuteCommands(sequences[i]);
+
+            VERIFY_ARE_EQUAL(m_calculatorDisplayTester->GetPrimaryDisplay(), results[i].result);
+            VERIFY_ARE_EQUAL(m_calculatorDisplayTester->GetIsError(), results[i].isError);
+        }
+
+        VERIFY_IS_TRUE(results[2].isError);
+        VERIFY_ARE_EQUAL(L"9", results[0].result);
+        VERIFY_ARE_EQUAL(L"7", results[1].result);
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestParallelBatchEvaluator()
+    {
+        vector<vector<Command>> baseSequences = {
+            { Command::ModeScientific, Command::Command1, Command::CommandADD, Command::Command2, Command::CommandMUL, Command::Command3, Command::CommandEQU },
+            // F-E is ignored while in error, and must not carry over into the next sequence
+            { Command::Command1, Command::CommandDIV, Command::Command0, Command::CommandEQU, Command::CommandFE },
+            { Command::Command2, Command::CommandSTORE, Command::CommandCLEAR, Command::CommandRECALL, Command::CommandADD, Command::CommandRECALL, Command::CommandEQU },
+            { Command::CommandRECALL, Command::CommandADD, Command::Command1, Command::CommandEQU },
+            { Command::ModeScientific, Command::CommandRAD, Command::Command1, Command::CommandSIN, Command::CommandFE },
+            { Command::ModeScientific, Command::Command1, Command::Command2, Command::CommandSIN },
+            { Command::ModeProgrammer, Command::CommandByte, Command::CommandHex, Command::CommandF, Command::CommandF, Command::CommandADD, Command::Command1,
+              Command::CommandEQU },
+            { Command::ModeProgrammer, Command::CommandHex, Command::CommandF, Command::CommandF, Command::CommandAnd, Command::CommandF, Command::Command0,
+              Command::CommandEQU },
+            { Command::Command9, Command::ModeScientific, Command::Command7, Command::CommandPWR, Command::Command2, Command::CommandEQU },
+            { Command::Command4, Command::CommandPNT },
+            {},
+        };
+
+        // Enough sequences, in a varied enough order, for the workers to share and steal shards.
+        vector<vector<Command>> sequences;
+        for (size_t i = 0; i < 300; i++)
+        {
+            sequences.push_back(baseSequences[(i * 7) % baseSequences.size()]);
+        }
+
+        BatchEvaluator evaluator(m_resourceProvider.get());
+        vector<BatchResult> expected = evaluator.Evaluate(sequences);
+
+        ParallelBatchEvaluator parallelEvaluator(m_resourceProvider.get(), 3);
+        VERIFY_ARE_EQUAL(size_t{ 3 }, parallelEvaluator.WorkerCount());
+
+        size_t commandCount = 0;
+        for (auto const& commands : sequences)
+        {
+            commandCount += commands.size();
+        }
+
+        // Twice, as the workers and their engines are kept between batches.
+        for (int batch = 0; batch < 2; batch++)
+        {
+            vector<BatchResult> results = parallelEvaluator.Evaluate(sequences);
+            VERIFY_ARE_EQUAL(expected.size(), results.size());
+            for (size_t i = 0; i < expected.size(); i++)
+            {
+                VERIFY_ARE_EQUAL(expected[i].result, results[i].result);
+                VERIFY_ARE_EQUAL(expected[i].isError, results[i].isError);
+            }
+
+            BatchStatistics const& statistics = parallelEvaluator.GetLastStatistics();
+            VERIFY_ARE_EQUAL(sequences.size(), statistics.sequenceCount);
+            VERIFY_ARE_EQUAL(commandCount, statistics.commandCount);
+            VERIFY_ARE_EQUAL(size_t{ 3 }, statistics.sequencesPerWorker.size());
+            size_t sequenceCount = 0;
+            for (size_t count : statistics.sequencesPerWorker)
+            {
+                sequenceCount += count;
+            }
+            VERIFY_ARE_EQUAL(sequences.size(), sequenceCount);
+        }
+
+        VERIFY_ARE_EQUAL(size_t{ 0 }, parallelEvaluator.Evaluate({}).size());
+        VERIFY_ARE_EQUAL(size_t{ 0 }, parallelEvaluator.GetLastStatistics().sequenceCount);
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestParallelBatchEvaluatorStrings()
+    {
+        vector<vector<Command>> sequences(50, { Command::Command1, Command::CommandDIV, Command::Command0, Command::CommandEQU });
+
+        // Both made before either evaluates anything, so strings one of them loaded for every engine would show up in
+        // the other's results.
+        auto resourceProvider = make_shared<OverridingResourceProvider>(m_resourceProvider, to_wstring(IDS_DIVBYZERO), L"Division by zero");
+        ParallelBatchEvaluator evaluator(m_resourceProvider.get(), 2);
+        ParallelBatchEvaluator otherEvaluator(resourceProvider.get(), 2);
+
+        vector<BatchResult> results = evaluator.Evaluate(sequences);
+        vector<BatchResult> otherResults = otherEvaluator.Evaluate(sequences);
+        for (size_t i = 0; i < sequences.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(L"Cannot divide by zero", results[i].result);
+            VERIFY_ARE_EQUAL(L"Division by zero", otherResults[i].result);
+        }
+
+        // Nor do they change the strings the calculator itself shows.
+        m_calculatorManager->Reset();
+        ExecuteCommands(sequences[0]);
+        VERIFY_ARE_EQUAL(L"Cannot divide by zero", m_calculatorDisplayTester->GetPrimaryDisplay());
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestParallelBatchEvaluatorException()
+    {
+        vector<vector<Command>> sequences(100, { Command::Command1, Command::CommandADD, Command::Command2, Command::CommandEQU });
+        sequences[37].insert(sequences[37].begin() + 1, Command::CommandNULL);
+
+        // Every shard still gets done, and the exception comes out of Evaluate rather than ending the worker's thread.
+        ParallelBatchEvaluator evaluator(m_resourceProvider.get(), 3);
+        VERIFY_THROWS_EXPECTEDEXCEPTION(evaluator.Evaluate(sequences), invalid_argument const&);
+
+        // The workers carry on with the next batch.
+        sequences[37] = sequences[0];
+        vector<BatchResult> results = evaluator.Evaluate(sequences);
+        VERIFY_ARE_EQUAL(sequences.size(), results.size());
+        for (auto const& result : results)
+        {
+            VERIFY_ARE_EQUAL(L"3", result.result);
+            VERIFY_IS_FALSE(result.isError);
+        }
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestHistorySerializer()
+    {
+        m_calculatorManager->Reset();
+        m_calculatorManager->SetScientificMode();
+        m_calculatorManager->ClearHistory();
+
+        // 1 + 2 * (3 - 4) =, -1.5 sqr =, 12 ln e^x = and 2.5 exp 3 =, for every kind of command
+        ExecuteCommands({ Command::Command1, Command::CommandADD, Command::Command2, Command::CommandMUL, Command::CommandOPENP, Command::Command3,
+                          Command::CommandSUB, Command::Command4, Command::CommandCLOSEP, Command::CommandEQU });
+        ExecuteCommands({ Command::Command1, Command::CommandPNT, Command::Command5, Command::CommandSIGN, Command::CommandSQR, Command::CommandEQU });
+        ExecuteCommands({ Command::Command1, Command::Command2, Command::CommandLN, Command::CommandPOWE, Command::CommandEQU });
+        ExecuteCommands({ Command::Command2, Command::CommandPNT, Command::Command5, Command::CommandEXP, Command::Command3, Command::CommandEQU });
+
+        vector<shared_ptr<HISTORYITEM>> const& history = m_calculatorManager->GetHistoryItems();
+        VERIFY_ARE_EQUAL(size_t{ 4 }, history.size());
+
+        vector<uint8_t> bytes = HistorySerializer::Serialize(history);
+
+        // The size comes back even when the buffer is too small, and a buffer of that size gets the same bytes.
+        uint8_t tooSmall[8];
+        VERIFY_ARE_EQUAL(bytes.size(), HistorySerializer::Serialize(history, tooSmall, sizeof(tooSmall)));
+        vector<uint8_t> exact(bytes.size());
+        VERIFY_ARE_EQUAL(bytes.size(), HistorySerializer::Serialize(history, exact.data(), exact.size()));
+        VERIFY_ARE_EQUAL(bytes, exact);
+
+        vector<shared_ptr<HISTORYITEM>> loaded;
+        VERIFY_IS_TRUE(HistorySerializer::TryDeserialize(bytes.data(), bytes.size(), loaded));
+        VERIFY_ARE_EQUAL(history.size(), loaded.size());
+        for (size_t i = 0; i < history.size(); i++)
+        {
+            HISTORYITEMVECTOR const& expected = history[i]->historyItemVector;
+            HISTORYITEMVECTOR const& actual = loaded[i]->historyItemVector;
+            VERIFY_ARE_EQUAL(expected.expression, actual.expression);
+            VERIFY_ARE_EQUAL(expected.result, actual.result);
+            VERIFY_IS_TRUE(*expected.spTokens == *actual.spTokens);
+            VERIFY_ARE_EQUAL(expected.spCommands->size(), actual.spCommands->size());
+            for (size_t j = 0; j < expected.spCommands->size(); j++)
+            {
+                VERIFY_ARE_EQUAL(expected.spCommands->at(j)->GetCommandType(), actual.spCommands->at(j)->GetCommandType());
+            }
+
+            // Each item on its own, which is also how the commands are compared.
+            vector<uint8_t> itemBytes = HistorySerializer::Serialize(*history[i]);
+            HISTORYITEM item;
+            VERIFY_IS_TRUE(HistorySerializer::TryDeserialize(itemBytes.data(), itemBytes.size(), item));
+            VERIFY_ARE_EQUAL(itemBytes, HistorySerializer::Serialize(item));
+            VERIFY_ARE_EQUAL(itemBytes, HistorySerializer::Serialize(*loaded[i]));
+        }
+
+        // Anything cut short, with a byte too many, or of a newer version is rejected.
+        for (size_t size = 0; size < bytes.size(); size++)
+        {
+            VERIFY_IS_FALSE(HistorySerializer::TryDeserialize(bytes.data(), size, loaded));
+            VERIFY_ARE_EQUAL(size_t{ 0 }, loaded.size());
+        }
+        vector<uint8_t> longer = bytes;
+        longer.push_back(0);
+        VERIFY_IS_FALSE(HistorySerializer::TryDeserialize(longer.data(), longer.size(), loaded));
+        vector<uint8_t> newer = bytes;
+        newer[2]++;
+        VERIFY_IS_FALSE(HistorySerializer::TryDeserialize(newer.data(), newer.size(), loaded));
+
+        // A history is not an item.
+        HISTORYITEM item;
+        VERIFY_IS_FALSE(HistorySerializer::TryDeserialize(bytes.data(), bytes.size(), item));
+
+        // The exact bytes of a one operand expression, so that the format cannot change unnoticed.
+        vector<pair<wstring, int>> tokens = { { L"1", 0 } };
+        vector<shared_ptr<IExpressionCommand>> commands = { make_shared<COpndCommand>(
+            make_shared<vector<int>>(1, static_cast<int>(Command::Command1)), false, false, false) };
+        uint8_t buffer[32];
+        size_t size = HistorySerializer::SerializeExpression(tokens, commands, buffer, sizeof(buffer));
+        vector<uint8_t> expected = { 0xCA, 0x1C, 0x01, 0x03, 0x01, 0x01, 0x31, 0x00, 0x01, 0x02, 0x00, 0x01, 0x86, 0x02 };
+        VERIFY_ARE_EQUAL(expected, vector<uint8_t>(buffer, buffer + size));
+
+        // Strings go through as code points, and a character outside the BMP as one of them.
+        tokens = { { L"\u221A", 0 }, { L"\U0001F600", -1 } };
+        commands = { make_shared<CUnaryCommand>(static_cast<int>(Command::CommandSQRT)), make_shared<CBinaryCommand>(static_cast<int>(Command::CommandADD)),
+                     make_shared<CParentheses>(static_cast<int>(Command::CommandOPENP)) };
+        size = HistorySerializer::SerializeExpression(tokens, commands, buffer, sizeof(buffer));
+        VERIFY_IS_TRUE(size <= sizeof(buffer));
+
+        vector<pair<wstring, int>> loadedTokens;
+        vector<shared_ptr<IExpressionCommand>> loadedCommands;
+        VERIFY_IS_TRUE(HistorySerializer::TryDeserializeExpression(buffer, size, loadedTokens, loadedCommands));
+        VERIFY_IS_TRUE(tokens == loadedTokens);
+        VERIFY_ARE_EQUAL(size_t{ 3 }, loadedCommands.size());
+        VERIFY_ARE_EQUAL(CommandType::UnaryCommand, loadedCommands[0]->GetCommandType());
+        VERIFY_ARE_EQUAL(CommandType::BinaryCommand, loadedCommands[1]->GetCommandType());
+        VERIFY_ARE_EQUAL(CommandType::Parentheses, loadedCommands[2]->GetCommandType());
+        VERIFY_ARE_EQUAL(static_cast<int>(Command::CommandADD), static_pointer_cast<CBinaryCommand>(loadedCommands[1])->GetCommand());
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestHistoryRing()
+    {
+        m_calculatorManager->Reset();
+        m_calculatorManager->SetStandardMode();
+        m_calculatorManager->ClearHistory();
+
+        // Add 1 to each of 0 through 29, so the oldest items have been evicted more than once over
+        auto digit = [](int value) { return static_cast<Command>(static_cast<int>(Command::Command0) + value); };
+        size_t maxHistorySize = m_calculatorManager->MaxHistorySize();
+        int itemCount = static_cast<int>(maxHistorySize) + 10;
+        for (int i = 0; i < itemCount; i++)
+        {
+            ExecuteCommands({ digit(i / 10), digit(i % 10), Command::CommandADD, Command::Command1, Command::CommandEQU });
+        }
+
+        vector<shared_ptr<HISTORYITEM>> history = m_calculatorManager->GetHistoryItems();
+        VERIFY_ARE_EQUAL(maxHistorySize, history.size());
+        int first = itemCount - static_cast<int>(maxHistorySize);
+        for (size_t i = 0; i < history.size(); i++)
+        {
+            VERIFY_ARE_EQUAL(to_wstring(first + static_cast<int>(i) + 1), history[i]->historyItemVector.result);
+            auto const& item = m_calculatorManager->GetHistoryItem(static_cast<unsigned int>(i));
+            VERIFY_ARE_EQUAL(history[i]->historyItemVector.expression, item->historyItemVector.expression);
+            VERIFY_ARE_EQUAL(size_t{ 3 }, history[i]->historyItemVector.spCommands->size());
+            VERIFY_ARE_EQUAL(CommandType::BinaryCommand, history[i]->historyItemVector.spCommands->at(1)->GetCommandType());
+        }
+
+        // Removing from the middle of a full ring keeps the rest in order, and the next item goes on the end
+        VERIFY_IS_TRUE(m_calculatorManager->RemoveHistoryItem(2));
+        VERIFY_IS_FALSE(m_calculatorManager->RemoveHistoryItem(static_cast<unsigned int>(maxHistorySize)));
+        ExecuteCommands({ Command::Command9, Command::Command9, Command::CommandADD, Command::Command1, Command::CommandEQU });
+
+        vector<shared_ptr<HISTORYITEM>> const& updated = m_calculatorManager->GetHistoryItems();
+        VERIFY_ARE_EQUAL(maxHistorySize, updated.size());
+        VERIFY_ARE_EQUAL(history[1]->historyItemVector.result, updated[1]->historyItemVector.result);
+        VERIFY_ARE_EQUAL(history[3]->historyItemVector.result, updated[2]->historyItemVector.result);
+        VERIFY_ARE_EQUAL(wstring(L"100"), updated.back()->historyItemVector.result);
+
+        // Items left in place keep the HISTORYITEM decoded for them, also when the oldest is evicted by the next one
+        VERIFY_IS_TRUE(history[1] == updated[1]);
+        VERIFY_IS_TRUE(history[3] == updated[2]);
+        shared_ptr<HISTORYITEM> secondOldest = updated[1];
+        ExecuteCommands({ Command::Command9, Command::Command8, Command::CommandADD, Command::Command1, Command::CommandEQU });
+        VERIFY_IS_TRUE(secondOldest == m_calculatorManager->GetHistoryItems().front());
+        VERIFY_ARE_EQUAL(wstring(L"99"), m_calculatorManager->GetHistoryItems().back()->historyItemVector.result);
+
+        // Restored items keep their own expression, even when it is not the one their tokens make
+        auto restored = make_shared<HISTORYITEM>(*history[0]);
+        restored->historyItemVector.expression = L"restored";
+        m_calculatorManager->ClearHistory();
+        m_calculatorManager->SetHistoryItems({ restored, history[1] });
+
+        VERIFY_ARE_EQUAL(size_t{ 2 }, m_calculatorManager->GetHistoryItems().size());
+        VERIFY_ARE_EQUAL(wstring(L"restored"), m_calculatorManager->GetHistoryItem(0)->historyItemVector.expression);
+        VERIFY_IS_TRUE(*history[0]->historyItemVector.spTokens == *m_calculatorManager->GetHistoryItem(0)->historyItemVector.spTokens);
+        VERIFY_ARE_EQUAL(history[1]->historyItemVector.expression, m_calculatorManager->GetHistoryItem(1)->historyItemVector.expression);
+    }
+
+    void CalculatorManagerTest::CalculatorManagerTestExpressionDisplayUpdates()
+    {
+        m_calculatorManager->Reset();
+        m_calculatorManager->SetScientificMode();
+
+        // Each operator only adds the operand and operator to the end, whatever the length of the expression so far
+        wstring expected;
+        for (int i = 1; i <= 30; i++)
+        {
+            ExecuteCommands({ static_cast<Command>(static_cast<int>(Command::Command0) + i % 10), Command::CommandADD });
+            expected += to_wstring(i % 10) + L" + ";
+            VERIFY_ARE_EQUAL(expected, m_calculatorDisplayTester->GetExpression());
+            VERIFY_IS_LESS_THAN_OR_EQUAL(m_calculatorDisplayTester->GetRedrawnTokenCount(), size_t{ 4 });
+        }
+
+        // A unary operator wraps the last operand, and a changed binary operator replaces the last one
+        ExecuteCommands({ Command::Command9, Command::CommandSQRT });
+        VERIFY_ARE_EQUAL(expected + L"\x221A(9)", m_calculatorDisplayTester->GetExpression());
+        VERIFY_IS_LESS_THAN_OR_EQUAL(m_calculatorDisplayTester->GetRedrawnTokenCount(), size_t{ 3 });
+        ExecuteCommands({ Command::CommandADD, Command::CommandSUB });
+        VERIFY_ARE_EQUAL(expected + L"\x221A(9) - ", m_calculatorDisplayTester->GetExpression());
+        VERIFY_IS_LESS_THAN_OR_EQUAL(m_calculatorDisplayTester->GetRedrawnTokenCount(), size_t{ 3 });
+
+        // Changing the radix changes every operand, and changing it to the same radix changes none
+        m_calculatorManager->Reset();
+        m_calculatorManager->SetProgrammerMode();
+        ExecuteCommands({ Command::Command1, Command::Command0, Command::CommandADD, Command::Command1, Command::Command1, Command::CommandADD });
+        VERIFY_ARE_EQUAL(wstring(L"10 + 11 + "), m_calculatorDisplayTester->GetExpression());
+        ExecuteCommands({ Command::CommandHex });
+        VERIFY_ARE_EQUAL(wstring(L"A + B + "), m_calculatorDisplayTester->GetExpression());
+        VERIFY_ARE_EQUAL(size_t{ 8 }, m_calculatorDisplayTester->GetRedrawnTokenCount());
+        ExecuteCommands({ Command::CommandHex });
+        VERIFY_ARE_EQUAL(wstring(L"A + B + "), m_calculatorDisplayTester->GetExpression());
+        VERIFY_ARE_EQUAL(size_t{ 0 }, m_calculatorDisplayTester->GetRedrawnTokenCount());
+        ExecuteCommands({ Command::CommandDec, Command::CommandHex });
+        VERIFY_ARE_EQUAL(wstring(L"A + B + "), m_calculatorDisplayTester->GetExpression());
+    }
 } /* namespace CalculationManagerUnitTests */
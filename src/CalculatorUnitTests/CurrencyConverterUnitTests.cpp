@@ -407,6 +407,33 @@ TEST_CLASS(CurrencyConverterUnitTests)
         VERIFY_IS_TRUE((std::abs(0.920503 - eurRatioData.ratio) < 1e-6));
     }
 
+    TEST_METHOD(Loaded_LoadOrderedRatios_FromOtherCurrency)
+    {
+        StandardCacheSetup();
+
+        CurrencyDataLoader loader{ L"en-US" };
+
+        auto data_loaded_event = task_completion_event<void>();
+        loader.SetViewModelCallback(std::make_shared<DataLoadedCallback>(data_loaded_event));
+
+        auto data_loaded_task = create_task(data_loaded_event);
+        loader.LoadData();
+        data_loaded_task.wait();
+
+        std::vector<UCM::Unit> unitList = loader.GetOrderedUnits(CURRENCY_CATEGORY);
+        const UCM::Unit usdUnit = GetUnit(unitList, L"USD");
+        const UCM::Unit eurUnit = GetUnit(unitList, L"EUR");
+
+        // Worked out from the rates of both against the base currency
+        std::unordered_map<UCM::Unit, UCM::ConversionData, UCM::UnitHash> ratios = loader.LoadOrderedRatios(eurUnit);
+        VERIFY_ARE_EQUAL(size_t{ 2 }, ratios.size());
+        VERIFY_ARE_EQUAL(1.0, ratios[eurUnit].ratio);
+        VERIFY_IS_TRUE((std::abs(1 / 0.920503 - ratios[usdUnit].ratio) < 1e-6));
+
+        const UCM::Unit fakeUnit = { 1, L"fakeUnit", L"fakeCountry", L"FUD", false, false, false };
+        VERIFY_THROWS_EXPECTEDEXCEPTION(loader.LoadOrderedRatios(fakeUnit), const std::out_of_range&);
+    }
+
     TEST_METHOD(Loaded_GetCurrencySymbols_Valid)
     {
         StandardCacheSetup();
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include <CppUnitTest.h>
+#include <thread>
 #include "Header Files/Rational.h"
 #include "Header Files/RationalMath.h"
 
@@ -216,6 +217,370 @@ TEST_METHOD(TestRemainderRational)
     res = Rational(-834345) % Rational(Number(1, 0, { 103 }), Number(1, 0, { 100 }));
     VERIFY_ARE_EQUAL(res.ToString(10, NumberFormat::Float, 8), L"-0.71");
 }
+
+TEST_METHOD(TestToStringFormats)
+{
+    Rational big = Pow(Rational(10), Rational(40));
+    VERIFY_ARE_EQUAL(Rational(123000).ToString(10, NumberFormat::Float, 8), L"123000");
+    VERIFY_ARE_EQUAL(Rational(123000).ToString(10, NumberFormat::Scientific, 8), L"1.23e+5");
+    VERIFY_ARE_EQUAL(Rational(123000).ToString(10, NumberFormat::Engineering, 8), L"123.e+3");
+    VERIFY_ARE_EQUAL((Rational(-25) / Rational(2)).ToString(10, NumberFormat::Float, 8), L"-12.5");
+    VERIFY_ARE_EQUAL((Rational(-25) / Rational(2)).ToString(10, NumberFormat::Scientific, 8), L"-1.25e+1");
+    VERIFY_ARE_EQUAL((Rational(-25) / Rational(2)).ToString(10, NumberFormat::Engineering, 8), L"-12.5e+0");
+    VERIFY_ARE_EQUAL((Rational(1) / Rational(3)).ToString(10, NumberFormat::Scientific, 8), L"3.3333333e-1");
+    VERIFY_ARE_EQUAL(big.ToString(10, NumberFormat::Float, 8), L"1.e+40");
+    VERIFY_ARE_EQUAL(big.ToString(10, NumberFormat::Engineering, 8), L"10.e+39");
+    VERIFY_ARE_EQUAL(Rational(0).ToString(10, NumberFormat::Float, 8), L"0");
+    VERIFY_ARE_EQUAL(Rational(0).ToString(10, NumberFormat::Scientific, 8), L"0.e+0");
+    VERIFY_ARE_EQUAL(Rational(255).ToString(16, NumberFormat::Scientific, 8), L"F.F^+1");
+    VERIFY_ARE_EQUAL((Rational(-1) / Rational(1024)).ToString(2, NumberFormat::Float, 16), L"-0.0000000001");
+}
+
+TEST_METHOD(TestAllocatorModesMatch)
+{
+    // The pooled allocator and arenas must not change any result, nor leak nodes
+    ClearResultCache();
+    ResetAllocatorStats();
+    uint64_t inUse = GetAllocatorStats().cinuse;
+
+    Rational x(Number(1, 0, { 7 }), Number(1, 0, { 3 }));
+    std::wstring pooled = (Exp(x) + Sin(x, AngleType::Radians) + Log(x) + ATan(x, AngleType::Degrees)).ToString(10, NumberFormat::Float, 64);
+    VERIFY_IS_TRUE(GetAllocatorStats().cpoolhit > 0);
+    VERIFY_IS_TRUE(GetAllocatorStats().carenaalloc > 0);
+
+    // Worked out again, not taken from the results RationalMath keeps
+    ClearResultCache();
+    SetAllocatorMode(AllocatorMode::Calloc);
+    std::wstring callocated = (Exp(x) + Sin(x, AngleType::Radians) + Log(x) + ATan(x, AngleType::Degrees)).ToString(10, NumberFormat::Float, 64);
+    SetAllocatorMode(AllocatorMode::Pooled);
+    ClearResultCache();
+
+    VERIFY_ARE_EQUAL(pooled, callocated);
+    VERIFY_ARE_EQUAL(GetAllocatorStats().cinuse, inUse);
+}
+
+TEST_METHOD(TestMultiplicationAlgorithmsMatch)
+{
+    // Karatsuba and Toom-3 must produce exactly what the grade school multiply does
+    int32_t karatsuba, toom3;
+    GetMulThresholds(&karatsuba, &toom3);
+
+    Rational big = Fact(Rational(450)) * Rational(Number(1, 0, { 7 }), Number(1, 0, { 3 }));
+    Rational operand = Fact(Rational(300)) + Rational(1);
+
+    SetMulThresholds(INT32_MAX, INT32_MAX);
+    Rational expected = big * operand * operand;
+    SetMulThresholds(2, INT32_MAX);
+    Rational karatsubaResult = big * operand * operand;
+    SetMulThresholds(2, 3);
+    Rational toom3Result = big * operand * operand;
+    SetMulThresholds(karatsuba, toom3);
+
+    VERIFY_IS_TRUE(expected.P().Mantissa() == karatsubaResult.P().Mantissa());
+    VERIFY_IS_TRUE(expected.Q().Mantissa() == karatsubaResult.Q().Mantissa());
+    VERIFY_IS_TRUE(expected.P().Mantissa() == toom3Result.P().Mantissa());
+    VERIFY_IS_TRUE(expected.Q().Mantissa() == toom3Result.Q().Mantissa());
+}
+
+TEST_METHOD(TestDivisionAlgorithmsMatch)
+{
+    // Newton's iteration must produce exactly the digits the long division does
+    int32_t basex, radix;
+    GetDivThresholds(&basex, &radix);
+
+    Rational ratio = Fact(Rational(450)) * Rational(Number(1, 0, { 7 }), Number(1, 0, { 3 })) / (Fact(Rational(300)) + Rational(1));
+    Rational exact = Fact(Rational(450)) / Fact(Rational(300));
+
+    SetDivThresholds(INT32_MAX, INT32_MAX);
+    std::wstring expected = ratio.ToString(10, NumberFormat::Float, 128);
+    std::wstring expectedExact = exact.ToString(10, NumberFormat::Float, 128);
+    Rational expectedInteger = Integer(ratio);
+    SetDivThresholds(1, 1);
+    std::wstring newton = ratio.ToString(10, NumberFormat::Float, 128);
+    std::wstring newtonExact = exact.ToString(10, NumberFormat::Float, 128);
+    Rational newtonInteger = Integer(ratio);
+    SetDivThresholds(basex, radix);
+
+    VERIFY_ARE_EQUAL(expected, newton);
+    VERIFY_ARE_EQUAL(expectedExact, newtonExact);
+    VERIFY_IS_TRUE(expectedInteger == newtonInteger);
+}
+
+TEST_METHOD(TestSeriesAlgorithmsMatch)
+{
+    // Binary splitting must agree with the Taylor series to the digits shown
+    int32_t split;
+    GetSeriesThreshold(&split);
+
+    Rational x = Root(Rational(2), Rational(2)) / Rational(3) + Rational(Number(1, 0, { 1 }), Number(1, 0, { 4 }));
+    auto evaluate = [&x]() {
+        return std::vector<std::wstring>{ Exp(x).ToString(10, NumberFormat::Float, 100),
+                                          Log(x).ToString(10, NumberFormat::Float, 100),
+                                          Sin(x, AngleType::Radians).ToString(10, NumberFormat::Float, 100),
+                                          Cos(x, AngleType::Radians).ToString(10, NumberFormat::Float, 100),
+                                          ATan(x, AngleType::Radians).ToString(10, NumberFormat::Float, 100),
+                                          ASin(x, AngleType::Radians).ToString(10, NumberFormat::Float, 100) };
+    };
+
+    // Worked out again each time, not taken from the results RationalMath keeps
+    ClearResultCache();
+    SetSeriesThreshold(INT32_MAX);
+    std::vector<std::wstring> taylor = evaluate();
+    ClearResultCache();
+    SetSeriesThreshold(1);
+    std::vector<std::wstring> splitting = evaluate();
+    SetSeriesThreshold(split);
+    ClearResultCache();
+
+    for (size_t i = 0; i < taylor.size(); i++)
+    {
+        VERIFY_ARE_EQUAL(taylor[i], splitting[i]);
+    }
+}
+
+TEST_METHOD(TestConversionAlgorithmsMatch)
+{
+    // Converting in halves must give the digits converting in one pass does
+    int32_t split;
+    GetConvThreshold(&split);
+
+    Rational big = Fact(Rational(1000)) * Rational(Number(1, 0, { 7 }), Number(1, 0, { 3 }));
+    auto evaluate = [&big]() {
+        std::vector<std::wstring> strings;
+        for (uint32_t radix : { 10, 16, 8, 2 })
+        {
+            strings.push_back(big.ToString(radix, NumberFormat::Float, 3000));
+        }
+
+        PRAT parsed = StringToRat(false, strings[0], false, L"", 10, 3000);
+        strings.push_back(Rational(parsed).ToString(10, NumberFormat::Float, 3000));
+        destroyrat(parsed);
+        return strings;
+    };
+
+    SetConvThreshold(INT32_MAX);
+    std::vector<std::wstring> onePass = evaluate();
+    SetConvThreshold(2);
+    std::vector<std::wstring> halves = evaluate();
+    SetConvThreshold(split);
+
+    for (size_t i = 0; i < onePass.size(); i++)
+    {
+        VERIFY_ARE_EQUAL(onePass[i], halves[i]);
+    }
+}
+
+TEST_METHOD(TestConstantsSurvivePrecisionChanges)
+{
+    // Going through other radixes and precisions, above and below, must leave
+    // the constants as good as they were
+    Rational x = Rational(Number(1, 0, { 5 }), Number(1, 0, { 7 }));
+    auto evaluate = [&x]() {
+        return std::vector<std::wstring>{ Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120),
+                                          ATan(x, AngleType::Gradians).ToString(10, NumberFormat::Float, 120),
+                                          Exp(x).ToString(10, NumberFormat::Float, 120),
+                                          Log10(x).ToString(10, NumberFormat::Float, 120) };
+    };
+
+    // Worked out again each time, not taken from the results RationalMath keeps
+    ClearResultCache();
+    std::vector<std::wstring> expected = evaluate();
+    ChangeConstants(10, 32);
+    ChangeConstants(2, 65);
+    ChangeConstants(10, 128);
+    ClearResultCache();
+    std::vector<std::wstring> afterLower = evaluate();
+    ChangeConstants(10, 600);
+    ChangeConstants(10, 128);
+    ClearResultCache();
+    std::vector<std::wstring> afterHigher = evaluate();
+    ClearResultCache();
+
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        VERIFY_ARE_EQUAL(expected[i], afterLower[i]);
+        VERIFY_ARE_EQUAL(expected[i], afterHigher[i]);
+    }
+}
+
+TEST_METHOD(TestThreadsComputeIndependently)
+{
+    // Every thread has constants, a radix and a precision of its own
+    auto evaluate = [](uint32_t radix, int32_t precision) {
+        ChangeConstants(radix, precision);
+        Rational x = Rational(Number(1, 0, { 5 }), Number(1, 0, { 7 }));
+        return Sin(x, AngleType::Degrees).ToString(radix, NumberFormat::Float, precision) + L" " + Exp(x).ToString(radix, NumberFormat::Float, precision)
+               + L" " + Fact(Rational(80)).ToString(radix, NumberFormat::Float, precision);
+    };
+    const std::pair<uint32_t, int32_t> settings[] = { { 10, 32 }, { 10, 128 }, { 16, 40 }, { 2, 65 }, { 10, 300 } };
+
+    std::vector<std::wstring> expected;
+    for (auto [radix, precision] : settings)
+    {
+        expected.push_back(evaluate(radix, precision));
+    }
+    ChangeConstants(10, 128);
+
+    std::vector<std::wstring> results(std::size(settings));
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::size(settings); i++)
+    {
+        threads.emplace_back([&, i]() { results[i] = evaluate(settings[i].first, settings[i].second); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < std::size(settings); i++)
+    {
+        VERIFY_ARE_EQUAL(expected[i], results[i]);
+    }
+}
+
+TEST_METHOD(TestResultCacheFollowsConstants)
+{
+    // A result comes back from the cache only for the same function, input,
+    // angle type, radix and precision, and never once the constants have
+    // been changed or worked out again
+    ClearResultCache();
+    Rational x = Rational(Number(1, 0, { 5 }), Number(1, 0, { 7 }));
+    std::wstring sin = Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120);
+    VERIFY_ARE_EQUAL(Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().hits, 1ull);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().misses, 1ull);
+
+    VERIFY_ARE_NOT_EQUAL(Sin(x, AngleType::Radians).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_NOT_EQUAL(Cos(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_EQUAL(Pow(Rational(2), Rational(10)), 1024);
+    VERIFY_ARE_EQUAL(Pow(Rational(2), Rational(11)), 2048);
+    VERIFY_ARE_EQUAL(Pow(Rational(2), Rational(10)), 1024);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().hits, 2ull);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().misses, 5ull);
+
+    // Going to another precision and back leaves nothing kept from before,
+    // setting the same constants again keeps everything.
+    ChangeConstants(10, 32);
+    Sin(x, AngleType::Degrees);
+    ChangeConstants(10, 128);
+    VERIFY_ARE_EQUAL(Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().hits, 2ull);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().misses, 7ull);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().invalidations, 2ull);
+    ChangeConstants(10, 128);
+    VERIFY_ARE_EQUAL(Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().hits, 3ull);
+
+    // More precise constants than ever before are trimmed down for 128 from
+    // then on, which makes every result kept so far stale as well.
+    ChangeConstants(10, 900);
+    ChangeConstants(10, 128);
+    VERIFY_ARE_EQUAL(Sin(x, AngleType::Degrees).ToString(10, NumberFormat::Float, 120), sin);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().invalidations, 3ull);
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().size, size_t{ 1 });
+
+    for (int32_t i = 0; i < 100; i++)
+    {
+        Fact(Rational(i));
+    }
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().size, size_t{ 64 });
+    VERIFY_ARE_EQUAL(GetResultCacheStatistics().evictions, 37ull);
+    VERIFY_ARE_EQUAL(Fact(Rational(99)).ToString(10, NumberFormat::Float, 128), Fact(Rational(99)).ToString(10, NumberFormat::Float, 128));
+    ClearResultCache();
+}
+
+TEST_METHOD(TestSmallValuesMatchRatpak)
+{
+    // Small operands skip ratpak, the rationals they give must be the ones
+    // ratpak gives, around the 64 bit limit and for zeros of either sign.
+    auto viaRatpak = [](Rational const& lhs, Rational const& rhs, void (*op)(PRAT*, PRAT, int32_t)) {
+        PRAT lhsRat = lhs.ToPRAT();
+        PRAT rhsRat = rhs.ToPRAT();
+        op(&lhsRat, rhsRat, RATIONAL_PRECISION);
+        Rational result{ lhsRat };
+        destroyrat(lhsRat);
+        destroyrat(rhsRat);
+        return result;
+    };
+    auto same = [](Rational const& a, Rational const& b) {
+        return a.P().Sign() == b.P().Sign() && a.P().Mantissa() == b.P().Mantissa() && a.Q().Sign() == b.Q().Sign()
+               && a.Q().Mantissa() == b.Q().Mantissa();
+    };
+
+    std::vector<Rational> values{ Rational(0),
+                                  Rational(-5) * Rational(0),
+                                  Rational(7),
+                                  Rational(-7),
+                                  Rational(Number(1, 0, { 1 }), Number(-1, 0, { 3 })),
+                                  Rational(Number(-1, 0, { 7001 }), Number(1, 0, { 1000 })),
+                                  Rational(uint32_t{ 0xFFFFFFFF }),
+                                  Rational(uint64_t{ 0xFFFFFFFFFFFFFFFF }),
+                                  Rational(Number(1, 0, { 1 }), Number(1, 0, { 0xFFFFFFFF, 0xFFFFFFFF })),
+                                  Rational(Number(-1, 0, { 0, 0x80000000 }), Number(1, 0, { 3 })) };
+    for (auto const& lhs : values)
+    {
+        for (auto const& rhs : values)
+        {
+            VERIFY_IS_TRUE(same(lhs + rhs, viaRatpak(lhs, rhs, addrat)));
+            VERIFY_IS_TRUE(same(lhs - rhs, viaRatpak(lhs, rhs, subrat)));
+            VERIFY_IS_TRUE(same(lhs * rhs, viaRatpak(lhs, rhs, mulrat)));
+            if (!rhs.P().IsZero())
+            {
+                VERIFY_IS_TRUE(same(lhs / rhs, viaRatpak(lhs, rhs, divrat)));
+            }
+            VERIFY_ARE_EQUAL(lhs == rhs, viaRatpak(lhs, rhs, subrat).P().IsZero());
+        }
+    }
+
+    // A difference far below its operands still snaps to zero.
+    ChangeConstants(10, 5);
+    Rational nearMillion(Number(1, 0, { 1000000 * 1024 + 1 }), Number(1, 0, { 1024 }));
+    VERIFY_IS_TRUE(same(nearMillion - Rational(1000000), Rational(0)));
+    ChangeConstants(10, 128);
+}
+
+TEST_METHOD(TestOperatorsLendOperands)
+{
+    // Operators hand their digits to ratpak and take the result back without
+    // copying, a multiply too big for the fast path only allocates the
+    // rational and the two products.
+    Rational big = Rational(uint64_t{ 0xFFFFFFFFFFFFFFF1 }) * Rational(uint64_t{ 0xFFFFFFFFFFFFFF13 });
+    Rational ratio = big / (big + Rational(7));
+    Rational product = big;
+    std::wstring expected = (Rational(big.P()) * Rational(ratio.P()) / (Rational(big.Q()) * Rational(ratio.Q()))).ToString(10, NumberFormat::Float, 128);
+
+    uint64_t allocated = GetAllocatorStats().cnodealloc;
+    product *= ratio;
+    VERIFY_ARE_EQUAL(GetAllocatorStats().cnodealloc - allocated, uint64_t{ 3 });
+    VERIFY_ARE_EQUAL(product.ToString(10, NumberFormat::Float, 128), expected);
+
+    // The operand lent to ratpak is left as it was, even when it is also the target.
+    VERIFY_IS_TRUE(ratio == big / (big + Rational(7)));
+    Rational square = ratio;
+    square *= square;
+    VERIFY_IS_TRUE(square == ratio * Rational(ratio));
+    square /= square;
+    VERIFY_ARE_EQUAL(square, 1);
+}
+
+TEST_METHOD(TestFullWidthDigitsMatchPreviousEngine)
+{
+    // Internal digits use all 32 bits, the expected values are what the engine
+    // produced back when they only used 31, around the limits of both widths.
+    Rational maxDigit(uint32_t{ 0xFFFFFFFF });
+    VERIFY_ARE_EQUAL((maxDigit * maxDigit).ToString(10, NumberFormat::Float, 128), L"18446744065119617025");
+    VERIFY_ARE_EQUAL((Rational(uint64_t{ 0xFFFFFFFFFFFFFFFF }) / maxDigit).ToString(10, NumberFormat::Float, 128), L"4294967297");
+    VERIFY_ARE_EQUAL((Rational(1) / maxDigit).ToString(10, NumberFormat::Float, 40), L"2.328306437080797375431469961868475648078e-10");
+
+    VERIFY_ARE_EQUAL((Rational(uint64_t{ 0x8000000080000000 }) | Rational(uint64_t{ 0x7FFFFFFF7FFFFFFF })).ToUInt64_t(), 0xFFFFFFFFFFFFFFFF);
+    VERIFY_ARE_EQUAL((Rational(uint64_t{ 0xFFFFFFFF00000000 }) ^ Rational(uint64_t{ 0x80000000FFFFFFFF })).ToUInt64_t(), 0x7FFFFFFFFFFFFFFF);
+    VERIFY_ARE_EQUAL((Rational(uint64_t{ 0xFFFFFFFF00000000 }) & Rational(uint64_t{ 0x80000000FFFFFFFF })).ToUInt64_t(), 0x8000000000000000);
+
+    VERIFY_ARE_EQUAL(Mod(-Rational(uint64_t{ 0xFFFFFFFF00000001 }), Rational(uint32_t{ 0x80000000 })).ToString(10, NumberFormat::Float, 128), L"2147483647");
+    VERIFY_ARE_EQUAL(Rational(INT32_MIN).ToString(16, NumberFormat::Float, 128), L"-80000000");
+    VERIFY_ARE_EQUAL((Rational(uint64_t{ 1 }) << Rational(95)).ToString(16, NumberFormat::Float, 128), L"800000000000000000000000");
+    VERIFY_ARE_EQUAL(Root(Rational(2), Rational(2)).ToString(10, NumberFormat::Float, 40), L"1.41421356237309504880168872420969807857");
+}
 }
 ;
 }
@@ -74,6 +74,11 @@ namespace UnitConverterUnitTests
             SetConversionDataParams(&conversion3, 12.0, 0, false);
             SetConversionDataParams(&conversion4, 0.453592, 0, false);
             SetConversionDataParams(&conversion5, 2.20462, 0, false);
+            conversion1.exactRatio = L"1";
+            conversion2.exactRatio = L"1/12";
+            conversion3.exactRatio = L"12";
+            conversion4.exactRatio = L"0.453592";
+            conversion5.exactRatio = L"2.20462";
 
             // Setting the conversion ratios for testing
             unit1Map[u1] = conversion1;
@@ -127,6 +132,147 @@ namespace UnitConverterUnitTests
         UnitToUnitToConversionDataMap m_ratioMaps;
     };
 
+    // A category of its own for the suggested values, with whimsical units, units whose values round to zero and a unit
+    // with no ratio from bytes.
+    class TestSuggestionsConfigLoader : public IConverterDataLoader
+    {
+    public:
+        TestSuggestionsConfigLoader()
+        {
+            SetCategoryParams(&m_category, 3, L"Data", false);
+
+            Unit bytes, kilobytes, bits, megabytes, gigabytes, nibbles, emails, tweets, words;
+            SetUnitParams(&bytes, 10, L"Bytes", L"B", true, true, false);
+            SetUnitParams(&kilobytes, 11, L"Kilobytes", L"KB", false, false, false);
+            SetUnitParams(&bits, 12, L"Bits", L"b", false, false, false);
+            SetUnitParams(&megabytes, 13, L"Megabytes", L"MB", false, false, false);
+            SetUnitParams(&gigabytes, 14, L"Gigabytes", L"GB", false, false, false);
+            SetUnitParams(&nibbles, 15, L"Nibbles", L"Nib", false, false, false);
+            SetUnitParams(&emails, 16, L"Emails", L"Emails", false, false, true);
+            SetUnitParams(&tweets, 17, L"Tweets", L"Tweets", false, false, true);
+            SetUnitParams(&words, 18, L"Words", L"Words", false, false, false);
+            m_units = { bytes, kilobytes, bits, megabytes, gigabytes, nibbles, emails, tweets, words };
+
+            ConversionData conversion;
+            unordered_map<Unit, ConversionData, UnitHash> bytesMap;
+            for (auto [unit, ratio] : { pair{ bytes, 1.0 },
+                                        pair{ kilobytes, 1e-3 },
+                                        pair{ bits, 8.0 },
+                                        pair{ megabytes, 1e-6 },
+                                        pair{ gigabytes, 1e-9 },
+                                        pair{ nibbles, 2.0 },
+                                        pair{ emails, 1.0 / 75000 },
+                                        pair{ tweets, 1.0 / 140 } })
+            {
+                SetConversionDataParams(&conversion, ratio, 0, false);
+                bytesMap[unit] = conversion;
+            }
+            m_ratioMaps[bytes] = bytesMap;
+        }
+
+        void LoadData()
+        {
+        }
+
+        vector<Category> GetOrderedCategories()
+        {
+            return { m_category };
+        }
+
+        vector<Unit> GetOrderedUnits(const Category& /*category*/)
+        {
+            return m_units;
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& u)
+        {
+            return m_ratioMaps[u];
+        }
+
+        bool SupportsCategory(const Category& /*target*/)
+        {
+            return true;
+        }
+
+    private:
+        Category m_category;
+        vector<Unit> m_units;
+        UnitToUnitToConversionDataMap m_ratioMaps;
+    };
+
+    // Two categories with a factor per unit and no ratios between pairs of units, one with sizes and one with rates
+    class TestUnitFactorsConfigLoader : public IConverterDataLoader
+    {
+    public:
+        TestUnitFactorsConfigLoader()
+        {
+            SetCategoryParams(&m_length, 4, L"Length", false);
+            SetCategoryParams(&m_currency, 5, L"Currency", false);
+
+            Unit meters, inches, feet, dollars, euros, yen;
+            SetUnitParams(&meters, 20, L"Meters", L"m", true, false, false);
+            SetUnitParams(&inches, 21, L"Inches", L"in", false, true, false);
+            SetUnitParams(&feet, 22, L"Feet", L"ft", false, false, false);
+            SetUnitParams(&dollars, 30, L"Dollars", L"USD", true, false, false);
+            SetUnitParams(&euros, 31, L"Euros", L"EUR", false, true, false);
+            SetUnitParams(&yen, 32, L"Yen", L"JPY", false, false, false);
+            m_units[m_length.id] = { meters, inches, feet };
+            m_units[m_currency.id] = { dollars, euros, yen };
+
+            m_factors[meters.id] = { 1.0, L"1" };
+            m_factors[inches.id] = { 0.0254, L"0.0254" };
+            m_factors[feet.id] = { 0.3048, L"0.3048" };
+            m_factors[dollars.id] = { 1.0, L"" };
+            m_factors[euros.id] = { 0.5, L"" };
+            m_factors[yen.id] = { 150.0, L"" };
+        }
+
+        void LoadData()
+        {
+        }
+
+        vector<Category> GetOrderedCategories()
+        {
+            return { m_length, m_currency };
+        }
+
+        vector<Unit> GetOrderedUnits(const Category& category)
+        {
+            return m_units[category.id];
+        }
+
+        unordered_map<Unit, ConversionData, UnitHash> LoadOrderedRatios(const Unit& /*u*/)
+        {
+            throw logic_error("the converter should use the factors");
+        }
+
+        bool SupportsCategory(const Category& /*target*/)
+        {
+            return true;
+        }
+
+        bool TryLoadUnitFactors(const vector<Unit>& units, UnitFactors& factors)
+        {
+            factors.factorsAreRates = units.front().id >= 30;
+            for (const Unit& unit : units)
+            {
+                auto [factor, exactFactor] = m_factors.at(unit.id);
+                factors.factors.push_back(factor);
+                if (!exactFactor.empty())
+                {
+                    factors.exactFactors.emplace_back(exactFactor);
+                }
+            }
+            return true;
+        }
+
+    private:
+        Category m_length;
+        Category m_currency;
+        CategoryToUnitVectorMap m_units;
+        unordered_map<int, pair<double, wstring_view>> m_factors;
+    };
+
     class TestUnitConverterVMCallback : public IUnitConverterVMCallback
     {
     public:
@@ -199,6 +345,10 @@ namespace UnitConverterUnitTests
         TEST_METHOD(UnitConverterTestGetters);
         TEST_METHOD(UnitConverterTestGetCategory);
         TEST_METHOD(UnitConverterTestUnitTypeSwitching);
+        TEST_METHOD(UnitConverterTestUnitsWithoutRatio);
+        TEST_METHOD(UnitConverterTestExactConversion);
+        TEST_METHOD(UnitConverterTestSuggestedValues);
+        TEST_METHOD(UnitConverterTestUnitFactors);
         TEST_METHOD(UnitConverterTestQuote);
         TEST_METHOD(UnitConverterTestUnquote);
         TEST_METHOD(UnitConverterTestBackspace);
@@ -359,6 +509,119 @@ namespace UnitConverterUnitTests
         VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>()));
     }
 
+    // Units with no ratio between them, e.g. from different categories, leave the value as it is
+    void UnitConverterTest::UnitConverterTestUnitsWithoutRatio()
+    {
+        s_unitConverter->SetCurrentCategory(s_testLength);
+        s_unitConverter->SetCurrentUnitTypes(s_testPounds, s_testInches);
+        s_unitConverter->SendCommand(Command::Two);
+        s_unitConverter->SendCommand(Command::Four);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"24"), wstring(L"24")));
+
+        s_unitConverter->SetCurrentUnitTypes(s_testInches, s_testFeet);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"24"), wstring(L"2")));
+        VERIFY_IS_TRUE(s_testVMCallback->CheckSuggestedValues(vector<tuple<wstring, Unit>>()));
+    }
+
+    // Exact conversions are worked out in rationals, so they round as the exact value does
+    void UnitConverterTest::UnitConverterTestExactConversion()
+    {
+        s_unitConverter->SetCurrentCategory(s_testWeight);
+        s_unitConverter->SetCurrentUnitTypes(s_testKilograms, s_testPounds);
+        s_unitConverter->SendCommand(Command::Four);
+        s_unitConverter->SendCommand(Command::Seven);
+        s_unitConverter->SendCommand(Command::Five);
+        // 475 * 2.20462 is 1047.1945, a little less in doubles
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"475"), wstring(L"1047.194")));
+
+        s_unitConverter->SetExactConversion(true);
+        VERIFY_IS_TRUE(s_unitConverter->IsExactConversion());
+        s_unitConverter->SendCommand(Command::Backspace);
+        s_unitConverter->SendCommand(Command::Five);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"475"), wstring(L"1047.195")));
+
+        s_unitConverter->SetCurrentCategory(s_testLength);
+        s_unitConverter->SetCurrentUnitTypes(s_testInches, s_testFeet);
+        VERIFY_IS_TRUE(s_testVMCallback->CheckDisplayValues(wstring(L"475"), wstring(L"39.58333")));
+
+        s_unitConverter->SetExactConversion(false);
+    }
+
+    // Suggestions are ordered by how far their magnitude is from 1, skip values that round to zero and units with no
+    // ratio, and end with the first whimsical one that doesn't round to zero
+    void UnitConverterTest::UnitConverterTestSuggestedValues()
+    {
+        auto loader = make_shared<TestSuggestionsConfigLoader>();
+        auto callback = make_shared<TestUnitConverterVMCallback>();
+        auto converter = make_shared<UnitConverter>(loader);
+        converter->SetViewModelCallback(callback);
+        converter->Initialize();
+
+        Category data = converter->GetCategories().front();
+        vector<Unit> units = get<0>(converter->SetCurrentCategory(data));
+        Unit const& bits = units[2];
+        Unit const& megabytes = units[3];
+        Unit const& nibbles = units[5];
+        Unit const& emails = units[6];
+        Unit const& tweets = units[7];
+        converter->SetCurrentUnitTypes(units[0], units[1]);
+
+        // 0.012 MB, 24000 Nib and 96000 b, but no 0.000012 GB, then 0.16 emails rather than 85.71 tweets
+        converter->SendCommand(Command::One);
+        converter->SendCommand(Command::Two);
+        converter->SendCommand(Command::Zero);
+        converter->SendCommand(Command::Zero);
+        converter->SendCommand(Command::Zero);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"12000"), wstring(L"12")));
+        tuple<wstring, Unit> test1[] = { { L"0.01", megabytes }, { L"24000", nibbles }, { L"96000", bits }, { L"0.16", emails } };
+        VERIFY_IS_TRUE(callback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test1), end(test1))));
+
+        // Megabytes round to zero as well now, and the emails do, so the tweets come next
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Backspace);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"12"), wstring(L"0.012")));
+        tuple<wstring, Unit> test2[] = { { L"24", nibbles }, { L"96", bits }, { L"0.09", tweets } };
+        VERIFY_IS_TRUE(callback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test2), end(test2))));
+    }
+
+    // Loaders that give a factor per unit are converted with quotients of the factors, sizes one way and rates the other
+    void UnitConverterTest::UnitConverterTestUnitFactors()
+    {
+        auto loader = make_shared<TestUnitFactorsConfigLoader>();
+        auto callback = make_shared<TestUnitConverterVMCallback>();
+        auto converter = make_shared<UnitConverter>(loader);
+        converter->SetViewModelCallback(callback);
+        converter->Initialize();
+
+        vector<Category> categories = converter->GetCategories();
+        vector<Unit> lengths = get<0>(converter->SetCurrentCategory(categories[0]));
+        converter->SetCurrentUnitTypes(lengths[2], lengths[1]);
+        converter->SendCommand(Command::Three);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"3"), wstring(L"36")));
+        tuple<wstring, Unit> test1[] = { { L"0.91", lengths[0] } };
+        VERIFY_IS_TRUE(callback->CheckSuggestedValues(vector<tuple<wstring, Unit>>(begin(test1), end(test1))));
+
+        converter->SetExactConversion(true);
+        converter->SetCurrentUnitTypes(lengths[1], lengths[2]);
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Four);
+        converter->SendCommand(Command::Seven);
+        converter->SendCommand(Command::Five);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"475"), wstring(L"39.58333")));
+
+        // No exact rates, so these are converted in doubles
+        vector<Unit> currencies = get<0>(converter->SetCurrentCategory(categories[1]));
+        converter->SetCurrentUnitTypes(currencies[1], currencies[2]);
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Backspace);
+        converter->SendCommand(Command::Two);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"2"), wstring(L"600")));
+        converter->SetCurrentUnitTypes(currencies[1], currencies[0]);
+        VERIFY_IS_TRUE(callback->CheckDisplayValues(wstring(L"2"), wstring(L"4")));
+    }
+
     // Test input escaping
     void UnitConverterTest::UnitConverterTestQuote()
     {